@@ -11,12 +11,11 @@
 #include <windows.h>
 #endif
 
-#include <vorbis/vorbisfile.h>
-
 #include "audiomaster.h"
 #include "../toolbox/vector.h"
 #include "source.h"
 #include "audioplayer.h"
+#include "musicstream.h"
 #include "../toolbox/maths.h"
 #include "../engineTester/main.h"
 
@@ -47,6 +46,9 @@ void AudioMaster::init()
 	AudioPlayer::loadSettings();
 	AudioPlayer::createSources();
 	AudioPlayer::loadSoundEffects();
+
+	//The last source is the one for background music
+	MusicStream::init(AudioPlayer::getSource(14)->getSourceID());
 }
 
 void AudioMaster::updateListenerData(Vector3f* eye, Vector3f* target, Vector3f* up, Vector3f* vel)
@@ -78,70 +80,9 @@ void AudioMaster::updateListenerData(Vector3f* eye, Vector3f* target, Vector3f*
 	alListenerfv(AL_ORIENTATION, listenerOri);
 }
 
-ALuint AudioMaster::loadOGG(const char* fileName)
-{
-	FILE* fp = nullptr;
-	int er = fopen_s(&fp, fileName, "rb");
-
-	if (fp == nullptr || er != 0)
-	{
-		fprintf(stderr, "Error when trying to open '%s'\n", fileName);
-		if (er != 0)
-		{
-			fprintf(stderr, "fopen_s return value: %d\n", er);
-		}
-		return AL_NONE;
-	}
-
-	int endian = 0; //0 = little
-	int bitStream;
-	long bytes;
-	char array[32768];
-
-	std::vector<char> buf;
-
-	ALuint frequency;
-	ALenum format;
-
-	vorbis_info* pInfo;
-	OggVorbis_File oggFile;
-
-	ov_open(fp, &oggFile, NULL, 0);
-
-	pInfo = ov_info(&oggFile, -1);
-
-	if (pInfo->channels == 1)
-	{
-		format = AL_FORMAT_MONO16;
-	}
-	else
-	{
-		format = AL_FORMAT_STEREO16;
-	}
-
-	frequency = pInfo->rate;
-
-	do
-	{
-		bytes = ov_read(&oggFile, array, 32768, endian, 2, 1, &bitStream);
-		buf.insert(buf.end(), array, array + bytes);
-	}
-	while (bytes > 0);
-
-	ov_clear(&oggFile);
-
-	ALuint buffer;
-	alGenBuffers(1, &buffer);
-	alBufferData(buffer, format, &buf[0], (ALsizei)buf.size(), frequency);
-
-	buf.clear();
-	buf.shrink_to_fit();
-
-	return buffer;
-}
-
 void AudioMaster::cleanUp()
 {
+	MusicStream::cleanUp();
 	AudioPlayer::deleteSources();
 	AudioPlayer::deleteBuffersSE();
 
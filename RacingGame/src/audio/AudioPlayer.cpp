@@ -9,6 +9,8 @@
 #include "../engineTester/main.h"
 #include "../toolbox/vector.h"
 #include "../toolbox/split.h"
+#include "musicstream.h"
+#include "cookedsound.h"
 
 
 
@@ -16,38 +18,48 @@ float AudioPlayer::soundLevelSE = 1.0f;
 float AudioPlayer::soundLevelBGM = 1.0f;
 std::vector<Source*> AudioPlayer::sources;
 std::vector<ALuint> AudioPlayer::buffersSE;
-std::vector<ALuint> AudioPlayer::buffersBGM;
-ALuint AudioPlayer::bgmIntro;
-ALuint AudioPlayer::bgmLoop;
+std::vector<std::string> AudioPlayer::bgmFileNames;
 
 
 void AudioPlayer::loadSoundEffects()
 {
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Boostpad.ogg"));           //0
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Healpad.ogg"));            //1
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Boost/boost_falcon.ogg")); //2
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Intro321GO.ogg"));         //3
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/HitWall.ogg"));            //4
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Engine.ogg"));             //5
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Strafe.ogg"));             //6
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/SlipSlowdown.ogg"));       //7
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Danger.ogg"));             //8
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/AnnounceBoostPower.ogg")); //9
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/AnnounceFinalLap.ogg"));   //10
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/FallFemale.ogg"));         //11
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/FallMale.ogg"));           //12
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Boost/boost_bull.ogg"));   //13
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Boost/boost_falcon.ogg")); //14
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Boost/boost_norita.ogg")); //15
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Boost/boost_phantom.ogg"));//16
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/Boost/boost_wyvern.ogg")); //17
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/ExplosionBig.ogg"));       //18
-	AudioPlayer::buffersSE.push_back(AudioMaster::loadOGG("res/Audio/SFX/ExplosionSmall.ogg"));     //19
+	std::vector<std::string> fileNames =
+	{
+		"res/Audio/SFX/Boostpad.ogg",           //0
+		"res/Audio/SFX/Healpad.ogg",            //1
+		"res/Audio/SFX/Boost/boost_falcon.ogg", //2
+		"res/Audio/SFX/Intro321GO.ogg",         //3
+		"res/Audio/SFX/HitWall.ogg",            //4
+		"res/Audio/SFX/Engine.ogg",             //5
+		"res/Audio/SFX/Strafe.ogg",             //6
+		"res/Audio/SFX/SlipSlowdown.ogg",       //7
+		"res/Audio/SFX/Danger.ogg",             //8
+		"res/Audio/SFX/AnnounceBoostPower.ogg", //9
+		"res/Audio/SFX/AnnounceFinalLap.ogg",   //10
+		"res/Audio/SFX/FallFemale.ogg",         //11
+		"res/Audio/SFX/FallMale.ogg",           //12
+		"res/Audio/SFX/Boost/boost_bull.ogg",   //13
+		"res/Audio/SFX/Boost/boost_falcon.ogg", //14
+		"res/Audio/SFX/Boost/boost_norita.ogg", //15
+		"res/Audio/SFX/Boost/boost_phantom.ogg",//16
+		"res/Audio/SFX/Boost/boost_wyvern.ogg", //17
+		"res/Audio/SFX/ExplosionBig.ogg",       //18
+		"res/Audio/SFX/ExplosionSmall.ogg"      //19
+	};
+
+	//Decoding them is what takes the time, so that all happens at once before any get uploaded
+	std::vector<CookedSound> sounds;
+	CookedSound::loadAll(&fileNames, &sounds);
+
+	for (CookedSound& sound : sounds)
+	{
+		AudioPlayer::buffersSE.push_back(sound.upload());
+	}
 }
 
 void AudioPlayer::loadBGM(char* fileName)
 {
-	AudioPlayer::buffersBGM.push_back(AudioMaster::loadOGG(fileName));
+	AudioPlayer::bgmFileNames.push_back(fileName);
 }
 
 void AudioPlayer::deleteSources()
@@ -71,17 +83,10 @@ void AudioPlayer::deleteBuffersSE()
 	AudioPlayer::buffersSE.shrink_to_fit();
 }
 
-void AudioPlayer::deleteBuffersBGM()
+void AudioPlayer::clearBGM()
 {
-	Source* src = AudioPlayer::sources[14];
-	src->stop();
-
-	for (ALuint buff : AudioPlayer::buffersBGM)
-	{
-		alDeleteBuffers(1, &buff);
-	}
-	AudioPlayer::buffersBGM.clear();
-	AudioPlayer::buffersBGM.shrink_to_fit();
+	MusicStream::stop();
+	AudioPlayer::bgmFileNames.clear();
 }
 
 void AudioPlayer::createSources()
@@ -153,38 +158,24 @@ Source* AudioPlayer::play(int buffer, Vector3f* pos, float pitch, bool loop, flo
 
 Source* AudioPlayer::playBGM(int bufferLoop)
 {
-	if (bufferLoop >= (int)AudioPlayer::buffersBGM.size() || bufferLoop < 0)
+	if (bufferLoop >= (int)AudioPlayer::bgmFileNames.size() || bufferLoop < 0)
 	{
 		std::fprintf(stderr, "Error: Index out of bounds on BGM buffers\n");
 		return nullptr;
 	}
 
-	return AudioPlayer::playBGM(AudioPlayer::buffersBGM[bufferLoop]);
-}
-
-Source* AudioPlayer::playBGM(ALuint bufferLoop)
-{
 	Source* src = AudioPlayer::sources[14];
-	src->stop();
-	src->setLooping(false);
-
-	alSourcei(src->getSourceID(), AL_BUFFER, AL_NONE);
-
-	src->setLooping(true);
 	src->setVolume(AudioPlayer::soundLevelBGM);
 
-	AudioPlayer::bgmIntro = AL_NONE;
-	AudioPlayer::bgmLoop = bufferLoop;
-
-	src->play(AudioPlayer::bgmLoop);
+	MusicStream::play("", AudioPlayer::bgmFileNames[bufferLoop]);
 
 	return src;
 }
 
 Source* AudioPlayer::playBGMWithIntro(int bufferIntro, int bufferLoop)
 {
-	if (bufferIntro >= (int)AudioPlayer::buffersBGM.size() ||
-		bufferLoop  >= (int)AudioPlayer::buffersBGM.size() ||
+	if (bufferIntro >= (int)AudioPlayer::bgmFileNames.size() ||
+		bufferLoop  >= (int)AudioPlayer::bgmFileNames.size() ||
 		bufferIntro < 0 ||
 		bufferLoop  < 0)
 	{
@@ -192,64 +183,17 @@ Source* AudioPlayer::playBGMWithIntro(int bufferIntro, int bufferLoop)
 		return nullptr;
 	}
 
-	return AudioPlayer::playBGMWithIntro(AudioPlayer::buffersBGM[bufferIntro], AudioPlayer::buffersBGM[bufferLoop]);
-}
-
-Source* AudioPlayer::playBGMWithIntro(ALuint bufferIntro, ALuint bufferLoop)
-{
 	Source* src = AudioPlayer::sources[14];
-	src->stop();
 	src->setVolume(AudioPlayer::soundLevelBGM);
-	src->setLooping(false);
-
 
-	alSourcei(src->getSourceID(), AL_BUFFER, AL_NONE); //Get rid of queued buffers 
-
-	AudioPlayer::bgmIntro = bufferIntro;
-	AudioPlayer::bgmLoop  = bufferLoop;
-
-	alSourceQueueBuffers(src->getSourceID(), 1, &AudioPlayer::bgmIntro);
-	alSourceQueueBuffers(src->getSourceID(), 1, &AudioPlayer::bgmLoop);
-	alSourcePlay(src->getSourceID());
-
-	//if (!src->isPlaying() || src->getLastPlayedBufferID() != AudioPlayer::buffersBGM[buffer])
-	{
-		//src->setLooping(true);
-		//src->setVolume(AudioPlayer::soundLevelBGM);
-		//src->play(AudioPlayer::buffersBGM[buffer]);
-	}
+	MusicStream::play(AudioPlayer::bgmFileNames[bufferIntro], AudioPlayer::bgmFileNames[bufferLoop]);
 
 	return src;
 }
 
-//Gets rid of the intro buffer, so that just the loop buffer loops
-void AudioPlayer::refreshBGM()
-{
-	Source* src = AudioPlayer::sources[14];
-
-	if (AudioPlayer::bgmIntro != AL_NONE)
-	{
-		ALint currentBufferIndex;
-		alGetSourcei(src->getSourceID(), AL_BUFFERS_PROCESSED, &currentBufferIndex);
-		if (currentBufferIndex == 1)
-		{
-			alSourceUnqueueBuffers(src->getSourceID(), 1, &AudioPlayer::bgmIntro);
-			AudioPlayer::bgmIntro = AL_NONE;
-			src->setLooping(true);
-		}
-	}
-}
-
 void AudioPlayer::stopBGM()
 {
-	Source* src = AudioPlayer::sources[14];
-	src->stop();
-	src->setLooping(false);
-
-	alSourcei(src->getSourceID(), AL_BUFFER, AL_NONE); //Get rid of queued buffers 
-
-	AudioPlayer::bgmIntro = AL_NONE;
-	AudioPlayer::bgmLoop  = AL_NONE;
+	MusicStream::stop();
 }
 
 Source* AudioPlayer::getSource(int i)
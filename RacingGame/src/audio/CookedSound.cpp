@@ -0,0 +1,292 @@
+#include <AL/al.h>
+#include <vorbis/vorbisfile.h>
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <functional>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include "cookedsound.h"
+#include "../toolbox/mappedfile.h"
+#include "../engineTester/main.h"
+
+CookedSound::CookedSound()
+{
+	samples = nullptr;
+	byteCount = 0;
+	format = AL_FORMAT_STEREO16;
+	frequency = 44100;
+}
+
+bool CookedSound::load(std::string fileName)
+{
+	MappedFile file;
+	if (!file.open(fileName))
+	{
+		std::fprintf(stderr, "Error when trying to open '%s'\n", fileName.c_str());
+		return false;
+	}
+
+	unsigned long long hash = hashBytes((const unsigned char*)file.getData(), file.getSize());
+	file.close();
+
+	std::string cacheName = cacheFileName(hash);
+	if (openCache(cacheName, hash))
+	{
+		return true;
+	}
+
+	if (!decode(fileName))
+	{
+		return false;
+	}
+
+	writeCache(cacheName, hash);
+
+	return true;
+}
+
+void CookedSound::loadAll(std::vector<std::string>* fileNames, std::vector<CookedSound>* sounds)
+{
+	#ifdef DEV_MODE
+	auto timeStart = std::chrono::high_resolution_clock::now();
+	#endif
+
+	//Made in place, since a CookedSound can't be copied once it has mapped its cache file
+	std::vector<CookedSound> loaded(fileNames->size());
+	sounds->swap(loaded);
+
+	//Each thread takes the next sound that nobody has started yet
+	std::atomic<int> next(0);
+	auto loadSounds = [&]()
+	{
+		for (int i = next++; i < (int)fileNames->size(); i = next++)
+		{
+			(*sounds)[i].load((*fileNames)[i]);
+		}
+	};
+
+	int threadCount = std::min((int)fileNames->size(), (int)std::thread::hardware_concurrency());
+
+	//This thread loads sounds too
+	std::vector<std::thread> threads;
+	for (int i = 1; i < threadCount; i++)
+	{
+		threads.push_back(std::thread(loadSounds));
+	}
+	loadSounds();
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	#ifdef DEV_MODE
+	auto timeEnd = std::chrono::high_resolution_clock::now();
+	std::fprintf(stdout, "Sounds: %d sounds loaded on %d threads in %f ms\n",
+		(int)fileNames->size(), std::max(threadCount, 1),
+		std::chrono::duration<double, std::milli>(timeEnd - timeStart).count());
+	#endif
+}
+
+ALuint CookedSound::upload()
+{
+	if (samples == nullptr)
+	{
+		return AL_NONE;
+	}
+
+	ALuint buffer;
+	alGenBuffers(1, &buffer);
+	alBufferData(buffer, format, samples, byteCount, frequency);
+	return buffer;
+}
+
+bool CookedSound::decode(std::string fileName)
+{
+	FILE* fp = nullptr;
+	int er = fopen_s(&fp, fileName.c_str(), "rb");
+	if (fp == nullptr || er != 0)
+	{
+		std::fprintf(stderr, "Error when trying to open '%s'\n", fileName.c_str());
+		if (er != 0)
+		{
+			std::fprintf(stderr, "fopen_s return value: %d\n", er);
+		}
+		return false;
+	}
+
+	//The file now belongs to oggFile and gets closed by ov_clear
+	OggVorbis_File oggFile;
+	if (ov_open(fp, &oggFile, nullptr, 0) != 0)
+	{
+		std::fprintf(stderr, "Error: '%s' is not an ogg vorbis file\n", fileName.c_str());
+		fclose(fp);
+		return false;
+	}
+
+	vorbis_info* pInfo = ov_info(&oggFile, -1);
+	format = (pInfo->channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+	frequency = (ALsizei)pInfo->rate;
+
+	//The whole sound gets decoded straight into one buffer that is already big enough,
+	// with a bit extra so that the read that finds the end has somewhere to go
+	long long totalBytes = std::max(0LL, (long long)ov_pcm_total(&oggFile, -1)*pInfo->channels*2);
+	decoded.resize((size_t)totalBytes + 4096);
+
+	int filled = 0;
+	while (true)
+	{
+		if (filled == (int)decoded.size())
+		{
+			//Only if the length in the file was wrong
+			decoded.resize(decoded.size() + 32768);
+		}
+
+		int bitStream;
+		long bytes = ov_read(&oggFile, &decoded[filled], (int)decoded.size() - filled, 0, 2, 1, &bitStream);
+		if (bytes == OV_HOLE)
+		{
+			continue;
+		}
+		if (bytes <= 0)
+		{
+			break;
+		}
+		filled += (int)bytes;
+	}
+
+	ov_clear(&oggFile);
+
+	if (filled == 0)
+	{
+		std::fprintf(stderr, "Error: '%s' has no samples\n", fileName.c_str());
+		decoded.clear();
+		return false;
+	}
+
+	decoded.resize(filled);
+	samples = &decoded[0];
+	byteCount = filled;
+
+	return true;
+}
+
+unsigned long long CookedSound::hashBytes(const unsigned char* bytes, size_t size)
+{
+	//FNV-1a
+	unsigned long long hash = 14695981039346656037ull;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+std::string CookedSound::cacheFileName(unsigned long long hash)
+{
+	char name[64];
+	snprintf(name, sizeof(name), "res/AudioCache/%016llx.pcm", hash);
+	return name;
+}
+
+//The cache file is the header below, followed by the samples exactly as alBufferData takes them
+struct SoundCacheHeader
+{
+	char fileType[4];
+	int version;
+	unsigned long long sourceHash;
+	int format;
+	int frequency;
+	int byteCount;
+	int padding;
+};
+
+bool CookedSound::openCache(std::string fileName, unsigned long long hash)
+{
+	if (!cacheFile.open(fileName))
+	{
+		return false;
+	}
+
+	const SoundCacheHeader* header = (const SoundCacheHeader*)cacheFile.getData();
+	bool valid =
+		cacheFile.getSize() > sizeof(SoundCacheHeader) &&
+		memcmp(header->fileType, "cpc", 4) == 0 &&
+		header->version == CACHE_VERSION &&
+		header->sourceHash == hash &&
+		(header->format == AL_FORMAT_MONO16 || header->format == AL_FORMAT_STEREO16) &&
+		header->frequency > 0 &&
+		header->byteCount > 0 &&
+		(size_t)header->byteCount == cacheFile.getSize() - sizeof(SoundCacheHeader);
+
+	if (!valid)
+	{
+		//It gets decoded again and written over
+		cacheFile.close();
+		return false;
+	}
+
+	format = (ALenum)header->format;
+	frequency = (ALsizei)header->frequency;
+	byteCount = header->byteCount;
+	samples = cacheFile.getData() + sizeof(SoundCacheHeader);
+
+	return true;
+}
+
+void CookedSound::writeCache(std::string fileName, unsigned long long hash)
+{
+	#ifdef _WIN32
+	_mkdir("res/AudioCache");
+	#else
+	mkdir("res/AudioCache", 0777);
+	#endif
+
+	//Written under a name of its own and then renamed, so that a cache file that is
+	// mapped by another thread loading the same sound never gets cut short
+	std::string tempName = fileName + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+	FILE* file = nullptr;
+	int err = fopen_s(&file, tempName.c_str(), "wb");
+	if (file == nullptr || err != 0)
+	{
+		return;
+	}
+
+	SoundCacheHeader header;
+	memset(&header, 0, sizeof(SoundCacheHeader));
+	memcpy(header.fileType, "cpc", 4);
+	header.version = CACHE_VERSION;
+	header.sourceHash = hash;
+	header.format = (int)format;
+	header.frequency = (int)frequency;
+	header.byteCount = byteCount;
+
+	fwrite(&header, sizeof(SoundCacheHeader), 1, file);
+	fwrite(samples, sizeof(char), byteCount, file);
+	fclose(file);
+
+	//Windows won't rename over a file, so an old one has to go first. If it can't
+	// go because another thread has it mapped, that thread already wrote the same thing.
+	if (std::rename(tempName.c_str(), fileName.c_str()) != 0)
+	{
+		std::remove(fileName.c_str());
+		if (std::rename(tempName.c_str(), fileName.c_str()) != 0)
+		{
+			std::remove(tempName.c_str());
+		}
+	}
+}
\ No newline at end of file
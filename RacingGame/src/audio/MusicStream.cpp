@@ -0,0 +1,300 @@
+#include <AL/al.h>
+#include <vorbis/vorbisfile.h>
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdio>
+
+#include "musicstream.h"
+#include "../engineTester/main.h"
+
+ALuint MusicStream::sourceID = AL_NONE;
+ALuint MusicStream::buffers[BUFFER_COUNT];
+
+std::thread MusicStream::decoder;
+std::mutex MusicStream::mutex;
+std::condition_variable MusicStream::changed;
+bool MusicStream::quit = false;
+
+unsigned int MusicStream::requestNumber = 0;
+bool MusicStream::requestPlay = false;
+std::string MusicStream::introFileName = "";
+std::string MusicStream::loopFileName = "";
+
+std::vector<ALuint> MusicStream::freeBuffers;
+char MusicStream::pcm[BUFFER_BYTES];
+
+bool MusicStream::playing = false;
+OggVorbis_File MusicStream::intro;
+OggVorbis_File MusicStream::loop;
+bool MusicStream::introOpen = false;
+bool MusicStream::loopOpen = false;
+OggVorbis_File* MusicStream::current = nullptr;
+ALenum MusicStream::format = AL_FORMAT_STEREO16;
+ALsizei MusicStream::frequency = 44100;
+
+void MusicStream::init(ALuint sourceID)
+{
+	MusicStream::sourceID = sourceID;
+	alSourcei(sourceID, AL_LOOPING, AL_FALSE);
+
+	alGenBuffers(BUFFER_COUNT, MusicStream::buffers);
+	MusicStream::freeBuffers.assign(MusicStream::buffers, MusicStream::buffers + BUFFER_COUNT);
+
+	MusicStream::quit = false;
+	MusicStream::decoder = std::thread(MusicStream::decode);
+}
+
+void MusicStream::play(std::string introFileName, std::string loopFileName)
+{
+	std::lock_guard<std::mutex> lock(MusicStream::mutex);
+	MusicStream::introFileName = introFileName;
+	MusicStream::loopFileName = loopFileName;
+	MusicStream::requestPlay = true;
+	MusicStream::requestNumber++;
+	MusicStream::changed.notify_all();
+}
+
+void MusicStream::stop()
+{
+	std::lock_guard<std::mutex> lock(MusicStream::mutex);
+	MusicStream::requestPlay = false;
+	MusicStream::requestNumber++;
+	MusicStream::changed.notify_all();
+}
+
+void MusicStream::cleanUp()
+{
+	{
+		std::lock_guard<std::mutex> lock(MusicStream::mutex);
+		MusicStream::quit = true;
+		MusicStream::changed.notify_all();
+	}
+
+	//The decode thread stops the source on its way out
+	if (MusicStream::decoder.joinable())
+	{
+		MusicStream::decoder.join();
+	}
+
+	alDeleteBuffers(BUFFER_COUNT, MusicStream::buffers);
+	MusicStream::freeBuffers.clear();
+}
+
+void MusicStream::decode()
+{
+	unsigned int handledRequest = 0;
+	while (true)
+	{
+		bool quitting;
+		bool newRequest = false;
+		bool startPlaying = false;
+		std::string intro;
+		std::string loop;
+
+		{
+			//A buffer lasts about a third of a second, so there is plenty of time before the source runs out
+			std::unique_lock<std::mutex> lock(MusicStream::mutex);
+			MusicStream::changed.wait_for(lock, std::chrono::milliseconds(10), [&handledRequest]()
+			{
+				return MusicStream::quit || MusicStream::requestNumber != handledRequest;
+			});
+
+			quitting = MusicStream::quit;
+			if (MusicStream::requestNumber != handledRequest)
+			{
+				handledRequest = MusicStream::requestNumber;
+				newRequest = true;
+				startPlaying = MusicStream::requestPlay;
+				intro = MusicStream::introFileName;
+				loop = MusicStream::loopFileName;
+			}
+		}
+
+		if (newRequest || quitting)
+		{
+			MusicStream::stopTrack();
+		}
+
+		if (quitting)
+		{
+			return;
+		}
+
+		if (startPlaying)
+		{
+			MusicStream::startTrack(intro, loop);
+		}
+
+		if (MusicStream::playing)
+		{
+			MusicStream::refill();
+		}
+	}
+}
+
+bool MusicStream::openFile(std::string fileName, OggVorbis_File* file)
+{
+	FILE* fp = nullptr;
+	int er = fopen_s(&fp, fileName.c_str(), "rb");
+	if (fp == nullptr || er != 0)
+	{
+		std::fprintf(stderr, "Error when trying to open '%s'\n", fileName.c_str());
+		return false;
+	}
+
+	//The file now belongs to the OggVorbis_File and gets closed by ov_clear
+	if (ov_open(fp, file, nullptr, 0) != 0)
+	{
+		std::fprintf(stderr, "Error: '%s' is not an ogg vorbis file\n", fileName.c_str());
+		fclose(fp);
+		return false;
+	}
+
+	return true;
+}
+
+void MusicStream::closeFiles()
+{
+	if (MusicStream::introOpen)
+	{
+		ov_clear(&MusicStream::intro);
+		MusicStream::introOpen = false;
+	}
+	if (MusicStream::loopOpen)
+	{
+		ov_clear(&MusicStream::loop);
+		MusicStream::loopOpen = false;
+	}
+	MusicStream::current = nullptr;
+}
+
+void MusicStream::startTrack(std::string introFileName, std::string loopFileName)
+{
+	MusicStream::loopOpen = MusicStream::openFile(loopFileName, &MusicStream::loop);
+	if (!MusicStream::loopOpen)
+	{
+		return;
+	}
+
+	vorbis_info* loopInfo = ov_info(&MusicStream::loop, -1);
+	MusicStream::format = (loopInfo->channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+	MusicStream::frequency = (ALsizei)loopInfo->rate;
+	MusicStream::current = &MusicStream::loop;
+
+	if (introFileName != "")
+	{
+		MusicStream::introOpen = MusicStream::openFile(introFileName, &MusicStream::intro);
+		if (MusicStream::introOpen)
+		{
+			//Every buffer queued on a source has to be the same format
+			vorbis_info* introInfo = ov_info(&MusicStream::intro, -1);
+			if (introInfo->channels != loopInfo->channels || introInfo->rate != loopInfo->rate)
+			{
+				std::fprintf(stderr, "Error: '%s' and '%s' aren't the same format, skipping the intro\n",
+					introFileName.c_str(), loopFileName.c_str());
+				ov_clear(&MusicStream::intro);
+				MusicStream::introOpen = false;
+			}
+			else
+			{
+				MusicStream::current = &MusicStream::intro;
+			}
+		}
+	}
+
+	MusicStream::playing = true;
+}
+
+void MusicStream::stopTrack()
+{
+	alSourceStop(MusicStream::sourceID);
+	alSourcei(MusicStream::sourceID, AL_BUFFER, AL_NONE); //Get rid of queued buffers
+	MusicStream::freeBuffers.assign(MusicStream::buffers, MusicStream::buffers + BUFFER_COUNT);
+
+	MusicStream::closeFiles();
+	MusicStream::playing = false;
+}
+
+bool MusicStream::fillBuffer(ALuint buffer)
+{
+	int filled = 0;
+	bool loopRestarted = false;
+	while (filled < BUFFER_BYTES && MusicStream::current != nullptr)
+	{
+		int bitStream;
+		long bytes = ov_read(MusicStream::current, MusicStream::pcm + filled, BUFFER_BYTES - filled, 0, 2, 1, &bitStream);
+		if (bytes > 0)
+		{
+			filled += (int)bytes;
+			loopRestarted = false;
+		}
+		else if (bytes == OV_HOLE)
+		{
+			//Corrupt or missing data, the next read carries on after it
+			continue;
+		}
+		else if (MusicStream::current == &MusicStream::intro)
+		{
+			//The loop picks up right where the intro ends
+			MusicStream::current = &MusicStream::loop;
+		}
+		else if (!loopRestarted && ov_pcm_seek(&MusicStream::loop, 0) == 0)
+		{
+			loopRestarted = true;
+		}
+		else
+		{
+			//An empty or broken loop would never fill the buffer
+			MusicStream::current = nullptr;
+		}
+	}
+
+	if (filled == 0)
+	{
+		return false;
+	}
+
+	alBufferData(buffer, MusicStream::format, MusicStream::pcm, filled, MusicStream::frequency);
+	return true;
+}
+
+void MusicStream::refill()
+{
+	ALint processed = 0;
+	alGetSourcei(MusicStream::sourceID, AL_BUFFERS_PROCESSED, &processed);
+	for (int i = 0; i < processed; i++)
+	{
+		ALuint buffer;
+		alSourceUnqueueBuffers(MusicStream::sourceID, 1, &buffer);
+		MusicStream::freeBuffers.push_back(buffer);
+	}
+
+	while (MusicStream::freeBuffers.size() > 0 && MusicStream::fillBuffer(MusicStream::freeBuffers.back()))
+	{
+		alSourceQueueBuffers(MusicStream::sourceID, 1, &MusicStream::freeBuffers.back());
+		MusicStream::freeBuffers.pop_back();
+	}
+
+	ALint queued = 0;
+	alGetSourcei(MusicStream::sourceID, AL_BUFFERS_QUEUED, &queued);
+	if (queued == 0)
+	{
+		//Nothing left to play
+		MusicStream::closeFiles();
+		MusicStream::playing = false;
+		return;
+	}
+
+	//Starts it the first time, or again if it played every buffer before they could be refilled
+	ALint state = AL_STOPPED;
+	alGetSourcei(MusicStream::sourceID, AL_SOURCE_STATE, &state);
+	if (state == AL_INITIAL || state == AL_STOPPED)
+	{
+		alSourcePlay(MusicStream::sourceID);
+	}
+}
\ No newline at end of file
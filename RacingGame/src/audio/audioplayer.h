@@ -3,6 +3,7 @@
 
 #include <AL/al.h>
 #include <vector>
+#include <string>
 
 class Source;
 class Vector3f;
@@ -14,11 +15,9 @@ private:
 	static float soundLevelBGM;
 	static std::vector<Source*> sources;
 	static std::vector<ALuint> buffersSE;
-	static std::vector<ALuint> buffersBGM;
 
-public:
-	static ALuint bgmIntro;
-	static ALuint bgmLoop;
+	//The music for the current level, which gets streamed from the file when it plays
+	static std::vector<std::string> bgmFileNames;
 
 public:
 	static void loadSettings();
@@ -31,7 +30,7 @@ public:
 
 	static void deleteBuffersSE();
 
-	static void deleteBuffersBGM();
+	static void clearBGM();
 
 	static void createSources();
 
@@ -47,19 +46,13 @@ public:
 	//with everything
 	static Source* play(int buffer, Vector3f* pos, float pitch, bool loop, float xVel, float yVel, float zVel);
 
+	//Plays bgm number bufferIntro once, and then bufferLoop forever
 	static Source* playBGMWithIntro(int bufferIntro, int bufferLoop);
 
-	static Source* playBGMWithIntro(ALuint bufferIntro, ALuint bufferLoop);
-
 	static Source* playBGM(int bufferLoop);
 
-	static Source* playBGM(ALuint bufferLoop);
-
 	static Source* getSource(int i);
 
-	//Needs to be called to set the looping buffer to loop
-	static void refreshBGM();
-
 	static void stopBGM();
 
 	static void stopAllSFX();
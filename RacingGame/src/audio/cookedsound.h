@@ -0,0 +1,53 @@
+#ifndef COOKEDSOUND_H
+#define COOKEDSOUND_H
+
+#include <AL/al.h>
+#include <string>
+#include <vector>
+
+#include "../toolbox/mappedfile.h"
+
+//The samples of an ogg file, ready for alBufferData.
+//Decoded sounds are saved to res/AudioCache under the hash of the ogg file they
+// came from, so the next time the same ogg loads, the samples are just mapped
+// from the cache instead of being decoded again. Editing the ogg changes its
+// hash, so an old cache file never gets used for it.
+class CookedSound
+{
+private:
+	static const int CACHE_VERSION = 1;
+
+	//Either the samples in the cache file, or the ones that were just decoded
+	MappedFile cacheFile;
+	std::vector<char> decoded;
+
+	const char* samples;
+	int byteCount;
+
+	ALenum format;
+	ALsizei frequency;
+
+	bool decode(std::string fileName);
+
+	static unsigned long long hashBytes(const unsigned char* bytes, size_t size);
+
+	static std::string cacheFileName(unsigned long long hash);
+
+	bool openCache(std::string fileName, unsigned long long hash);
+
+	void writeCache(std::string fileName, unsigned long long hash);
+
+public:
+	CookedSound();
+
+	//Returns false if the ogg can't be read
+	bool load(std::string fileName);
+
+	//Loads every file at once, spread out over all of the cpu cores.
+	//Sounds that fail to load are left empty.
+	static void loadAll(std::vector<std::string>* fileNames, std::vector<CookedSound>* sounds);
+
+	//Makes a new sound buffer out of the samples. Returns AL_NONE if the sound didn't load.
+	ALuint upload();
+};
+#endif
\ No newline at end of file
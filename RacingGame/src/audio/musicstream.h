@@ -0,0 +1,87 @@
+#ifndef MUSICSTREAM_H
+#define MUSICSTREAM_H
+
+#include <AL/al.h>
+#include <vorbis/vorbisfile.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//Plays the background music without ever decoding a whole song at once.
+//A few small buffers are queued on the music source, and a decode thread fills
+// each one back up with the next part of the ogg as soon as it has been played.
+//When the intro ends, the same buffer keeps going with the start of the loop,
+// and when the loop ends it keeps going from the start of the loop again, so
+// there is never a gap between them.
+class MusicStream
+{
+private:
+	static const int BUFFER_COUNT = 4;
+
+	//About a third of a second of 44100hz stereo
+	static const int BUFFER_BYTES = 65536;
+
+	static ALuint sourceID;
+	static ALuint buffers[BUFFER_COUNT];
+
+	static std::thread decoder;
+
+	//The mutex only guards the requests from play, stop and cleanUp. It is never
+	// held while opening or decoding a file, so those never have to wait for it.
+	static std::mutex mutex;
+	static std::condition_variable changed;
+	static bool quit;
+
+	//Goes up every time play or stop is called, so the decode thread can tell
+	// that there is something new for it to do
+	static unsigned int requestNumber;
+	static bool requestPlay;
+	static std::string introFileName;
+	static std::string loopFileName;
+
+	//Everything below is only used by the decode thread
+
+	//Buffers that aren't queued on the source
+	static std::vector<ALuint> freeBuffers;
+
+	static char pcm[BUFFER_BYTES];
+
+	static bool playing;
+	static OggVorbis_File intro;
+	static OggVorbis_File loop;
+	static bool introOpen;
+	static bool loopOpen;
+	static OggVorbis_File* current;
+	static ALenum format;
+	static ALsizei frequency;
+
+	static void decode();
+
+	static bool openFile(std::string fileName, OggVorbis_File* file);
+
+	static void closeFiles();
+
+	static void startTrack(std::string introFileName, std::string loopFileName);
+
+	static void stopTrack();
+
+	//Decodes the next part of the song into buffer. Returns false if the song is over.
+	static bool fillBuffer(ALuint buffer);
+
+	//Queues up every buffer that has finished playing again
+	static void refill();
+
+public:
+	//Starts the decode thread, which streams to the source
+	static void init(ALuint sourceID);
+
+	//Plays the intro once and then the loop forever. introFileName can be "" for no intro.
+	static void play(std::string introFileName, std::string loopFileName);
+
+	static void stop();
+
+	static void cleanUp();
+};
+#endif
\ No newline at end of file
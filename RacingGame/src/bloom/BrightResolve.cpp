@@ -0,0 +1,38 @@
+#include <glad/glad.h>
+
+#include "brightresolve.h"
+#include "brightresolveshader.h"
+#include "../postProcessing/imagerenderer.h"
+#include "../engineTester/main.h"
+
+BrightResolve::BrightResolve(int targetFboWidth, int targetFboHeight)
+{
+	shader = new BrightResolveShader("res/Shaders/bloom/simpleVertex.txt", "res/Shaders/bloom/brightResolveFragment.txt"); INCR_NEW
+	shader->start();
+	shader->connectTextureUnits();
+	shader->stop();
+	renderer = new ImageRenderer(targetFboWidth, targetFboHeight); INCR_NEW
+}
+
+void BrightResolve::render(GLuint multisampleTexture)
+{
+	shader->start();
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, multisampleTexture);
+	renderer->renderQuad();
+	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+	shader->stop();
+}
+
+int BrightResolve::getOutputTexture()
+{
+	return renderer->getOutputTexture();
+}
+
+void BrightResolve::cleanUp()
+{
+	renderer->cleanUp();
+	shader->cleanUp();
+	delete shader; INCR_DEL
+	delete renderer; INCR_DEL
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "brightresolveshader.h"
+#include "../renderEngine/renderEngine.h"
+
+#include <glad/glad.h>
+
+BrightResolveShader::BrightResolveShader(const char* vFile, const char* fFile)
+{
+	vertexShaderID = Loader::loadShader(vFile, GL_VERTEX_SHADER);
+	fragmentShaderID = Loader::loadShader(fFile, GL_FRAGMENT_SHADER);
+	programID = glCreateProgram();
+	glAttachShader(programID, vertexShaderID);
+	glAttachShader(programID, fragmentShaderID);
+	bindAttributes();
+	glLinkProgram(programID);
+	glValidateProgram(programID);
+	getAllUniformLocations();
+}
+
+void BrightResolveShader::start()
+{
+	glUseProgram(programID);
+}
+
+void BrightResolveShader::stop()
+{
+	glUseProgram(0);
+}
+
+void BrightResolveShader::cleanUp()
+{
+	stop();
+	glDetachShader(programID, vertexShaderID);
+	glDetachShader(programID, fragmentShaderID);
+	glDeleteShader(vertexShaderID);
+	glDeleteShader(fragmentShaderID);
+	glDeleteProgram(programID);
+}
+
+void BrightResolveShader::connectTextureUnits()
+{
+	loadInt(location_brightTexture, 0);
+}
+
+void BrightResolveShader::bindAttributes()
+{
+	bindAttribute(0, "position");
+}
+
+void BrightResolveShader::bindAttribute(int attribute, const char* variableName)
+{
+	glBindAttribLocation(programID, attribute, variableName);
+}
+
+void BrightResolveShader::getAllUniformLocations()
+{
+	location_brightTexture = getUniformLocation("brightTexture");
+}
+
+int BrightResolveShader::getUniformLocation(const char* uniformName)
+{
+	return glGetUniformLocation(programID, uniformName);
+}
+
+void BrightResolveShader::loadInt(int location, int value)
+{
+	glUniform1i(location, value);
+}
\ No newline at end of file
@@ -5,11 +5,12 @@
 #include "combineshader.h"
 #include "../postProcessing/imagerenderer.h"
 
-CombineFilter::CombineFilter()
+CombineFilter::CombineFilter(float bloomStrength)
 {
 	shader = new CombineShader("res/Shaders/bloom/simpleVertex.txt", "res/Shaders/bloom/combineFragment.txt"); INCR_NEW
 	shader->start();
 	shader->connectTextureUnits();
+	shader->loadBloomStrength(bloomStrength);
 	shader->stop();
 	renderer = new ImageRenderer; INCR_NEW
 }
@@ -42,6 +42,11 @@ void CombineShader::connectTextureUnits()
 	loadInt(location_highlightTexture, 1);
 }
 
+void CombineShader::loadBloomStrength(float strength)
+{
+	loadFloat(location_bloomStrength, strength);
+}
+
 void CombineShader::bindAttributes()
 {
 	bindAttribute(0, "position");
@@ -56,6 +61,7 @@ void CombineShader::getAllUniformLocations()
 {
 	location_colourTexture = getUniformLocation("colourTexture");
 	location_highlightTexture = getUniformLocation("highlightTexture");
+	location_bloomStrength = getUniformLocation("bloomStrength");
 }
 
 int CombineShader::getUniformLocation(const char* uniformName)
@@ -67,3 +73,8 @@ void CombineShader::loadInt(int location, int value)
 {
 	glUniform1i(location, value);
 }
+
+void CombineShader::loadFloat(int location, float value)
+{
+	glUniform1f(location, value);
+}
@@ -0,0 +1,40 @@
+#include <glad/glad.h>
+
+#include "upsamplefilter.h"
+#include "upsampleshader.h"
+#include "../postProcessing/imagerenderer.h"
+#include "../engineTester/main.h"
+
+UpsampleFilter::UpsampleFilter(int targetFboWidth, int targetFboHeight, int lowerWidth, int lowerHeight)
+{
+	shader = new UpsampleShader("res/Shaders/bloom/simpleVertex.txt", "res/Shaders/bloom/upsampleFragment.txt"); INCR_NEW
+	shader->start();
+	shader->connectTextureUnits();
+	shader->loadLowerTexelSize(1.0f/lowerWidth, 1.0f/lowerHeight);
+	shader->stop();
+	renderer = new ImageRenderer(targetFboWidth, targetFboHeight); INCR_NEW
+}
+
+void UpsampleFilter::render(GLuint levelTexture, GLuint lowerLevelTexture)
+{
+	shader->start();
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, levelTexture);
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, lowerLevelTexture);
+	renderer->renderQuad();
+	shader->stop();
+}
+
+int UpsampleFilter::getOutputTexture()
+{
+	return renderer->getOutputTexture();
+}
+
+void UpsampleFilter::cleanUp()
+{
+	renderer->cleanUp();
+	shader->cleanUp();
+	delete shader; INCR_DEL
+	delete renderer; INCR_DEL
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "upsampleshader.h"
+#include "../renderEngine/renderEngine.h"
+
+#include <glad/glad.h>
+
+UpsampleShader::UpsampleShader(const char* vFile, const char* fFile)
+{
+	vertexShaderID = Loader::loadShader(vFile, GL_VERTEX_SHADER);
+	fragmentShaderID = Loader::loadShader(fFile, GL_FRAGMENT_SHADER);
+	programID = glCreateProgram();
+	glAttachShader(programID, vertexShaderID);
+	glAttachShader(programID, fragmentShaderID);
+	bindAttributes();
+	glLinkProgram(programID);
+	glValidateProgram(programID);
+	getAllUniformLocations();
+}
+
+void UpsampleShader::start()
+{
+	glUseProgram(programID);
+}
+
+void UpsampleShader::stop()
+{
+	glUseProgram(0);
+}
+
+void UpsampleShader::cleanUp()
+{
+	stop();
+	glDetachShader(programID, vertexShaderID);
+	glDetachShader(programID, fragmentShaderID);
+	glDeleteShader(vertexShaderID);
+	glDeleteShader(fragmentShaderID);
+	glDeleteProgram(programID);
+}
+
+void UpsampleShader::connectTextureUnits()
+{
+	loadInt(location_levelTexture, 0);
+	loadInt(location_lowerLevelTexture, 1);
+}
+
+void UpsampleShader::loadLowerTexelSize(float width, float height)
+{
+	loadVector2f(location_lowerTexelSize, width, height);
+}
+
+void UpsampleShader::bindAttributes()
+{
+	bindAttribute(0, "position");
+}
+
+void UpsampleShader::bindAttribute(int attribute, const char* variableName)
+{
+	glBindAttribLocation(programID, attribute, variableName);
+}
+
+void UpsampleShader::getAllUniformLocations()
+{
+	location_levelTexture = getUniformLocation("levelTexture");
+	location_lowerLevelTexture = getUniformLocation("lowerLevelTexture");
+	location_lowerTexelSize = getUniformLocation("lowerTexelSize");
+}
+
+int UpsampleShader::getUniformLocation(const char* uniformName)
+{
+	return glGetUniformLocation(programID, uniformName);
+}
+
+void UpsampleShader::loadInt(int location, int value)
+{
+	glUniform1i(location, value);
+}
+
+void UpsampleShader::loadVector2f(int location, float x, float y)
+{
+	glUniform2f(location, x, y);
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#ifndef BRIGHTRESOLVE_H
+#define BRIGHTRESOLVE_H
+
+class ImageRenderer;
+class BrightResolveShader;
+
+#include <glad/glad.h>
+
+//Reads the multisampled bright target straight into an fbo half its size,
+// which replaces resolving it at full resolution first
+class BrightResolve 
+{
+private:
+	ImageRenderer* renderer;
+	BrightResolveShader* shader;
+	
+public:
+	BrightResolve(int targetFboWidth, int targetFboHeight);
+	
+	void render(GLuint multisampleTexture);
+	
+	int getOutputTexture();
+	
+	void cleanUp();
+};
+#endif
\ No newline at end of file
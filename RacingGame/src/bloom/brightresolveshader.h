@@ -0,0 +1,38 @@
+#ifndef BRIGHTRESOLVESHADER_H
+#define BRIGHTRESOLVESHADER_H
+
+#include <glad/glad.h>
+
+class BrightResolveShader
+{
+private:
+	GLuint programID;
+	GLuint vertexShaderID;
+	GLuint fragmentShaderID;
+
+	int location_brightTexture;
+
+public:
+	BrightResolveShader(const char* vFile, const char* fFile);
+
+	void start();
+
+	void stop();
+
+	void cleanUp();
+
+	void connectTextureUnits();
+
+protected:
+	void bindAttributes();
+
+	void bindAttribute(int attribute, const char* variableName);
+
+	void getAllUniformLocations();
+
+	int getUniformLocation(const char* uniformName);
+
+	void loadInt(int location, int value);
+};
+
+#endif
\ No newline at end of file
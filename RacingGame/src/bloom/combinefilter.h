@@ -13,7 +13,7 @@ private:
 	CombineShader* shader;
 	
 public:
-	CombineFilter();
+	CombineFilter(float bloomStrength);
 	
 	void render(GLuint colourTexture, GLuint highlightTexture);
 	
@@ -12,6 +12,7 @@ private:
 
 	int location_colourTexture;
 	int location_highlightTexture;
+	int location_bloomStrength;
 
 public:
 	CombineShader(const char* vFile, const char* fFile);
@@ -24,6 +25,8 @@ public:
 
 	void connectTextureUnits();
 
+	void loadBloomStrength(float strength);
+
 protected:
 	void bindAttributes();
 
@@ -34,6 +37,8 @@ protected:
 	int getUniformLocation(const char* uniformName);
 
 	void loadInt(int location, int value);
+
+	void loadFloat(int location, float value);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef UPSAMPLEFILTER_H
+#define UPSAMPLEFILTER_H
+
+class ImageRenderer;
+class UpsampleShader;
+
+#include <glad/glad.h>
+
+//Adds the next smaller bloom level on top of a blurred level of the same size as this
+class UpsampleFilter 
+{
+private:
+	ImageRenderer* renderer;
+	UpsampleShader* shader;
+	
+public:
+	UpsampleFilter(int targetFboWidth, int targetFboHeight, int lowerWidth, int lowerHeight);
+	
+	void render(GLuint levelTexture, GLuint lowerLevelTexture);
+	
+	int getOutputTexture();
+	
+	void cleanUp();
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef UPSAMPLESHADER_H
+#define UPSAMPLESHADER_H
+
+#include <glad/glad.h>
+
+class UpsampleShader
+{
+private:
+	GLuint programID;
+	GLuint vertexShaderID;
+	GLuint fragmentShaderID;
+
+	int location_levelTexture;
+	int location_lowerLevelTexture;
+	int location_lowerTexelSize;
+
+public:
+	UpsampleShader(const char* vFile, const char* fFile);
+
+	void start();
+
+	void stop();
+
+	void cleanUp();
+
+	void connectTextureUnits();
+
+	void loadLowerTexelSize(float width, float height);
+
+protected:
+	void bindAttributes();
+
+	void bindAttribute(int attribute, const char* variableName);
+
+	void getAllUniformLocations();
+
+	int getUniformLocation(const char* uniformName);
+
+	void loadInt(int location, int value);
+
+	void loadVector2f(int location, float x, float y);
+};
+
+#endif
\ No newline at end of file
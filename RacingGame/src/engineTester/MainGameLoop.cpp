@@ -15,6 +15,7 @@
 
 #include <ctime>
 #include <random>
+#include <chrono>
 
 #ifdef _WIN32
 #include <direct.h>
@@ -37,6 +38,7 @@
 #include "../entities/light.h"
 #include "../entities/stage.h"
 #include "../toolbox/levelloader.h"
+#include "../toolbox/backgroundloader.h"
 #include "../collision/collisionchecker.h"
 #include "../entities/skysphere.h"
 #include "../renderEngine/skymanager.h"
@@ -52,7 +54,6 @@
 #include "../particles/particleresources.h"
 #include "../toolbox/split.h"
 #include "../shadows/shadowmapmasterrenderer.h"
-#include "../shadows2/shadowmapmasterrenderer2.h"
 #include "../postProcessing/postprocessing.h"
 #include "../postProcessing/fbo.h"
 #include "../guis/guirenderer.h"
@@ -60,11 +61,12 @@
 #include "../toolbox/mainmenu.h"
 #include "../toolbox/level.h"
 #include "../guis/guitexture.h"
-#include "../particles/particle.h"
 #include "../entities/skysphere.h"
 #include "../fontMeshCreator/guinumber.h"
 #include "../entities/car.h"
 #include "../entities/checkpoint.h"
+#include "../toolbox/resourcemanager.h"
+#include "../toolbox/compiledlevel.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -102,7 +104,6 @@ float Global::finishStageTimer = -1;
 
 Fbo* Global::gameMultisampleFbo = nullptr;
 Fbo* Global::gameOutputFbo = nullptr;
-Fbo* Global::gameOutputFbo2 = nullptr;
 
 bool Global::debugDisplay = false;
 bool Global::frozen = false;
@@ -118,9 +119,12 @@ bool Global::renderParticles = true;
 
 bool Global::renderBloom = false;
 
+bool Global::renderTransparencyOIT = true;
+
 bool Global::renderShadowsFar = false;
 bool Global::renderShadowsClose = false;
 int Global::shadowsFarQuality = 0;
+int Global::shadowCascades = 2;
 
 
 //extern bool INPUT_JUMP;
@@ -193,14 +197,45 @@ void doListenThread();
 
 void listen();
 
-int main()
+int main(int argc, char** argv)
 {
+	//"RacingGame -cook path name [path name ...]" cooks each model into a .cobj package and quits
+	if (argc >= 2 && strcmp(argv[1], "-cook") == 0)
+	{
+		int failed = 0;
+		for (int i = 2; i + 1 < argc; i += 2)
+		{
+			if (cookModel(argv[i], argv[i + 1]) != 0)
+			{
+				failed++;
+			}
+		}
+		return failed;
+	}
+
+	//"RacingGame -compileLevel Casino.lvl [...]" compiles each level in res/Levels into a .clvl and quits
+	if (argc >= 2 && strcmp(argv[1], "-compileLevel") == 0)
+	{
+		int failed = 0;
+		for (int i = 2; i < argc; i++)
+		{
+			if (CompiledLevel::compileToFile(std::string("res/Levels/") + argv[i]) != 0)
+			{
+				failed++;
+			}
+		}
+		return failed;
+	}
+
 	#ifdef DEV_MODE
 	std::thread listenThread(doListenThread);
+	auto startupStart = std::chrono::high_resolution_clock::now();
 	#endif
 
 	increaseProcessPriority();
 
+	BackgroundLoader::init();
+
 	Global::countNew = 0;
 	Global::countDelete = 0;
 
@@ -273,14 +308,19 @@ int main()
 	if (Global::renderBloom)
 	{
 		Global::gameMultisampleFbo = new Fbo(SCR_WIDTH, SCR_HEIGHT); INCR_NEW
-		Global::gameOutputFbo      = new Fbo(SCR_WIDTH, SCR_HEIGHT, Fbo::DEPTH_TEXTURE); INCR_NEW
-		Global::gameOutputFbo2     = new Fbo(SCR_WIDTH, SCR_HEIGHT, Fbo::DEPTH_TEXTURE); INCR_NEW
+		Global::gameOutputFbo      = new Fbo(SCR_WIDTH, SCR_HEIGHT, Fbo::NONE); INCR_NEW
 		PostProcessing::init();
 	}
 
 	ParticleMaster::init(Master_getProjectionMatrix());
 
 
+	#ifdef DEV_MODE
+	auto startupEnd = std::chrono::high_resolution_clock::now();
+	std::fprintf(stdout, "Startup: %f ms before the title screen\n",
+		std::chrono::duration<double, std::milli>(startupEnd - startupStart).count());
+	#endif
+
 	glfwSetTime(0);
 
 	int frameCount = 0;
@@ -319,6 +359,20 @@ int main()
 			std::fprintf(stderr, "%d\n", erral);
 		}
 
+		if (Global::gameState == STATE_LOADING)
+		{
+			//The level is being put together on another thread, so none of the entities
+			// can be touched. Only the title card gets drawn until it is done.
+			LevelLoader::updateLoading();
+
+			glClearColor(0, 0, 0, 1);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			GuiManager::refresh();
+			TextMaster::render();
+			updateDisplay();
+			continue;
+		}
+
 		//long double thisTime = std::time(0);
 		//std::fprintf(stdout, "time: %f time\n", thisTime);
 
@@ -558,9 +612,9 @@ int main()
 		if (Global::renderBloom)
 		{
 			Global::gameMultisampleFbo->unbindFrameBuffer();
+			//Only the scene gets resolved at full size, bloom reads the bright target itself
 			Global::gameMultisampleFbo->resolveToFbo(GL_COLOR_ATTACHMENT0, Global::gameOutputFbo);
-			Global::gameMultisampleFbo->resolveToFbo(GL_COLOR_ATTACHMENT1, Global::gameOutputFbo2);
-			PostProcessing::doPostProcessing(Global::gameOutputFbo->getColourTexture(), Global::gameOutputFbo2->getColourTexture());
+			PostProcessing::doPostProcessing(Global::gameOutputFbo->getColourTexture(), Global::gameMultisampleFbo->getColourTexture2());
 		}
 
 		Master_clearEntities();
@@ -573,8 +627,6 @@ int main()
 
 		updateDisplay();
 
-		AudioPlayer::refreshBGM();
-
 		if (Global::shouldLoadLevel)
 		{
 			Global::shouldLoadLevel = false;
@@ -590,7 +642,7 @@ int main()
 			if (finishTimerBefore < 0.0166f && Global::finishStageTimer >= 0.0166f)
 			{
 				Vector3f partVel(0, 0, 0);
-				new Particle(ParticleResources::textureWhiteFadeOutAndIn, Global::gameCamera->getFadePosition1(), &partVel, 0, 2.0f, 0, 900, 0, true, false);
+				ParticleMaster::createParticle(ParticleResources::textureWhiteFadeOutAndIn, Global::gameCamera->getFadePosition1(), &partVel, 0, 2.0f, 0, 900, 0, true, false);
 			}
 			else if (finishTimerBefore < 1.0f && Global::finishStageTimer >= 1.0f)
 			{
@@ -600,7 +652,7 @@ int main()
 			else if (finishTimerBefore < 8.166f && Global::finishStageTimer >= 8.166f)
 			{
 				Vector3f partVel(0, 0, 0);
-				new Particle(ParticleResources::textureBlackFadeOutAndIn, Global::gameCamera->getFadePosition1(), &partVel, 0, 2.0f, 0, 900, 0, true, false);
+				ParticleMaster::createParticle(ParticleResources::textureBlackFadeOutAndIn, Global::gameCamera->getFadePosition1(), &partVel, 0, 2.0f, 0, 900, 0, true, false);
 
 				//AudioPlayer::play(25, Global::gamePlayer->getPosition());
 			}
@@ -699,10 +751,18 @@ int main()
 
 	Global::saveSaveData();
 
+	//A level that is still loading has to finish before anything gets cleaned up
+	while (!BackgroundLoader::update(1000.0))
+	{
+
+	}
+
 	#ifdef DEV_MODE
 	listenThread.detach();
 	#endif
 
+	ParticleMaster::cleanUp();
+	ResourceManager::cleanUp();
 	Master_cleanUp();
 	Loader::cleanUp();
 	TextMaster::cleanUp();
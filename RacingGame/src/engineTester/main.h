@@ -39,6 +39,7 @@ void Main_deleteAllTransparentEntites();
 #define STATE_CUTSCENE 3
 #define STATE_TITLE 4
 #define STATE_DEBUG 5
+#define STATE_LOADING 6
 
 #define LVL_DRAGON_ROAD      0
 #define LVL_THUNDER_ROAD     1
@@ -88,7 +89,6 @@ public:
 	static float finishStageTimer;
 	static Fbo* gameMultisampleFbo;
 	static Fbo* gameOutputFbo;
-	static Fbo* gameOutputFbo2;
 	static float deathHeight;
 	static int gameMissionNumber;
 	static bool gameIsNormalMode;
@@ -135,9 +135,12 @@ public:
 
 	static bool renderBloom;
 
+	static bool renderTransparencyOIT;
+
 	static bool renderShadowsFar;
 	static bool renderShadowsClose;
 	static int shadowsFarQuality;
+	static int shadowCascades;
 
 	static bool unlockedSonicDoll;
 	static bool unlockedMechaSonic;
@@ -13,8 +13,9 @@
 #include "../entities/camera.h"
 #include "../audio/audioplayer.h"
 #include "../particles/particleresources.h"
-#include "../particles/particle.h"
+#include "../particles/particlemaster.h"
 #include "../collision/collisionchecker.h"
+#include "../toolbox/resourcemanager.h"
 
 #include <list>
 #include <iostream>
@@ -141,8 +142,8 @@ void Boostpad::loadStaticModels()
 	std::fprintf(stdout, "Loading Boostpad static models...\n");
 	#endif
 
-	loadModel(&Boostpad::modelsPad,  "res/Models/Misc/Boostpad/", "Pad");
-	loadModel(&Boostpad::modelsBolt, "res/Models/Misc/Boostpad/", "Bolt");
+	ResourceManager::loadModel(&Boostpad::modelsPad,  "res/Models/Misc/Boostpad/", "Pad");
+	ResourceManager::loadModel(&Boostpad::modelsBolt, "res/Models/Misc/Boostpad/", "Bolt");
 
 	if (Boostpad::cmOriginal == nullptr)
 	{
@@ -156,7 +157,7 @@ void Boostpad::deleteStaticModels()
 	std::fprintf(stdout, "Deleting Boostpad static models...\n");
 	#endif
 
-	Entity::deleteModels(&Boostpad::modelsPad);
-	Entity::deleteModels(&Boostpad::modelsBolt);
+	ResourceManager::releaseModels(&Boostpad::modelsPad);
+	ResourceManager::releaseModels(&Boostpad::modelsBolt);
 	//Entity::deleteCollisionModel(&Boostpad::cmOriginal);
 }
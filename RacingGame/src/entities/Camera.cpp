@@ -6,7 +6,7 @@
 #include "../toolbox/input.h"
 #include "../toolbox/maths.h"
 #include "../particles/particleresources.h"
-#include "../particles/particle.h"
+#include "../particles/particlemaster.h"
 
 #include <cmath>
 
@@ -44,7 +44,7 @@ void Camera::refresh()
 	//if (position.y < 0)
 	//{
 	//	Vector3f partVel(0, 0, 0);
-	//	new Particle(ParticleResources::textureInWater, &fadePosition1, &partVel, 0, 10, 0, 400, 0, true);
+	//	ParticleMaster::createParticle(ParticleResources::textureInWater, &fadePosition1, &partVel, 0, 10, 0, 400, 0, true);
 	//}
 
 	Vector3f off;
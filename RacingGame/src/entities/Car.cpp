@@ -12,7 +12,7 @@
 #include "../collision/triangle3d.h"
 #include "../toolbox/maths.h"
 #include "../audio/audioplayer.h"
-#include "../particles/particle.h"
+#include "../particles/particlemaster.h"
 #include "../particles/particleresources.h"
 #include "../toolbox/input.h"
 #include "../fontMeshCreator/guinumber.h"
@@ -20,6 +20,7 @@
 #include "../audio/source.h"
 #include "checkpoint.h"
 #include "../guis/guimanager.h"
+#include "../toolbox/resourcemanager.h"
 
 #include <list>
 #include <iostream>
@@ -1208,7 +1209,7 @@ void Car::createEngineParticles(Vector3f* initPos, Vector3f* endPos, float initi
 
 		float newScale = ((count-i)/((float)count));
 
-		new Particle(textureIndex, &offset, 1.0f, initialScale*newScale, true);
+		ParticleMaster::createParticle(textureIndex, &offset, 1.0f, initialScale*newScale, true);
 	}
 }
 
@@ -1326,7 +1327,7 @@ void Car::explode()
 
 		Vector3f vel2(0, 0, 0);
 
-		new Particle(ParticleResources::textureExplosion1, &pos, &vel2,
+		ParticleMaster::createParticle(ParticleResources::textureExplosion1, &pos, &vel2,
 			0, 1.5f, 0, 0.5f * Maths::random() + 1.0f, 0, false, false);
 	}
 
@@ -1337,7 +1338,7 @@ void Car::explode()
 
 	Vector3f vel2(0, 0, 0);
 	
-	new Particle(ParticleResources::textureExplosion2, &pos, &vel2,
+	ParticleMaster::createParticle(ParticleResources::textureExplosion2, &pos, &vel2,
 		0, 2.0f, 0, 3.0f, 0, false, false);
 }
 
@@ -1571,7 +1572,7 @@ void Car::loadVehicleInfo()
 		case 2: modelFolder = "res/Models/Machines/SonicPhantom/"; modelName = "SonicPhantom"; break;
 		default: break;
 	}
-	loadModel(&Car::models[vehicleID], modelFolder, modelName);
+	ResourceManager::loadModel(&Car::models[vehicleID], modelFolder, modelName);
 }
 
 void Car::deleteStaticModels()
@@ -1585,7 +1586,7 @@ void Car::deleteStaticModels()
 		std::list<TexturedModel*>* e = &Car::models[i];
 		if (e->size() > 0)
 		{
-			Entity::deleteModels(e);
+			ResourceManager::releaseModels(e);
 		}
 	}
 }
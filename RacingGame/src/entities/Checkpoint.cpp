@@ -5,6 +5,7 @@
 #include "../models/models.h"
 #include "../renderEngine/renderEngine.h"
 #include "../objLoader/objLoader.h"
+#include "../toolbox/resourcemanager.h"
 #include "../toolbox/maths.h"
 
 #include <algorithm>
@@ -82,7 +83,7 @@ void Checkpoint::loadStaticModels()
 	std::fprintf(stdout, "Loading Checkpoint static models...\n");
 	#endif
 
-	loadModel(&Checkpoint::models, "res/Models/Misc/Box/", "Box");
+	ResourceManager::loadModel(&Checkpoint::models, "res/Models/Misc/Box/", "Box");
 }
 
 void Checkpoint::deleteStaticModels()
@@ -91,5 +92,5 @@ void Checkpoint::deleteStaticModels()
 	std::fprintf(stdout, "Deleting Checkpoint static models...\n");
 	#endif
 
-	Entity::deleteModels(&Checkpoint::models);
+	ResourceManager::releaseModels(&Checkpoint::models);
 }
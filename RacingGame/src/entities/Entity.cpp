@@ -69,6 +69,11 @@ bool Entity::isEnemy()
 	return false;
 }
 
+bool Entity::isStageTransparent()
+{
+	return false;
+}
+
 void Entity::die()
 {
 	
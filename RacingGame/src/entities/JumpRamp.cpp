@@ -12,8 +12,9 @@
 #include "../entities/camera.h"
 #include "../audio/audioplayer.h"
 #include "../particles/particleresources.h"
-#include "../particles/particle.h"
+#include "../particles/particlemaster.h"
 #include "../collision/collisionchecker.h"
+#include "../toolbox/resourcemanager.h"
 
 #include <list>
 #include <iostream>
@@ -107,7 +108,7 @@ void JumpRamp::loadStaticModels()
 	std::fprintf(stdout, "Loading JumpRamp static models...\n");
 	#endif
 
-	loadModel(&JumpRamp::models,  "res/Models/Misc/JumpRamp/", "JumpRamp");
+	ResourceManager::loadModel(&JumpRamp::models,  "res/Models/Misc/JumpRamp/", "JumpRamp");
 }
 
 void JumpRamp::deleteStaticModels()
@@ -116,5 +117,5 @@ void JumpRamp::deleteStaticModels()
 	std::fprintf(stdout, "Deleting JumpRamp static models...\n");
 	#endif
 
-	Entity::deleteModels(&JumpRamp::models);
+	ResourceManager::releaseModels(&JumpRamp::models);
 }
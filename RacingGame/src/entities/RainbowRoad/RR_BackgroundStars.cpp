@@ -10,6 +10,7 @@
 #include "../../objLoader/objLoader.h"
 #include "../car.h"
 #include "../dummy.h"
+#include "../../toolbox/resourcemanager.h"
 
 #include <list>
 #include <iostream>
@@ -58,8 +59,8 @@ void RR_BackgroundStars::loadModels()
 	std::fprintf(stdout, "Loading RR_BackgroundStars models...\n");
 	#endif
 
-	loadModel(&RR_BackgroundStars::modelsPass1,  "res/Models/Tracks/RainbowRoadDS/SkySphere/", "Pass2");
-	loadModel(&RR_BackgroundStars::modelsPass2,  "res/Models/Tracks/RainbowRoadDS/SkySphere/", "Pass3");
+	ResourceManager::loadModel(&RR_BackgroundStars::modelsPass1,  "res/Models/Tracks/RainbowRoadDS/SkySphere/", "Pass2");
+	ResourceManager::loadModel(&RR_BackgroundStars::modelsPass2,  "res/Models/Tracks/RainbowRoadDS/SkySphere/", "Pass3");
 }
 
 void RR_BackgroundStars::deleteModels()
@@ -68,6 +69,6 @@ void RR_BackgroundStars::deleteModels()
 	std::fprintf(stdout, "Deleting RR_BackgroundStars models...\n");
 	#endif
 
-	Entity::deleteModels(&RR_BackgroundStars::modelsPass1);
-	Entity::deleteModels(&RR_BackgroundStars::modelsPass2);
+	ResourceManager::releaseModels(&RR_BackgroundStars::modelsPass1);
+	ResourceManager::releaseModels(&RR_BackgroundStars::modelsPass2);
 }
\ No newline at end of file
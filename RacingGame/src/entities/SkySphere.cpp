@@ -9,6 +9,7 @@
 #include "../objLoader/objLoader.h"
 #include "../engineTester/main.h"
 #include "../renderEngine/skymanager.h"
+#include "../toolbox/resourcemanager.h"
 
 #include <list>
 #include <iostream>
@@ -73,10 +74,7 @@ void SkySphere::loadModels(char* folder, char* objname, char* mtlname)
 	std::string mtlfilename = mtlname;
 	mtlfilename = mtlfilename + ".mtl";
 
-	if (loadBinaryModelWithMTL(&SkySphere::models, path.c_str(), objfilename.c_str(), mtlfilename.c_str()) != 0)
-	{
-		loadObjModelWithMTL(&SkySphere::models, path.c_str(), objfilename.c_str(), mtlfilename.c_str());
-	}
+	ResourceManager::loadModelWithMTL(&SkySphere::models, path, objfilename, mtlfilename);
 }
 
 void SkySphere::deleteModels()
@@ -85,5 +83,5 @@ void SkySphere::deleteModels()
 	std::fprintf(stdout, "Deleting sky sphere models...\n");
 	#endif
 
-	Entity::deleteModels(&SkySphere::models);
+	ResourceManager::releaseModels(&SkySphere::models);
 }
\ No newline at end of file
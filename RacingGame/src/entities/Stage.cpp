@@ -8,6 +8,7 @@
 #include "../renderEngine/renderEngine.h"
 #include "../objLoader/objLoader.h"
 #include "../engineTester/main.h"
+#include "../toolbox/resourcemanager.h"
 
 #include <list>
 #include <iostream>
@@ -48,7 +49,9 @@ void Stage::loadModels(char* folder, char* name)
 	std::string path = "res/Models/";
 	path = (path + folder) + "/";
 
-	loadModel(&Stage::models, path, name);
+	setPackTexturesIntoArrays(true);
+	ResourceManager::loadModel(&Stage::models, path, name);
+	setPackTexturesIntoArrays(false);
 }
 
 void Stage::deleteModels()
@@ -57,7 +60,7 @@ void Stage::deleteModels()
 	std::fprintf(stdout, "Deleting stage models...\n");
 	#endif
 
-	Entity::deleteModels(&Stage::models);
+	ResourceManager::releaseModels(&Stage::models);
 }
 
 std::string Stage::getName()
@@ -6,6 +6,7 @@
 #include "stagepass2.h"
 #include "../renderEngine/renderEngine.h"
 #include "../engineTester/main.h"
+#include "../toolbox/resourcemanager.h"
 
 #include <list>
 
@@ -33,7 +34,9 @@ StagePass2::StagePass2(const char* objFolder, const char* objFilename)
 		std::fprintf(stdout, "Loading StagePass2 static models...\n");
 		#endif
 
-		loadModel(&StagePass2::models, objFolder, objFilename);
+		setPackTexturesIntoArrays(true);
+		ResourceManager::loadModel(&StagePass2::models, objFolder, objFilename);
+		setPackTexturesIntoArrays(false);
 	}
 	
 	updateTransformationMatrix();
@@ -55,5 +58,5 @@ void StagePass2::deleteStaticModels()
 	std::fprintf(stdout, "Deleting StagePass2 static models...\n");
 	#endif
 
-	Entity::deleteModels(&StagePass2::models);
+	ResourceManager::releaseModels(&StagePass2::models);
 }
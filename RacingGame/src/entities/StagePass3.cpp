@@ -6,6 +6,7 @@
 #include "stagepass3.h"
 #include "../renderEngine/renderEngine.h"
 #include "../engineTester/main.h"
+#include "../toolbox/resourcemanager.h"
 
 #include <list>
 
@@ -33,7 +34,9 @@ StagePass3::StagePass3(const char* objFolder, const char* objFilename)
 		std::fprintf(stdout, "Loading StagePass3 static models...\n");
 		#endif
 
-		loadModel(&StagePass3::models, objFolder, objFilename);
+		setPackTexturesIntoArrays(true);
+		ResourceManager::loadModel(&StagePass3::models, objFolder, objFilename);
+		setPackTexturesIntoArrays(false);
 	}
 	
 	updateTransformationMatrix();
@@ -55,5 +58,5 @@ void StagePass3::deleteStaticModels()
 	std::fprintf(stdout, "Deleting StagePass3 static models...\n");
 	#endif
 
-	Entity::deleteModels(&StagePass3::models);
+	ResourceManager::releaseModels(&StagePass3::models);
 }
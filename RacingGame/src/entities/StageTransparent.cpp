@@ -6,6 +6,7 @@
 #include "stagetransparent.h"
 #include "../renderEngine/renderEngine.h"
 #include "../engineTester/main.h"
+#include "../toolbox/resourcemanager.h"
 
 #include <list>
 
@@ -33,7 +34,9 @@ StageTransparent::StageTransparent(const char* objFolder, const char* objFilenam
 		std::fprintf(stdout, "Loading StageTransparent static models...\n");
 		#endif
 
-		loadModel(&StageTransparent::models, objFolder, objFilename);
+		setPackTexturesIntoArrays(true);
+		ResourceManager::loadModel(&StageTransparent::models, objFolder, objFilename);
+		setPackTexturesIntoArrays(false);
 	}
 	
 	updateTransformationMatrix();
@@ -49,11 +52,16 @@ std::list<TexturedModel*>* StageTransparent::getModels()
 	return &StageTransparent::models;
 }
 
+bool StageTransparent::isStageTransparent()
+{
+	return true;
+}
+
 void StageTransparent::deleteStaticModels()
 {
 	#ifdef DEV_MODE
 	std::fprintf(stdout, "Deleting StageTransparent static models...\n");
 	#endif
 
-	Entity::deleteModels(&StageTransparent::models);
+	ResourceManager::releaseModels(&StageTransparent::models);
 }
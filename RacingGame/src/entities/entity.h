@@ -38,6 +38,8 @@ public:
 
 	virtual bool isEnemy();
 
+	virtual bool isStageTransparent();
+
 	void increasePosition(float, float, float);
 
 	void increaseRotation(float, float, float);
@@ -20,6 +20,8 @@ public:
 
 	std::list<TexturedModel*>* getModels();
 
+	bool isStageTransparent();
+
 	static void deleteStaticModels();
 };
 #endif
@@ -4,15 +4,15 @@ Character::Character(int id, double xTextureCoord, double yTextureCoord, double
 	double xOffset, double yOffset, double sizeX, double sizeY, double xAdvance)
 {
 	this->id = id;
-	this->xTextureCoord = xTextureCoord;
-	this->yTextureCoord = yTextureCoord;
-	this->xOffset = xOffset;
-	this->yOffset = yOffset;
-	this->sizeX = sizeX;
-	this->sizeY = sizeY;
-	this->xMaxTextureCoord = xTexSize + xTextureCoord;
-	this->yMaxTextureCoord = yTexSize + yTextureCoord;
-	this->xAdvance = xAdvance;
+	this->xTextureCoord = (float)xTextureCoord;
+	this->yTextureCoord = (float)yTextureCoord;
+	this->xOffset = (float)xOffset;
+	this->yOffset = (float)yOffset;
+	this->sizeX = (float)sizeX;
+	this->sizeY = (float)sizeY;
+	this->xMaxTextureCoord = (float)(xTexSize + xTextureCoord);
+	this->yMaxTextureCoord = (float)(yTexSize + yTextureCoord);
+	this->xAdvance = (float)xAdvance;
 }
 
 
@@ -35,47 +35,47 @@ int Character::getId()
 	return id;
 }
 
-double Character::getxTextureCoord()
+float Character::getxTextureCoord()
 {
 	return xTextureCoord;
 }
 
-double Character::getyTextureCoord()
+float Character::getyTextureCoord()
 {
 	return yTextureCoord;
 }
 
-double Character::getXMaxTextureCoord()
+float Character::getXMaxTextureCoord()
 {
 	return xMaxTextureCoord;
 }
 
-double Character::getYMaxTextureCoord()
+float Character::getYMaxTextureCoord()
 {
 	return yMaxTextureCoord;
 }
 
-double Character::getxOffset()
+float Character::getxOffset()
 {
 	return xOffset;
 }
 
-double Character::getyOffset()
+float Character::getyOffset()
 {
 	return yOffset;
 }
 
-double Character::getSizeX()
+float Character::getSizeX()
 {
 	return sizeX;
 }
 
-double Character::getSizeY()
+float Character::getSizeY()
 {
 	return sizeY;
 }
 
-double Character::getxAdvance()
+float Character::getxAdvance()
 {
 	return xAdvance;
 }
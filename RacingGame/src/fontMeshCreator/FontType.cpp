@@ -2,7 +2,6 @@
 
 #include "fonttype.h"
 #include "textmeshcreator.h"
-#include "textmeshdata.h"
 
 #include "../renderEngine/renderEngine.h"
 
@@ -26,7 +25,12 @@ void FontType::deleteMe()
 	textureAtlas = -1;
 }
 
-TextMeshData* FontType::loadText(GUIText* text)
+void FontType::loadText(GUIText* text, std::vector<float>* vertices)
 {
-	return loader->createTextMesh(text);
+	loader->createTextMesh(text, vertices);
+}
+
+void FontType::layoutText(GUIText* text, std::vector<float>* vertices)
+{
+	loader->layoutText(text, vertices);
 }
\ No newline at end of file
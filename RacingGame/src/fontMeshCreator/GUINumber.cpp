@@ -2,14 +2,13 @@
 #include "../engineTester/main.h"
 #include "../renderEngine/renderEngine.h"
 #include "../fontRendering/textmaster.h"
-#include "textmeshdata.h"
 #include "fonttype.h"
 #include "../toolbox/pausescreen.h"
 #include "../toolbox/maths.h"
+#include "../toolbox/resourcemanager.h"
 
 FontType* GUINumber::numberFont = nullptr;
-GLuint    GUINumber::numberMeshIDs[10];
-GLuint    GUINumber::numberMeshVertexCounts[10];
+float     GUINumber::numberMeshVertices[10][24];
 
 const float GUINumber::fontHeight = 0.06f; //height of the text, 1.0 being the entire screen height
 float GUINumber::distanceBetweenCharacters = 0.0f; //Something that should only be read from. Changing this does not actually change the displayed text
@@ -56,14 +55,18 @@ void GUINumber::createNumber(int i, float x, float y, float w, float h)
 	texCoords.push_back(x+w);  //bottom right
 	texCoords.push_back(y+h);
 
-	std::vector<int> vertexObjects = Loader::loadToVAO(&positions, &texCoords);
-	GUINumber::numberMeshIDs[i] = (GLuint)vertexObjects[0];
-	GUINumber::numberMeshVertexCounts[i] = 6;
+	for (int v = 0; v < 6; v++)
+	{
+		GUINumber::numberMeshVertices[i][v*4    ] = positions[v*2];
+		GUINumber::numberMeshVertices[i][v*4 + 1] = positions[v*2 + 1];
+		GUINumber::numberMeshVertices[i][v*4 + 2] = texCoords[v*2];
+		GUINumber::numberMeshVertices[i][v*4 + 3] = texCoords[v*2 + 1];
+	}
 }
 
 void GUINumber::loadMeshData()
 {
-	GUINumber::numberFont = new FontType(Loader::loadTexture("res/Fonts/vipnagorgialla.png"), "res/Fonts/vipnagorgialla.fnt"); INCR_NEW
+	GUINumber::numberFont = new FontType(ResourceManager::loadTexture("res/Fonts/vipnagorgialla.png"), "res/Fonts/vipnagorgialla.fnt"); INCR_NEW
 
 	const float ts = 512; //size of the image used as the font atlas
 
@@ -94,8 +97,7 @@ GUINumber::GUINumber(int number, float x, float y, int alignment, bool visible)
 //must be called every time you want to change the number, or its position, or anything else
 void GUINumber::refresh()
 {
-	meshIDs.clear();
-	meshVertexCounts.clear();
+	meshDigits.clear();
 	meshPositions.clear();
 
 	int numChars = Maths::numDigits(displayNumber);
@@ -107,9 +109,8 @@ void GUINumber::refresh()
 		case 0:
 			for (int i = 0; i < numChars; i++)
 			{
-				meshIDs.push_back         (GUINumber::numberMeshIDs[currentNumber % 10]);
-				meshVertexCounts.push_back(GUINumber::numberMeshVertexCounts[currentNumber % 10]);
-				meshPositions.push_back   (Vector2f(basePosition.x - i*distanceBetweenCharacters - distanceBetweenCharacters/2, basePosition.y + GUINumber::fontHeight/2));
+				meshDigits.push_back   (currentNumber % 10);
+				meshPositions.push_back(Vector2f(basePosition.x - i*distanceBetweenCharacters - distanceBetweenCharacters/2, basePosition.y + GUINumber::fontHeight/2));
 				currentNumber = currentNumber/10;
 			}
 			break;
@@ -117,9 +118,8 @@ void GUINumber::refresh()
 		case 1:
 			for (int i = 0; i < numChars; i++)
 			{
-				meshIDs.push_back         (GUINumber::numberMeshIDs[currentNumber % 10]);
-				meshVertexCounts.push_back(GUINumber::numberMeshVertexCounts[currentNumber % 10]);
-				meshPositions.push_back   (Vector2f(basePosition.x - i*distanceBetweenCharacters + numChars*distanceBetweenCharacters/2 - distanceBetweenCharacters/2, basePosition.y + GUINumber::fontHeight/2));
+				meshDigits.push_back   (currentNumber % 10);
+				meshPositions.push_back(Vector2f(basePosition.x - i*distanceBetweenCharacters + numChars*distanceBetweenCharacters/2 - distanceBetweenCharacters/2, basePosition.y + GUINumber::fontHeight/2));
 				currentNumber = currentNumber/10;
 			}
 			break;
@@ -127,9 +127,8 @@ void GUINumber::refresh()
 		default:
 			for (int i = 0; i < numChars; i++)
 			{
-				meshIDs.push_back         (GUINumber::numberMeshIDs[currentNumber % 10]);
-				meshVertexCounts.push_back(GUINumber::numberMeshVertexCounts[currentNumber % 10]);
-				meshPositions.push_back   (Vector2f(basePosition.x - i*distanceBetweenCharacters + numChars*distanceBetweenCharacters - distanceBetweenCharacters/2, basePosition.y + GUINumber::fontHeight/2));
+				meshDigits.push_back   (currentNumber % 10);
+				meshPositions.push_back(Vector2f(basePosition.x - i*distanceBetweenCharacters + numChars*distanceBetweenCharacters - distanceBetweenCharacters/2, basePosition.y + GUINumber::fontHeight/2));
 				currentNumber = currentNumber/10;
 			}
 			break;
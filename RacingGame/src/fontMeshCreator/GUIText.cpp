@@ -1,5 +1,5 @@
 #include "guitext.h"
-#include "../renderEngine/renderEngine.h"
+#include "fonttype.h"
 #include "../fontRendering/textmaster.h"
 
 GUIText::GUIText(std::string text, float fontSize, FontType* font, float x, float y, float maxLineLength,
@@ -14,17 +14,29 @@ GUIText::GUIText(std::string text, float fontSize, FontType* font, float x, floa
 	this->centerText = centered;
 	this->rightAlign = rightAligned;
 	this->visible = visible;
+	updateMesh();
 	TextMaster::loadText(this);
 }
 
 void GUIText::deleteMe()
 {
 	TextMaster::removeText(this);
-	for (int vboID : textMeshVbos)
+}
+
+void GUIText::setText(std::string newText)
+{
+	if (textString == newText)
 	{
-		Loader::deleteVBO(vboID);
+		return;
 	}
-	Loader::deleteVAO(textMeshVao);
+
+	textString.assign(newText);
+	updateMesh();
+}
+
+void GUIText::updateMesh()
+{
+	font->loadText(this, &vertices);
 }
 
 FontType* GUIText::getFont()
@@ -67,24 +79,14 @@ bool GUIText::isVisible()
 	return visible;
 }
 
-int GUIText::getMesh()
-{
-	return textMeshVao;
-}
-
-void GUIText::setMeshInfo(int vao, std::vector<int>* vbos, int verticesCount)
+std::vector<float>* GUIText::getVertices()
 {
-	this->textMeshVao = vao;
-	for (int vbo : (*vbos))
-	{
-		this->textMeshVbos.push_back(vbo);
-	}
-	this->vertexCount = verticesCount;
+	return &vertices;
 }
 
 int GUIText::getVertexCount()
 {
-	return vertexCount;
+	return (int)(vertices.size()/4);
 }
 
 float GUIText::getFontSize()
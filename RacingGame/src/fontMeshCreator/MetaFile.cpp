@@ -28,9 +28,14 @@ double MetaFile::getSpaceWidth()
 	return spaceWidth;
 }
 
-Character MetaFile::getCharacter(int ascii)
+Character* MetaFile::getCharacter(char c)
 {
-	return metaData[ascii];
+	//Negative chars are the bytes past ascii, the empty character at 0 stands in for them
+	if (c < 0)
+	{
+		return &glyphs[0];
+	}
+	return &glyphs[(int)c];
 }
 
 bool MetaFile::processNextLine()
@@ -146,7 +151,10 @@ void MetaFile::loadCharacterData(int imageWidth)
 		Character* c = loadCharacter(imageWidth);
 		if (c != nullptr)
 		{
-			metaData[c->getId()] = (*c); //Put a copy of the character into the hash map
+			if (c->getId() > 0 && c->getId() < 128)
+			{
+				glyphs[c->getId()] = (*c);
+			}
 			delete c;
 			INCR_DEL
 		}
@@ -1,10 +1,11 @@
 #include "textmeshcreator.h"
 #include "metafile.h"
-#include "textmeshdata.h"
 #include "guitext.h"
 
 #include "../engineTester/main.h"
 
+#include <iterator>
+
 
 double TextMeshCreator::LINE_HEIGHT = 0.03;
 
@@ -13,145 +14,194 @@ TextMeshCreator::TextMeshCreator(std::string metaFilename)
 {
 	metaData = new MetaFile(metaFilename);
 	INCR_NEW
+	glyphCount = 0;
+}
+
+void TextMeshCreator::createTextMesh(GUIText* text, std::vector<float>* vertices)
+{
+	createCacheKey(text);
+
+	auto found = cacheLookup.find(cacheKey);
+	if (found != cacheLookup.end())
+	{
+		std::list<CachedTextLayout>::iterator entry = found->second;
+		cache.splice(cache.begin(), cache, entry);
+		vertices->assign(entry->vertices.begin(), entry->vertices.end());
+		text->setNumberOfLines(entry->numberOfLines);
+		return;
+	}
+
+	layoutText(text, vertices);
+
+	//Reuse the least recently used layout's memory once the cache is full
+	if ((int)cache.size() >= CACHE_CAPACITY)
+	{
+		cacheLookup.erase(cache.back().key);
+		cache.splice(cache.begin(), cache, std::prev(cache.end()));
+	}
+	else
+	{
+		cache.emplace_front();
+	}
+
+	CachedTextLayout* layout = &cache.front();
+	layout->key.assign(cacheKey);
+	layout->vertices.assign(vertices->begin(), vertices->end());
+	layout->numberOfLines = text->getNumberOfLines();
+	cacheLookup[layout->key] = cache.begin();
 }
 
-TextMeshData* TextMeshCreator::createTextMesh(GUIText* text)
+void TextMeshCreator::layoutText(GUIText* text, std::vector<float>* vertices)
 {
-	std::vector<Line> lines = createStructure(text);
-	TextMeshData* data = createQuadVertices(text, &lines);
-	return data;
+	createStructure(text);
+	createQuadVertices(text, vertices);
 }
 
-std::vector<Line> TextMeshCreator::createStructure(GUIText* text)
+void TextMeshCreator::clearCache()
 {
+	cacheLookup.clear();
+	cache.clear();
+}
+
+void TextMeshCreator::createCacheKey(GUIText* text)
+{
+	float fontSize = text->getFontSize();
+	float maxLength = text->getMaxLineSize();
+	char alignment = text->isCentered() ? 'c' : (text->isRightAligned() ? 'r' : 'l');
+
+	cacheKey.assign(*text->getTextString());
+	cacheKey.push_back('\0');
+	cacheKey.append((const char*)&fontSize, sizeof(float));
+	cacheKey.append((const char*)&maxLength, sizeof(float));
+	cacheKey.push_back(alignment);
+}
+
+void TextMeshCreator::createStructure(GUIText* text)
+{
+	words.clear();
+	lines.clear();
+	glyphCount = 0;
+
 	const char* chars = text->getTextString()->c_str();
 	int charsLength = (int)(text->getTextString()->size());
-	std::vector<Line> lines;
-	Line currentLine(metaData->getSpaceWidth(), text->getFontSize(), text->getMaxLineSize());
-	Word currentWord(text->getFontSize());
+	float fontSize = text->getFontSize();
+	float spaceSize = (float)metaData->getSpaceWidth()*fontSize;
+	float maxLength = text->getMaxLineSize();
+
+	TextLayoutLine currentLine;
+	currentLine.firstWord = 0;
+	currentLine.wordCount = 0;
+	currentLine.length = 0;
+
+	int wordStart = 0;
+	float wordWidth = 0;
 	for (int i = 0; i < charsLength; i++)
 	{
-		int ascii = (int)chars[i];
-		if (ascii == SPACE_ASCII)
+		if ((int)chars[i] == SPACE_ASCII)
 		{
-			bool added = currentLine.attemptToAddWord(&currentWord);
-			if (!added)
-			{
-				lines.push_back(currentLine);
-				currentLine = Line(metaData->getSpaceWidth(), text->getFontSize(), text->getMaxLineSize());
-				currentLine.attemptToAddWord(&currentWord);
-			}
-			currentWord = Word(text->getFontSize());
+			addWord(&currentLine, wordStart, i, wordWidth, spaceSize, maxLength);
+			wordStart = i + 1;
+			wordWidth = 0;
 			continue;
 		}
-		Character character = metaData->getCharacter(ascii);
-		currentWord.addCharacter(&character);
+		wordWidth += metaData->getCharacter(chars[i])->getxAdvance()*fontSize;
 	}
-	//completeStructure(lines, currentLine, currentWord, text);
+	addWord(&currentLine, wordStart, charsLength, wordWidth, spaceSize, maxLength);
 
-	bool added = currentLine.attemptToAddWord(&currentWord);
-	if (!added)
+	lines.push_back(currentLine);
+}
+
+void TextMeshCreator::addWord(TextLayoutLine* line, int start, int end, float width, float spaceSize, float maxLength)
+{
+	float additionalLength = width;
+	additionalLength += (line->wordCount > 0) ? spaceSize : 0;
+	if (line->length + additionalLength > maxLength)
 	{
-		lines.push_back(currentLine);
-		currentLine = Line(metaData->getSpaceWidth(), text->getFontSize(), text->getMaxLineSize());
-		currentLine.attemptToAddWord(&currentWord);
+		lines.push_back(*line);
+		line->firstWord = (int)words.size();
+		line->wordCount = 0;
+		line->length = 0;
+
+		additionalLength = width;
+		if (additionalLength > maxLength)
+		{
+			return;
+		}
 	}
-	lines.push_back(currentLine);
 
+	TextLayoutWord word;
+	word.start = start;
+	word.end = end;
+	word.width = width;
+	words.push_back(word);
 
-	return lines;
+	line->wordCount++;
+	line->length += additionalLength;
+	glyphCount += end - start;
 }
-/*
-void TextMeshCreator::completeStructure(std::vector<Line> lines, Line currentLine, Word currentWord, GUIText* text)
+
+void TextMeshCreator::createQuadVertices(GUIText* text, std::vector<float>* vertices)
 {
-	bool added = currentLine.attemptToAddWord(currentWord);
-	if (!added)
+	text->setNumberOfLines((int)(lines.size()));
+
+	vertices->resize(glyphCount*24);
+	if (glyphCount == 0)
 	{
-		lines.add(currentLine);
-		currentLine = Line(metaData->getSpaceWidth(), text.getFontSize(), text.getMaxLineSize());
-		currentLine.attemptToAddWord(currentWord);
+		return;
 	}
-	lines.add(currentLine);
-}
-*/
 
-TextMeshData* TextMeshCreator::createQuadVertices(GUIText* text, std::vector<Line>* lines)
-{
-	text->setNumberOfLines((int)(lines->size()));
-	double curserX = 0.0;
-	double curserY = 0.0;
-	std::vector<float> vertices;
-	std::vector<float> textureCoords;
-	for (Line line : (*lines))
+	const char* chars = text->getTextString()->c_str();
+	float fontSize = text->getFontSize();
+	float spaceSize = (float)metaData->getSpaceWidth()*fontSize;
+	float lineHeight = (float)LINE_HEIGHT*fontSize;
+
+	float* out = &(*vertices)[0];
+	float curserY = 0.0f;
+	for (TextLayoutLine& line : lines)
 	{
+		float curserX = 0.0f;
 		if (text->isCentered())
 		{
-			curserX = (line.getMaxLength() - line.getLineLength()) / 2;
+			curserX = (text->getMaxLineSize() - line.length)/2;
 		}
 		else if (text->isRightAligned())
 		{
-			curserX = (line.getMaxLength() - line.getLineLength());
+			curserX = (text->getMaxLineSize() - line.length);
 		}
-		for (Word word : (*line.getWords()))
+
+		for (int w = line.firstWord; w < line.firstWord + line.wordCount; w++)
 		{
-			for (Character letter : (*word.getCharacters()))
+			TextLayoutWord* word = &words[w];
+			for (int i = word->start; i < word->end; i++)
 			{
-				addVerticesForCharacter(curserX, curserY, letter, text->getFontSize(), &vertices);
-				addTexCoords(&textureCoords, letter.getxTextureCoord(), letter.getyTextureCoord(),
-					letter.getXMaxTextureCoord(), letter.getYMaxTextureCoord());
-				curserX += letter.getxAdvance() * text->getFontSize();
-			}
-			curserX += metaData->getSpaceWidth() * text->getFontSize();
-		}
-		curserX = 0;
-		curserY += LINE_HEIGHT * text->getFontSize();
-	}
-	INCR_NEW
-	return new TextMeshData(&vertices, &textureCoords);
-}
+				Character* letter = metaData->getCharacter(chars[i]);
 
-void TextMeshCreator::addVerticesForCharacter(double curserX, double curserY, Character character, double fontSize,
-	std::vector<float>* vertices)
-{
-	double x = curserX + (character.getxOffset() * fontSize);
-	double y = curserY + (character.getyOffset() * fontSize);
-	double maxX = x + (character.getSizeX() * fontSize);
-	double maxY = y + (character.getSizeY() * fontSize);
-	double properX = (2 * x) - 1;
-	double properY = (-2 * y) + 1;
-	double properMaxX = (2 * maxX) - 1;
-	double properMaxY = (-2 * maxY) + 1;
-	addVertices(vertices, properX, properY, properMaxX, properMaxY);
-}
+				//Screen space goes from (0, 0) at the top left to (1, 1) at the bottom right,
+				// the vertices are in -1 to 1 going up
+				float x    = curserX + letter->getxOffset()*fontSize;
+				float y    = curserY + letter->getyOffset()*fontSize;
+				float maxX =  2*(x + letter->getSizeX()*fontSize) - 1;
+				float maxY = -2*(y + letter->getSizeY()*fontSize) + 1;
+				x =  2*x - 1;
+				y = -2*y + 1;
 
-void TextMeshCreator::addVertices(std::vector<float>* vertices, double x, double y, double maxX, double maxY)
-{
-	vertices->push_back((float)x);
-	vertices->push_back((float)y);
-	vertices->push_back((float)x);
-	vertices->push_back((float)maxY);
-	vertices->push_back((float)maxX);
-	vertices->push_back((float)maxY);
-	vertices->push_back((float)maxX);
-	vertices->push_back((float)maxY);
-	vertices->push_back((float)maxX);
-	vertices->push_back((float)y);
-	vertices->push_back((float)x);
-	vertices->push_back((float)y);
-}
+				float u    = letter->getxTextureCoord();
+				float v    = letter->getyTextureCoord();
+				float maxU = letter->getXMaxTextureCoord();
+				float maxV = letter->getYMaxTextureCoord();
 
-void TextMeshCreator::addTexCoords(std::vector<float>* texCoords, double x, double y, double maxX, double maxY)
-{
-	texCoords->push_back((float)x);
-	texCoords->push_back((float)y);
-	texCoords->push_back((float)x);
-	texCoords->push_back((float)maxY);
-	texCoords->push_back((float)maxX);
-	texCoords->push_back((float)maxY);
-	texCoords->push_back((float)maxX);
-	texCoords->push_back((float)maxY);
-	texCoords->push_back((float)maxX);
-	texCoords->push_back((float)y);
-	texCoords->push_back((float)x);
-	texCoords->push_back((float)y);
+				out[ 0] = x;    out[ 1] = y;    out[ 2] = u;    out[ 3] = v;
+				out[ 4] = x;    out[ 5] = maxY; out[ 6] = u;    out[ 7] = maxV;
+				out[ 8] = maxX; out[ 9] = maxY; out[10] = maxU; out[11] = maxV;
+				out[12] = maxX; out[13] = maxY; out[14] = maxU; out[15] = maxV;
+				out[16] = maxX; out[17] = y;    out[18] = maxU; out[19] = v;
+				out[20] = x;    out[21] = y;    out[22] = u;    out[23] = v;
+				out += 24;
+
+				curserX += letter->getxAdvance()*fontSize;
+			}
+			curserX += spaceSize;
+		}
+		curserY += lineHeight;
+	}
 }
\ No newline at end of file
@@ -12,15 +12,15 @@ class Character
 {
 private:
 	int id;
-	double xTextureCoord;
-	double yTextureCoord;
-	double xMaxTextureCoord;
-	double yMaxTextureCoord;
-	double xOffset;
-	double yOffset;
-	double sizeX;
-	double sizeY;
-	double xAdvance;
+	float xTextureCoord;
+	float yTextureCoord;
+	float xMaxTextureCoord;
+	float yMaxTextureCoord;
+	float xOffset;
+	float yOffset;
+	float sizeX;
+	float sizeY;
+	float xAdvance;
 
 public:
 	/**
@@ -57,23 +57,23 @@ public:
 
 	int getId();
 
-	double getxTextureCoord();
+	float getxTextureCoord();
 
-	double getyTextureCoord();
+	float getyTextureCoord();
 
-	double getXMaxTextureCoord();
+	float getXMaxTextureCoord();
 
-	double getYMaxTextureCoord();
+	float getYMaxTextureCoord();
 
-	double getxOffset();
+	float getxOffset();
 
-	double getyOffset();
+	float getyOffset();
 
-	double getSizeX();
+	float getSizeX();
 
-	double getSizeY();
+	float getSizeY();
 
-	double getxAdvance();
+	float getxAdvance();
 };
 
 #endif
\ No newline at end of file
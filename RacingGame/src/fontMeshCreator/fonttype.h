@@ -3,9 +3,9 @@
 
 class GUIText;
 class TextMeshCreator;
-class TextMeshData;
 
 #include <string>
+#include <vector>
 
 
 /**
@@ -45,12 +45,20 @@ public:
 	* Takes in an unloaded text and calculate all of the vertices for the quads
 	* on which this text will be rendered. The vertex positions and texture
 	* coords and calculated based on the information from the font file.
+	* Recently used layouts are remembered, so loading the same text again is
+	* just a copy.
 	*
 	* @param text
 	*            - the unloaded text.
-	* @return Information about the vertices of all the quads.
+	* @param vertices
+	*            - gets the position and texture coords of every vertex.
 	*/
-	TextMeshData* loadText(GUIText* text);
+	void loadText(GUIText* text, std::vector<float>* vertices);
+
+	/**
+	* Same as loadText, but always lays the text out from scratch.
+	*/
+	void layoutText(GUIText* text, std::vector<float>* vertices);
 };
 
 #endif
\ No newline at end of file
@@ -13,8 +13,8 @@ class GUINumber
 {
 public:
 	static FontType* numberFont;
-	static GLuint numberMeshIDs[10];
-	static GLuint numberMeshVertexCounts[10];
+	//The 6 vertices of the quad of each digit, as x, y, u, v, relative to the center of the digit
+	static float numberMeshVertices[10][24];
 
 	static void loadMeshData();
 	static void createNumber(int i, float x, float y, float w, float h);
@@ -30,8 +30,7 @@ public:
 	int alignment; //0 = left, 1 = center, 2 = right
 	bool visible;
 
-	std::vector<GLuint>   meshIDs;
-	std::vector<GLsizei>  meshVertexCounts;
+	std::vector<int>      meshDigits;
 	std::vector<Vector2f> meshPositions;
 	
 
@@ -20,9 +20,9 @@ private:
 	std::string textString;
 	float fontSize;
 
-	int textMeshVao;
-	std::vector<int> textMeshVbos;
-	int vertexCount;
+	//Position and texture coords of every vertex of the text's quads,
+	// relative to the position of the text
+	std::vector<float> vertices;
 	Vector3f colour;
 	bool visible;
 
@@ -37,8 +37,8 @@ private:
 
 public:
 	/**
-	* Creates a new text, loads the text's quads into a VAO, and adds the text
-	* to the screen.
+	* Creates a new text, lays out the text's quads, and adds the text to the
+	* screen.
 	*
 	* @param text
 	*            - the text.
@@ -70,6 +70,21 @@ public:
 	*/
 	void deleteMe();
 
+	/**
+	* Changes the string of the text. This only lays the quads out again on the
+	* CPU, so it is cheap enough to do every frame. Does nothing if the string
+	* is the same as before.
+	*
+	* @param newText
+	*            - the new string of text.
+	*/
+	void setText(std::string newText);
+
+	/**
+	* Lays out the quads of the text again, using the font of the text.
+	*/
+	void updateMesh();
+
 	/**
 	* @return The font used by this text.
 	*/
@@ -113,21 +128,11 @@ public:
 	bool isVisible();
 
 	/**
-	* @return the ID of the text's VAO, which contains all the vertex data for
-	*         the quads on which the text will be rendered.
-	*/
-	int getMesh();
-
-	/**
-	* Set the VAO and vertex count for this text.
-	*
-	* @param vao
-	*            - the VAO containing all the vertex data for the quads on
-	*            which the text will be rendered.
-	* @param verticesCount
-	*            - the total number of vertices in all of the quads.
+	* @return the vertex data for the quads on which the text will be
+	*         rendered. Each vertex is an x, y position relative to the
+	*         position of the text, then the texture coords.
 	*/
-	void setMeshInfo(int vao, std::vector<int>* vbos, int verticesCount);
+	std::vector<float>* getVertices();
 
 	/**
 	* @return The total number of vertices of all the text's quads.
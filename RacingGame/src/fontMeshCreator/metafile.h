@@ -31,7 +31,8 @@ private:
 	int paddingWidth;
 	int paddingHeight;
 
-	std::unordered_map<int, Character> metaData;
+	//Indexed by ascii value. Characters that the font doesn't have are left empty.
+	Character glyphs[128];
 
 	std::ifstream* reader;
 
@@ -121,7 +122,8 @@ public:
 
 	double getSpaceWidth();
 
-	Character getCharacter(int ascii);
+	//Returns an empty character for anything outside of ascii
+	Character* getCharacter(char c);
 };
 
 #endif
\ No newline at end of file
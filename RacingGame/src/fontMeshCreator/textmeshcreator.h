@@ -6,29 +6,60 @@ class GUIText;
 
 #include <string>
 #include <vector>
+#include <list>
+#include <unordered_map>
 
-#include "line.h"
-#include "textmeshdata.h"
+//A word of the text being laid out, as a range of the text's string
+struct TextLayoutWord
+{
+	int start;
+	int end;
+	float width;
+};
 
+//A range of the words that fit on one line
+struct TextLayoutLine
+{
+	int firstWord;
+	int wordCount;
+	float length;
+};
+
+struct CachedTextLayout
+{
+	std::string key;
+	std::vector<float> vertices;
+	int numberOfLines;
+};
 
 class TextMeshCreator
 {
 private:
-	MetaFile* metaData;
+	//Number of layouts that each font remembers
+	static const int CACHE_CAPACITY = 256;
 
-	std::vector<Line> createStructure(GUIText* text);
+	MetaFile* metaData;
 
-	//void completeStructure(std::vector<Line> lines, Line currentLine, Word currentWord, GUIText* text);
+	//Reused for every layout, so once they are big enough nothing gets allocated
+	std::vector<TextLayoutWord> words;
+	std::vector<TextLayoutLine> lines;
+	int glyphCount;
+	std::string cacheKey;
 
-	TextMeshData* createQuadVertices(GUIText* text, std::vector<Line>* lines);
+	//Most recently used layout at the front
+	std::list<CachedTextLayout> cache;
+	std::unordered_map<std::string, std::list<CachedTextLayout>::iterator> cacheLookup;
 
-	void addVerticesForCharacter(double curserX, double curserY, Character character, double fontSize, std::vector<float>* vertices);
+	void createStructure(GUIText* text);
 
-	static void addVertices(std::vector<float>* vertices, double x, double y, double maxX, double maxY);
+	//Ends the current word. Same rules as the old Line class: a word that doesn't
+	// fit starts a new line, and a word that doesn't fit on an empty line is dropped.
+	void addWord(TextLayoutLine* line, int start, int end, float width, float spaceSize, float maxLength);
 
-	static void addTexCoords(std::vector<float>* texCoords, double x, double y, double maxX, double maxY);
+	void createQuadVertices(GUIText* text, std::vector<float>* vertices);
 
-	//static float[] listToArray(std::vector<Float> listOfFloats);
+	//Everything that changes the layout of the text. The font is whichever font owns this creator.
+	void createCacheKey(GUIText* text);
 
 public:
 	static double LINE_HEIGHT;
@@ -36,8 +67,14 @@ public:
 
 	TextMeshCreator(std::string filename);
 
-	TextMeshData* createTextMesh(GUIText* text);
-	
+	//Lays out the text into 6 vertices per character, as x, y, u, v.
+	//Text that has been laid out recently is copied out of the cache instead.
+	void createTextMesh(GUIText* text, std::vector<float>* vertices);
+
+	//Same as createTextMesh, but never uses the cache
+	void layoutText(GUIText* text, std::vector<float>* vertices);
+
+	void clearCache();
 };
 
 #endif
\ No newline at end of file
@@ -1,12 +1,17 @@
 #include <glad/glad.h>
 #include <list>
+#include <vector>
+#include <cstdio>
 #include "fontrenderer.h"
 #include "../fontMeshCreator/fonttype.h"
 #include "../fontMeshCreator/guitext.h"
 #include "../fontMeshCreator/guinumber.h"
+#include "../renderEngine/renderEngine.h"
 #include "fontshader.h"
 #include "../engineTester/main.h"
 
+#define STAT_DRAW_CALLS 0
+#define STAT_VERTICES   1
 
 FontRenderer::FontRenderer()
 {
@@ -16,39 +21,39 @@ FontRenderer::FontRenderer()
 
 
 void FontRenderer::render(
-	std::unordered_map<FontType*, std::list<GUIText*>>* texts, 
+	std::unordered_map<FontType*, std::list<GUIText*>>* texts,
 	std::unordered_map<FontType*, std::list<GUINumber*>>* numbers)
 {
 	prepare();
-	for (auto kv : (*texts))
+	for (auto& kv : (*texts))
 	{
-		FontType* font = kv.first;
-		std::list<GUIText*> listOfTexts = kv.second;
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, font->getTextureAtlas());
-		for (GUIText* text : listOfTexts)
+		auto fontNumbers = numbers->find(kv.first);
+		if (fontNumbers != numbers->end())
 		{
-			if (text->isVisible())
-			{
-				renderText(text);
-			}
+			renderFont(kv.first, &kv.second, &fontNumbers->second);
+		}
+		else
+		{
+			renderFont(kv.first, &kv.second, nullptr);
 		}
 	}
-	for (auto kv : (*numbers))
+	for (auto& kv : (*numbers))
 	{
-		FontType* font = kv.first;
-		std::list<GUINumber*> listOfNumbers = kv.second;
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, font->getTextureAtlas());
-		for (GUINumber* number : listOfNumbers)
+		//Fonts that have text were already drawn along with their numbers
+		if (texts->find(kv.first) == texts->end())
 		{
-			if (number->isVisible())
-			{
-				renderNumber(number);
-			}
+			renderFont(kv.first, nullptr, &kv.second);
 		}
 	}
 	endRendering();
+
+	#ifdef DEV_MODE
+	if (stats.endFrame())
+	{
+		std::fprintf(stdout, "Text: %f draw calls and %f vertices per frame\n",
+			stats.getAverage(STAT_DRAW_CALLS), stats.getAverage(STAT_VERTICES));
+	}
+	#endif
 }
 
 void FontRenderer::cleanUp()
@@ -64,35 +69,177 @@ void FontRenderer::prepare()
 	shader->start();
 }
 
-void FontRenderer::renderText(GUIText* text)
+FontBatch* FontRenderer::getBatch(FontType* font)
 {
-	glBindVertexArray(text->getMesh());
-	glEnableVertexAttribArray(0);
-	glEnableVertexAttribArray(1);
-	shader->loadColour(text->getColour());
-	shader->loadTranslation(text->getPosition());
-	glDrawArrays(GL_TRIANGLES, 0, text->getVertexCount());
-	glDisableVertexAttribArray(0);
-	glDisableVertexAttribArray(1);
-	glBindVertexArray(0);
+	auto entry = batches.find(font);
+	if (entry != batches.end())
+	{
+		return &entry->second;
+	}
+
+	std::vector<int> attributeSizes;
+	attributeSizes.push_back(2); //position
+	attributeSizes.push_back(2); //texture coords
+	attributeSizes.push_back(3); //colour
+
+	FontBatch batch;
+	batch.capacity = INITIAL_BATCH_CAPACITY;
+	batch.vao = Loader::createStreamingVao(&attributeSizes, batch.capacity*VERTEX_DATA_LENGTH*sizeof(float), &batch.vbo);
+
+	batches[font] = batch;
+	return &batches[font];
 }
 
-void FontRenderer::renderNumber(GUINumber* number)
+void FontRenderer::renderFont(FontType* font, std::list<GUIText*>* texts, std::list<GUINumber*>* numbers)
 {
-	int numChars = (int)number->meshIDs.size();
-	for (int i = 0; i < numChars; i++)
+	int vertexCount = countVertices(texts, numbers);
+	if (vertexCount == 0)
+	{
+		return;
+	}
+
+	FontBatch* batch = getBatch(font);
+	vertexCount = fillBatch(batch, vertexCount, texts, numbers);
+	if (vertexCount == 0)
 	{
-		glBindVertexArray(number->meshIDs[i]);
-		glEnableVertexAttribArray(0);
-		glEnableVertexAttribArray(1);
-		shader->loadColour(number->getColour());
-		shader->loadTranslation(&number->meshPositions[i]);
-		glDrawArrays(GL_TRIANGLES, 0, number->meshVertexCounts[i]);
+		return;
 	}
 
-	glDisableVertexAttribArray(0);
-	glDisableVertexAttribArray(1);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, font->getTextureAtlas());
+	glBindVertexArray(batch->vao);
+	glDrawArrays(GL_TRIANGLES, 0, vertexCount);
 	glBindVertexArray(0);
+
+	#ifdef DEV_MODE
+	stats.add(STAT_DRAW_CALLS, 1);
+	stats.add(STAT_VERTICES, vertexCount);
+	#endif
+}
+
+int FontRenderer::countVertices(std::list<GUIText*>* texts, std::list<GUINumber*>* numbers)
+{
+	int count = 0;
+	if (texts != nullptr)
+	{
+		for (GUIText* text : (*texts))
+		{
+			if (text->isVisible())
+			{
+				count += text->getVertexCount();
+			}
+		}
+	}
+	if (numbers != nullptr)
+	{
+		for (GUINumber* number : (*numbers))
+		{
+			if (number->isVisible())
+			{
+				count += 6*(int)number->meshDigits.size();
+			}
+		}
+	}
+	return count;
+}
+
+int FontRenderer::fillBatch(FontBatch* batch, int vertexCount, std::list<GUIText*>* texts, std::list<GUINumber*>* numbers)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, batch->vbo);
+
+	if (vertexCount > batch->capacity)
+	{
+		while (batch->capacity < vertexCount)
+		{
+			batch->capacity *= 2;
+		}
+		glBufferData(GL_ARRAY_BUFFER, batch->capacity*VERTEX_DATA_LENGTH*sizeof(float), nullptr, GL_STREAM_DRAW);
+	}
+
+	//Same as the particles, invalidating lets the driver hand back fresh memory
+	// instead of waiting on last frame's draw
+	float* data = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vertexCount*VERTEX_DATA_LENGTH*sizeof(float),
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (data == nullptr)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		return 0;
+	}
+
+	if (texts != nullptr)
+	{
+		for (GUIText* text : (*texts))
+		{
+			if (text->isVisible())
+			{
+				data = writeText(data, text);
+			}
+		}
+	}
+	if (numbers != nullptr)
+	{
+		for (GUINumber* number : (*numbers))
+		{
+			if (number->isVisible())
+			{
+				data = writeNumber(data, number);
+			}
+		}
+	}
+
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return vertexCount;
+}
+
+float* FontRenderer::writeText(float* data, GUIText* text)
+{
+	//Text positions go from (0, 0) at the top left to (1, 1) at the bottom right
+	float translationX =  2*text->getPosition()->x;
+	float translationY = -2*text->getPosition()->y;
+	Vector3f* colour = text->getColour();
+
+	std::vector<float>* vertices = text->getVertices();
+	int count = text->getVertexCount();
+	for (int i = 0; i < count; i++)
+	{
+		float* vertex = &(*vertices)[i*4];
+		data[0] = vertex[0] + translationX;
+		data[1] = vertex[1] + translationY;
+		data[2] = vertex[2];
+		data[3] = vertex[3];
+		data[4] = colour->x;
+		data[5] = colour->y;
+		data[6] = colour->z;
+		data += VERTEX_DATA_LENGTH;
+	}
+	return data;
+}
+
+float* FontRenderer::writeNumber(float* data, GUINumber* number)
+{
+	Vector3f* colour = number->getColour();
+
+	int numChars = (int)number->meshDigits.size();
+	for (int c = 0; c < numChars; c++)
+	{
+		float translationX =  2*number->meshPositions[c].x;
+		float translationY = -2*number->meshPositions[c].y;
+		float* vertices = GUINumber::numberMeshVertices[number->meshDigits[c]];
+		for (int i = 0; i < 6; i++)
+		{
+			data[0] = vertices[i*4    ] + translationX;
+			data[1] = vertices[i*4 + 1] + translationY;
+			data[2] = vertices[i*4 + 2];
+			data[3] = vertices[i*4 + 3];
+			data[4] = colour->x;
+			data[5] = colour->y;
+			data[6] = colour->z;
+			data += VERTEX_DATA_LENGTH;
+		}
+	}
+	return data;
 }
 
 void FontRenderer::endRendering()
@@ -49,6 +49,7 @@ void FontShader::bindAttributes()
 {
 	bindAttribute(0, "position");
 	bindAttribute(1, "textureCoords");
+	bindAttribute(2, "colour");
 }
 
 void FontShader::bindAttribute(int attribute, const char* variableName)
@@ -58,18 +59,7 @@ void FontShader::bindAttribute(int attribute, const char* variableName)
 
 void FontShader::getAllUniformLocations()
 {
-	location_colour = getUniformLocation("colour");
-	location_translation = getUniformLocation("translation");
-}
-
-void FontShader::loadColour(Vector3f* colour)
-{
-	loadVector(location_colour, colour);
-}
-
-void FontShader::loadTranslation(Vector2f* translation)
-{
-	load2DVector(location_translation, translation);
+	//The colour and position of each text are baked into its vertices
 }
 
 int FontShader::getUniformLocation(const char* uniformName)
@@ -1,9 +1,11 @@
 #include <list>
 #include <unordered_map>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdio>
 
 #include "textmaster.h"
-#include "../renderEngine/renderEngine.h"
-#include "../fontMeshCreator/textmeshdata.h"
 #include "../fontMeshCreator/fonttype.h"
 #include "../fontMeshCreator/guitext.h"
 #include "../fontMeshCreator/guinumber.h"
@@ -27,18 +29,7 @@ void TextMaster::render()
 
 void TextMaster::loadText(GUIText* text)
 {
-	FontType* font = text->getFont();
-	TextMeshData* data = font->loadText(text);
-	std::vector<int> vertexObjects = Loader::loadToVAO(data->getVertexPositions(), data->getTextureCoords());
-	int vao = vertexObjects[0];
-	std::vector<int> vbos;
-	vbos.push_back(vertexObjects[1]);
-	vbos.push_back(vertexObjects[2]);
-	text->setMeshInfo(vao, &vbos, data->getVertexCount());
-
-	delete data; INCR_DEL
-
-	std::list<GUIText*>* textBatch = &texts[font];
+	std::list<GUIText*>* textBatch = &texts[text->getFont()];
 	textBatch->push_back(text);
 }
 
@@ -74,3 +65,57 @@ void TextMaster::cleanUp()
 {
 	renderer->cleanUp();
 }
+
+void TextMaster::benchmarkLayout()
+{
+	#ifdef DEV_MODE
+	if (texts.empty())
+	{
+		return;
+	}
+
+	//The kinds of strings that the game changes all the time
+	FontType* font = texts.begin()->first;
+	std::vector<GUIText*> benchmarkTexts;
+	for (int i = 0; i < 64; i++)
+	{
+		std::string string;
+		switch (i % 4)
+		{
+			case 0:  string = std::to_string(i*37); break;
+			case 1:  string = "Hor Vel:" + std::to_string(i*1.37f); break;
+			case 2:  string = "0" + std::to_string(i % 10) + ":" + std::to_string(10 + i) + "." + std::to_string(99 - i); break;
+			default: string = "Press any button to continue " + std::to_string(i); break;
+		}
+		benchmarkTexts.push_back(new GUIText(string, 1, font, 0.5f, 0.5f, 0.5f, true, false, false)); INCR_NEW
+	}
+
+	std::vector<float> vertices;
+	const int layoutCount = 200000;
+
+	auto timeStart = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < layoutCount; i++)
+	{
+		font->layoutText(benchmarkTexts[i % 64], &vertices);
+	}
+	auto timeEnd = std::chrono::high_resolution_clock::now();
+	double uncachedTime = std::chrono::duration<double>(timeEnd - timeStart).count();
+
+	timeStart = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < layoutCount; i++)
+	{
+		font->loadText(benchmarkTexts[i % 64], &vertices);
+	}
+	timeEnd = std::chrono::high_resolution_clock::now();
+	double cachedTime = std::chrono::duration<double>(timeEnd - timeStart).count();
+
+	std::fprintf(stdout, "Text layout: %f layouts per second, %f layouts per second from the cache\n",
+		layoutCount/uncachedTime, layoutCount/cachedTime);
+
+	for (GUIText* text : benchmarkTexts)
+	{
+		text->deleteMe();
+		delete text; INCR_DEL
+	}
+	#endif
+}
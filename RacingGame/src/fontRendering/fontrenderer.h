@@ -6,19 +6,49 @@ class GUIText;
 class GUINumber;
 class FontShader;
 
+#include <glad/glad.h>
 #include <unordered_map>
 #include <list>
 
+#include "../toolbox/framestats.h"
+
+//Every visible text and number of a font gets written into one streaming vbo
+// each frame, so each font is a single draw call.
+struct FontBatch
+{
+	GLuint vao;
+	GLuint vbo;
+	int capacity; //in vertices
+};
+
 class FontRenderer
 {
 private:
+	//x, y, u, v, r, g, b
+	static const int VERTEX_DATA_LENGTH = 7;
+	static const int INITIAL_BATCH_CAPACITY = 1024;
+
 	FontShader* shader;
 
+	std::unordered_map<FontType*, FontBatch> batches;
+
+	FrameStats stats;
+
 	void prepare();
 
-	void renderText(GUIText* text);
+	FontBatch* getBatch(FontType* font);
+
+	//Either list can be nullptr
+	void renderFont(FontType* font, std::list<GUIText*>* texts, std::list<GUINumber*>* numbers);
+
+	int countVertices(std::list<GUIText*>* texts, std::list<GUINumber*>* numbers);
+
+	//Writes the vertices into the batch's vbo. Returns how many were written.
+	int fillBatch(FontBatch* batch, int vertexCount, std::list<GUIText*>* texts, std::list<GUINumber*>* numbers);
+
+	float* writeText(float* data, GUIText* text);
 
-	void renderNumber(GUINumber* number);
+	float* writeNumber(float* data, GUINumber* number);
 
 	void endRendering();
 
@@ -26,7 +56,7 @@ public:
 	FontRenderer();
 
 	void render(
-		std::unordered_map<FontType*, std::list<GUIText*>>* texts, 
+		std::unordered_map<FontType*, std::list<GUIText*>>* texts,
 		std::unordered_map<FontType*, std::list<GUINumber*>>* numbers);
 
 	void cleanUp();
@@ -16,9 +16,6 @@ private:
 	GLuint vertexShaderID;
 	GLuint fragmentShaderID;
 
-	int location_colour;
-	int location_translation;
-
 	float matrixBuffer[16];
 
 public:
@@ -30,10 +27,6 @@ public:
 
 	void cleanUp();
 
-	void loadColour(Vector3f* colour);
-
-	void loadTranslation(Vector2f* translation);
-
 protected:
 	void bindAttributes();
 
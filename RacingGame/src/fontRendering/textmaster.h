@@ -34,6 +34,9 @@ public:
 	static void removeNumber(GUINumber* number);
 
 	static void cleanUp();
+
+	//Prints how many layouts per second the fonts can do, with and without the layout cache
+	static void benchmarkLayout();
 };
 
 #endif
\ No newline at end of file
@@ -19,12 +19,12 @@
 
 GUIText* GuiManager::timerColon  = nullptr;
 GUIText* GuiManager::timerPeriod = nullptr;
-GUIText* GuiManager::timerMin1[10];
-GUIText* GuiManager::timerMin2[10];
-GUIText* GuiManager::timerSec1[10];
-GUIText* GuiManager::timerSec2[10];
-GUIText* GuiManager::timerCen1[10];
-GUIText* GuiManager::timerCen2[10];
+GUIText* GuiManager::timerMin1   = nullptr;
+GUIText* GuiManager::timerMin2   = nullptr;
+GUIText* GuiManager::timerSec1   = nullptr;
+GUIText* GuiManager::timerSec2   = nullptr;
+GUIText* GuiManager::timerCen1   = nullptr;
+GUIText* GuiManager::timerCen2   = nullptr;
 
 bool   GuiManager::timerIsRunning = false;
 float  GuiManager::timerValue     = 0;
@@ -58,7 +58,18 @@ std::list<GuiTexture*> GuiManager::guisToRender;
 void GuiManager::init()
 {
 	fontVip = PauseScreen::font;
-	textLives = new GUIText("0", 1, fontVip, 0.01f, 0.98f, 1, false, false, false); INCR_NEW
+
+	const float w = 0.02f;   //width of a single text character
+	const float o = 0.0008f; //horizontal offset to adjust for centered vs non centered
+	const float s = 1.5f;    //size of timer text
+
+	extern unsigned int SCR_WIDTH;
+	extern unsigned int SCR_HEIGHT;
+
+	float px = 1.0f/(SCR_WIDTH);  //1 pixel in x dimension
+	float py = 1.0f/(SCR_HEIGHT); //1 pixel in y dimension
+
+	textLives = new GUIText("0", 1.5f, fontVip, o+16*px, 1.0f-80*py, 1, false, false, false); INCR_NEW
 
 	//Player debug text
 	textHorVel              = new GUIText("Hor Vel:"     + std::to_string(horVel),              1, fontVip, 0.01f, 0.70f, 1, false, false, Global::debugDisplay); INCR_NEW
@@ -71,78 +82,16 @@ void GuiManager::init()
 	textX = new GUIText("X", 1, fontVip, 0.90f, 0.95f, 1, false, false, Global::debugDisplay); INCR_NEW
 	textY = new GUIText("Y", 1, fontVip, 0.95f, 0.95f, 1, false, false, Global::debugDisplay); INCR_NEW
 
-	const float w = 0.02f; //width of a single text character
-	const float s = 1.5f; //size of timer text
-
-	extern unsigned int SCR_WIDTH;
-	extern unsigned int SCR_HEIGHT;
-
-	float px = 1.0f/(SCR_WIDTH);  //1 pixel in x dimension
-	float py = 1.0f/(SCR_HEIGHT); //1 pixel in y dimension
-
-	GuiManager::timerColon   = new GUIText(":", s, fontVip, 2*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerPeriod  = new GUIText(".", s, fontVip, 5*w+16*px, 16*py, w, true, false, true); INCR_NEW
-
-	GuiManager::timerMin1[0] = new GUIText("0", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin1[1] = new GUIText("1", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin1[2] = new GUIText("2", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin1[3] = new GUIText("3", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin1[4] = new GUIText("4", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin1[5] = new GUIText("5", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin1[6] = new GUIText("6", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin1[7] = new GUIText("7", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin1[8] = new GUIText("8", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin1[9] = new GUIText("9", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin2[0] = new GUIText("0", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin2[1] = new GUIText("1", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin2[2] = new GUIText("2", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin2[3] = new GUIText("3", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin2[4] = new GUIText("4", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin2[5] = new GUIText("5", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin2[6] = new GUIText("6", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin2[7] = new GUIText("7", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin2[8] = new GUIText("8", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerMin2[9] = new GUIText("9", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec1[0] = new GUIText("0", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec1[1] = new GUIText("1", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec1[2] = new GUIText("2", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec1[3] = new GUIText("3", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec1[4] = new GUIText("4", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec1[5] = new GUIText("5", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec1[6] = new GUIText("6", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec1[7] = new GUIText("7", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec1[8] = new GUIText("8", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec1[9] = new GUIText("9", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec2[0] = new GUIText("0", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec2[1] = new GUIText("1", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec2[2] = new GUIText("2", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec2[3] = new GUIText("3", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec2[4] = new GUIText("4", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec2[5] = new GUIText("5", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec2[6] = new GUIText("6", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec2[7] = new GUIText("7", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec2[8] = new GUIText("8", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerSec2[9] = new GUIText("9", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen1[0] = new GUIText("0", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen1[1] = new GUIText("1", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen1[2] = new GUIText("2", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen1[3] = new GUIText("3", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen1[4] = new GUIText("4", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen1[5] = new GUIText("5", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen1[6] = new GUIText("6", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen1[7] = new GUIText("7", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen1[8] = new GUIText("8", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen1[9] = new GUIText("9", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen2[0] = new GUIText("0", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen2[1] = new GUIText("1", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen2[2] = new GUIText("2", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen2[3] = new GUIText("3", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen2[4] = new GUIText("4", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen2[5] = new GUIText("5", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen2[6] = new GUIText("6", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen2[7] = new GUIText("7", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen2[8] = new GUIText("8", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
-	GuiManager::timerCen2[9] = new GUIText("9", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
+	//Each character of the timer is its own centered text so that the digits
+	// stay in fixed columns. Only the string of the digits changes.
+	GuiManager::timerMin1   = new GUIText("0", s, fontVip, 0*w+16*px, 16*py, w, true, false, true); INCR_NEW
+	GuiManager::timerMin2   = new GUIText("0", s, fontVip, 1*w+16*px, 16*py, w, true, false, true); INCR_NEW
+	GuiManager::timerColon  = new GUIText(":", s, fontVip, 2*w+16*px, 16*py, w, true, false, true); INCR_NEW
+	GuiManager::timerSec1   = new GUIText("0", s, fontVip, 3*w+16*px, 16*py, w, true, false, true); INCR_NEW
+	GuiManager::timerSec2   = new GUIText("0", s, fontVip, 4*w+16*px, 16*py, w, true, false, true); INCR_NEW
+	GuiManager::timerPeriod = new GUIText(".", s, fontVip, 5*w+16*px, 16*py, w, true, false, true); INCR_NEW
+	GuiManager::timerCen1   = new GUIText("0", s, fontVip, 6*w+16*px, 16*py, w, true, false, true); INCR_NEW
+	GuiManager::timerCen2   = new GUIText("0", s, fontVip, 7*w+16*px, 16*py, w, true, false, true); INCR_NEW
 
 	GuiManager::numberSpeed    = new GUINumber(0, 0.87f, 0.9f, 0, true); INCR_NEW
 	GuiManager::textSpeedUnits = new GUIText("km/h", 1.5f, fontVip, 0.88f, 0.918f, 1.0f, false, false, true); INCR_NEW
@@ -160,21 +109,9 @@ void GuiManager::refresh()
 
 	//std::fprintf(stdout, "timer chunks = %f   timer stamp = %f\n", timerValue, (float)(GuiManager::timestampEnd-GuiManager::timestampStart));
 
-	extern unsigned int SCR_WIDTH;
-	extern unsigned int SCR_HEIGHT;
-
-	float px = 1.0f/(SCR_WIDTH);  //1 pixel in x dimension
-	float py = 1.0f/(SCR_HEIGHT); //1 pixel in y dimension
-
-	const float w = 0.02f;   //width of a single text character
-	const float o = 0.0008f; //horizontal offset to adjust for centered vs non centered
-	//const float s = 1.5f;    //size of timer text
-
 	if (Global::gameLives != GuiManager::previousLives)
 	{
-		textLives->deleteMe();
-		delete textLives; INCR_DEL
-		textLives = new GUIText(std::to_string(Global::gameLives), 1.5f, fontVip, o+16*px, 1.0f-80*py, 1, false, false, true); INCR_NEW
+		textLives->setText(std::to_string(Global::gameLives));
 		GuiManager::previousLives = Global::gameLives;
 	}
 
@@ -198,44 +135,20 @@ void GuiManager::refresh()
 		}
 
 		//Display debug text is debugDisplay is true.
-		textHorVel->deleteMe(); delete textHorVel; INCR_DEL textHorVel = nullptr;
-		textHorVel = new GUIText("Hor Vel:" + std::to_string(horVel), 1.0f, fontVip, 0.01f, 0.70f, 1, false, false, Global::debugDisplay); INCR_NEW
+		textHorVel->setText("Hor Vel:" + std::to_string(horVel));
+		textHorVel->setVisibility(true);
 
-		textVerVel->deleteMe(); delete textVerVel; INCR_DEL textVerVel = nullptr;
-		textVerVel = new GUIText("Ver Vel:" + std::to_string(verVel), 1.0f, fontVip, 0.01f, 0.75f, 1, false, false, Global::debugDisplay); INCR_NEW
+		textVerVel->setText("Ver Vel:" + std::to_string(verVel));
+		textVerVel->setVisibility(true);
 
-		textTotalVel->deleteMe(); delete textTotalVel; INCR_DEL textTotalVel = nullptr;
-		textTotalVel = new GUIText("Total Vel:" + std::to_string(totalVel), 1.0f, fontVip, 0.01f, 0.80f, 1, false, false, Global::debugDisplay); INCR_NEW
+		textTotalVel->setText("Total Vel:" + std::to_string(totalVel));
+		textTotalVel->setVisibility(true);
 
 		//Input display
-
-		textA->deleteMe(); delete textA; INCR_DEL textA = nullptr;
-		textA = new GUIText("A", 1, fontVip, 0.80f, 0.95f, 1, false, false, Global::debugDisplay); INCR_NEW
-		if (!Input::inputs.INPUT_ACTION1)
-		{
-			textA->setColour(0.2f, 0.2f, 0.2f);
-		}
-
-		textB->deleteMe(); delete textB; INCR_DEL textB = nullptr;
-		textB = new GUIText("B", 1, fontVip, 0.85f, 0.95f, 1, false, false, Global::debugDisplay); INCR_NEW
-		if (!Input::inputs.INPUT_ACTION2)
-		{
-			textB->setColour(0.2f, 0.2f, 0.2f);
-		}
-
-		textX->deleteMe(); delete textX; INCR_DEL textX = nullptr;
-		textX = new GUIText("X", 1, fontVip, 0.90f, 0.95f, 1, false, false, Global::debugDisplay); INCR_NEW
-		if (!Input::inputs.INPUT_ACTION3)
-		{
-			textX->setColour(0.2f, 0.2f, 0.2f);
-		}
-
-		textY->deleteMe(); delete textY; INCR_DEL textY = nullptr;
-		textY = new GUIText("Y", 1, fontVip, 0.95f, 0.95f, 1, false, false, Global::debugDisplay); INCR_NEW
-		if (!Input::inputs.INPUT_ACTION4)
-		{
-			textY->setColour(0.2f, 0.2f, 0.2f);
-		}
+		setInputColour(textA, Input::inputs.INPUT_ACTION1);
+		setInputColour(textB, Input::inputs.INPUT_ACTION2);
+		setInputColour(textX, Input::inputs.INPUT_ACTION3);
+		setInputColour(textY, Input::inputs.INPUT_ACTION4);
 	}
 	else
 	{
@@ -266,12 +179,18 @@ void GuiManager::refresh()
 
 		timerColon ->setVisibility(true);
 		timerPeriod->setVisibility(true);
-		timerMin1[minut/10]->setVisibility(true);
-		timerMin2[minut%10]->setVisibility(true);
-		timerSec1[secon/10]->setVisibility(true);
-		timerSec2[secon%10]->setVisibility(true);
-		timerCen1[centi/10]->setVisibility(true);
-		timerCen2[centi%10]->setVisibility(true);
+		timerMin1  ->setVisibility(true);
+		timerMin2  ->setVisibility(true);
+		timerSec1  ->setVisibility(true);
+		timerSec2  ->setVisibility(true);
+		timerCen1  ->setVisibility(true);
+		timerCen2  ->setVisibility(true);
+		timerMin1  ->setText(std::to_string(minut/10));
+		timerMin2  ->setText(std::to_string(minut%10));
+		timerSec1  ->setText(std::to_string(secon/10));
+		timerSec2  ->setText(std::to_string(secon%10));
+		timerCen1  ->setText(std::to_string(centi/10));
+		timerCen2  ->setText(std::to_string(centi%10));
 
 		GuiManager::numberSpeed->displayNumber = Global::gameMainVehicleSpeed;
 		GuiManager::numberSpeed->refresh();
@@ -297,68 +216,27 @@ void GuiManager::refresh()
 
 void GuiManager::setTimerInvisible()
 {
-	GuiManager::timerColon  ->setVisibility(false);
-	GuiManager::timerPeriod ->setVisibility(false);
-	GuiManager::timerMin1[0]->setVisibility(false);
-	GuiManager::timerMin1[1]->setVisibility(false);
-	GuiManager::timerMin1[2]->setVisibility(false);
-	GuiManager::timerMin1[3]->setVisibility(false);
-	GuiManager::timerMin1[4]->setVisibility(false);
-	GuiManager::timerMin1[5]->setVisibility(false);
-	GuiManager::timerMin1[6]->setVisibility(false);
-	GuiManager::timerMin1[7]->setVisibility(false);
-	GuiManager::timerMin1[8]->setVisibility(false);
-	GuiManager::timerMin1[9]->setVisibility(false);
-	GuiManager::timerMin2[0]->setVisibility(false);
-	GuiManager::timerMin2[1]->setVisibility(false);
-	GuiManager::timerMin2[2]->setVisibility(false);
-	GuiManager::timerMin2[3]->setVisibility(false);
-	GuiManager::timerMin2[4]->setVisibility(false);
-	GuiManager::timerMin2[5]->setVisibility(false);
-	GuiManager::timerMin2[6]->setVisibility(false);
-	GuiManager::timerMin2[7]->setVisibility(false);
-	GuiManager::timerMin2[8]->setVisibility(false);
-	GuiManager::timerMin2[9]->setVisibility(false);
-	GuiManager::timerSec1[0]->setVisibility(false);
-	GuiManager::timerSec1[1]->setVisibility(false);
-	GuiManager::timerSec1[2]->setVisibility(false);
-	GuiManager::timerSec1[3]->setVisibility(false);
-	GuiManager::timerSec1[4]->setVisibility(false);
-	GuiManager::timerSec1[5]->setVisibility(false);
-	GuiManager::timerSec1[6]->setVisibility(false);
-	GuiManager::timerSec1[7]->setVisibility(false);
-	GuiManager::timerSec1[8]->setVisibility(false);
-	GuiManager::timerSec1[9]->setVisibility(false);
-	GuiManager::timerSec2[0]->setVisibility(false);
-	GuiManager::timerSec2[1]->setVisibility(false);
-	GuiManager::timerSec2[2]->setVisibility(false);
-	GuiManager::timerSec2[3]->setVisibility(false);
-	GuiManager::timerSec2[4]->setVisibility(false);
-	GuiManager::timerSec2[5]->setVisibility(false);
-	GuiManager::timerSec2[6]->setVisibility(false);
-	GuiManager::timerSec2[7]->setVisibility(false);
-	GuiManager::timerSec2[8]->setVisibility(false);
-	GuiManager::timerSec2[9]->setVisibility(false);
-	GuiManager::timerCen1[0]->setVisibility(false);
-	GuiManager::timerCen1[1]->setVisibility(false);
-	GuiManager::timerCen1[2]->setVisibility(false);
-	GuiManager::timerCen1[3]->setVisibility(false);
-	GuiManager::timerCen1[4]->setVisibility(false);
-	GuiManager::timerCen1[5]->setVisibility(false);
-	GuiManager::timerCen1[6]->setVisibility(false);
-	GuiManager::timerCen1[7]->setVisibility(false);
-	GuiManager::timerCen1[8]->setVisibility(false);
-	GuiManager::timerCen1[9]->setVisibility(false);
-	GuiManager::timerCen2[0]->setVisibility(false);
-	GuiManager::timerCen2[1]->setVisibility(false);
-	GuiManager::timerCen2[2]->setVisibility(false);
-	GuiManager::timerCen2[3]->setVisibility(false);
-	GuiManager::timerCen2[4]->setVisibility(false);
-	GuiManager::timerCen2[5]->setVisibility(false);
-	GuiManager::timerCen2[6]->setVisibility(false);
-	GuiManager::timerCen2[7]->setVisibility(false);
-	GuiManager::timerCen2[8]->setVisibility(false);
-	GuiManager::timerCen2[9]->setVisibility(false);
+	GuiManager::timerColon ->setVisibility(false);
+	GuiManager::timerPeriod->setVisibility(false);
+	GuiManager::timerMin1  ->setVisibility(false);
+	GuiManager::timerMin2  ->setVisibility(false);
+	GuiManager::timerSec1  ->setVisibility(false);
+	GuiManager::timerSec2  ->setVisibility(false);
+	GuiManager::timerCen1  ->setVisibility(false);
+	GuiManager::timerCen2  ->setVisibility(false);
+}
+
+void GuiManager::setInputColour(GUIText* text, bool pressed)
+{
+	text->setVisibility(true);
+	if (pressed)
+	{
+		text->setColour(1, 1, 1);
+	}
+	else
+	{
+		text->setColour(0.2f, 0.2f, 0.2f);
+	}
 }
 
 void GuiManager::increaseTimer(float deltaTime)
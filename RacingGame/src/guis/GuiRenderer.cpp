@@ -5,57 +5,160 @@
 #include <glad/glad.h>
 #include "../engineTester/main.h"
 #include "../renderEngine/renderEngine.h"
-#include "../models/models.h"
 #include "../toolbox/maths.h"
-#include "../toolbox/matrix.h"
+#include "../toolbox/vector.h"
 
 #include <vector>
+#include <cmath>
+#include <cstdio>
+
+#define STAT_DRAW_CALLS 0
+#define STAT_QUADS      1
 
-RawModel GuiRenderer::quadModel;
 GuiShader* GuiRenderer::shader = nullptr;
+GLuint GuiRenderer::vao = 0;
+GLuint GuiRenderer::vbo = 0;
+int GuiRenderer::quadCapacity = 0;
+std::vector<GuiBatch> GuiRenderer::batches;
+FrameStats GuiRenderer::stats;
 
 void GuiRenderer::init()
 {
-	std::vector<float> positions;
-	positions.push_back(-1);
-	positions.push_back(1);
-	positions.push_back(-1);
-	positions.push_back(-1);
-	positions.push_back(1);
-	positions.push_back(1);
-	positions.push_back(1);
-	positions.push_back(-1);
-	GuiRenderer::quadModel = Loader::loadToVAO(&positions, 2);
+	std::vector<int> attributeSizes;
+	attributeSizes.push_back(2); //position
+	attributeSizes.push_back(2); //texture coords
+
+	GuiRenderer::quadCapacity = INITIAL_QUAD_CAPACITY;
+	GuiRenderer::vao = Loader::createStreamingVao(&attributeSizes, quadCapacity*6*VERTEX_DATA_LENGTH*sizeof(float), &GuiRenderer::vbo);
 	GuiRenderer::shader = new GuiShader("res/Shaders/guis/guiVertexShader.txt", "res/Shaders/guis/guiFragmentShader.txt"); INCR_NEW
 }
 
 void GuiRenderer::render(std::list<GuiTexture*>* guis)
 {
-	GuiRenderer::shader->start();
-	glBindVertexArray(GuiRenderer::quadModel.getVaoID());
-	glEnableVertexAttribArray(0);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST);
-	for (GuiTexture* gui: (*guis))
+	int quadCount = fillVbo(guis);
+	if (quadCount > 0)
+	{
+		GuiRenderer::shader->start();
+		glBindVertexArray(GuiRenderer::vao);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glDisable(GL_DEPTH_TEST);
+		glActiveTexture(GL_TEXTURE0);
+		for (GuiBatch& batch : batches)
+		{
+			glBindTexture(GL_TEXTURE_2D, batch.textureID);
+			glDrawArrays(GL_TRIANGLES, batch.firstQuad*6, batch.quadCount*6);
+		}
+		glEnable(GL_DEPTH_TEST);
+		glDisable(GL_BLEND);
+		glBindVertexArray(0);
+		GuiRenderer::shader->stop();
+	}
+
+	#ifdef DEV_MODE
+	stats.add(STAT_DRAW_CALLS, (double)batches.size());
+	stats.add(STAT_QUADS, quadCount);
+	if (stats.endFrame())
+	{
+		std::fprintf(stdout, "Guis: %f draw calls and %f quads per frame\n",
+			stats.getAverage(STAT_DRAW_CALLS), stats.getAverage(STAT_QUADS));
+	}
+	#endif
+}
+
+int GuiRenderer::fillVbo(std::list<GuiTexture*>* guis)
+{
+	batches.clear();
+
+	int quadCount = 0;
+	for (GuiTexture* gui : (*guis))
 	{
 		if (gui->getVisible())
 		{
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, gui->getTexture());
-			Matrix4f matrix;
-			Maths::createTransformationMatrix(&matrix, gui->getPosition(), gui->getRotation(), gui->getSizeScaled());
-			GuiRenderer::shader->loadTransformation(&matrix);
-			glDrawArrays(GL_TRIANGLE_STRIP, 0, GuiRenderer::quadModel.getVertexCount());
+			quadCount++;
 		}
 	}
-	glEnable(GL_DEPTH_TEST);
-	glDisable(GL_BLEND);
-	glDisableVertexAttribArray(0);
-	glBindVertexArray(0);
-	GuiRenderer::shader->stop();
+	if (quadCount == 0)
+	{
+		return 0;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+	if (quadCount > quadCapacity)
+	{
+		while (quadCapacity < quadCount)
+		{
+			quadCapacity *= 2;
+		}
+		glBufferData(GL_ARRAY_BUFFER, quadCapacity*6*VERTEX_DATA_LENGTH*sizeof(float), nullptr, GL_STREAM_DRAW);
+	}
+
+	float* data = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0, quadCount*6*VERTEX_DATA_LENGTH*sizeof(float),
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (data == nullptr)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		return 0;
+	}
+
+	int quad = 0;
+	for (GuiTexture* gui : (*guis))
+	{
+		if (!gui->getVisible())
+		{
+			continue;
+		}
+
+		if (batches.size() == 0 || batches.back().textureID != gui->getTexture())
+		{
+			GuiBatch batch;
+			batch.textureID = gui->getTexture();
+			batch.firstQuad = quad;
+			batch.quadCount = 0;
+			batches.push_back(batch);
+		}
+		batches.back().quadCount++;
+
+		data = writeQuad(data, gui);
+		quad++;
+	}
+
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return quadCount;
+}
+
+float* GuiRenderer::writeQuad(float* data, GuiTexture* gui)
+{
+	//Same as the old transformation matrix: scale, then rotate, then move to the position
+	Vector2f* position = gui->getPosition();
+	Vector2f* size = gui->getSizeScaled();
+	Vector4f* rect = gui->getTextureRect();
+	float angle = Maths::toRadians(gui->getRotation());
+	float c = cosf(angle);
+	float s = sinf(angle);
+
+	//Corners of the quad going from -1 to 1, and the texture coords at each one
+	const float cornerX[6] = {-1, -1,  1,  1, -1,  1};
+	const float cornerY[6] = { 1, -1,  1,  1, -1, -1};
+	const float cornerU[6] = { 0,  0,  1,  1,  0,  1};
+	const float cornerV[6] = { 0,  1,  0,  0,  1,  1};
+
+	for (int i = 0; i < 6; i++)
+	{
+		float x = cornerX[i]*size->x;
+		float y = cornerY[i]*size->y;
+		data[0] = position->x + c*x - s*y;
+		data[1] = position->y + s*x + c*y;
+		data[2] = rect->x + cornerU[i]*rect->z;
+		data[3] = rect->y + cornerV[i]*rect->w;
+		data += VERTEX_DATA_LENGTH;
+	}
+	return data;
 }
-	
+
 void GuiRenderer::cleanUp()
 {
 	GuiRenderer::shader->cleanUp();
@@ -44,14 +44,10 @@ void GuiShader::cleanUp()
 	glDeleteProgram(programID);
 }
 
-void GuiShader::loadTransformation(Matrix4f* matrix)
-{
-	loadMatrix(location_transformationMatrix, matrix);
-}
-
 void GuiShader::bindAttributes()
 {
 	bindAttribute(0, "position");
+	bindAttribute(1, "textureCoords");
 }
 
 void GuiShader::bindAttribute(int attribute, const char* variableName)
@@ -61,18 +57,10 @@ void GuiShader::bindAttribute(int attribute, const char* variableName)
 
 void GuiShader::getAllUniformLocations()
 {
-	location_transformationMatrix = getUniformLocation("transformationMatrix");
+	//The quads are transformed on the cpu when they are batched
 }
 
 int GuiShader::getUniformLocation(const char* uniformName)
 {
 	return glGetUniformLocation(programID, uniformName);
 }
-
-float guiMatrixBuffer[16];
-
-void GuiShader::loadMatrix(int location, Matrix4f* matrix)
-{
-	matrix->store(guiMatrixBuffer);
-	glUniformMatrix4fv(location, 1, GL_FALSE, guiMatrixBuffer);
-}
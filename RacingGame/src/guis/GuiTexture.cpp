@@ -6,6 +6,7 @@
 GuiTexture::GuiTexture(GLuint textureID, Vector2f* position, Vector2f* size, float rotation)
 {
 	this->textureID = textureID;
+	this->textureRect.set(0, 0, 1, 1);
 	this->position.x = (position->x*2.0f)-1;
 	this->position.y = -((position->y*2.0f)-1);
 	this->sizeRaw.set(size);
@@ -18,6 +19,7 @@ GuiTexture::GuiTexture(GLuint textureID, Vector2f* position, Vector2f* size, flo
 GuiTexture::GuiTexture(GLuint textureID, float posX, float posY, float sizeX, float sizeY, float rotation)
 {
 	this->textureID = textureID;
+	this->textureRect.set(0, 0, 1, 1);
 	this->position.x = (posX*2.0f)-1;
 	this->position.y = -((posY*2.0f)-1);
 	this->sizeRaw.x = sizeX;
@@ -47,6 +49,18 @@ Vector2f* GuiTexture::getSizeRaw()
 void GuiTexture::setTexture(GLuint newTextureID)
 {
 	textureID = newTextureID;
+	textureRect.set(0, 0, 1, 1);
+}
+
+void GuiTexture::setTexture(GLuint newTextureID, Vector4f* rect)
+{
+	textureID = newTextureID;
+	textureRect.set(rect);
+}
+
+Vector4f* GuiTexture::getTextureRect()
+{
+	return &textureRect;
 }
 
 void GuiTexture::setX(float newX)
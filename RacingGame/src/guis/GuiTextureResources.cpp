@@ -2,10 +2,15 @@
 #include "guitexture.h"
 #include "../renderEngine/renderEngine.h"
 #include "../engineTester/main.h"
+#include "../toolbox/vector.h"
+
+#include <vector>
+#include <string>
 
 GuiTexture* GuiTextureResources::textureRing        = nullptr;
 GuiTexture* GuiTextureResources::textureBlueLine    = nullptr;
 GuiTexture* GuiTextureResources::textureRankDisplay = nullptr;
+GLuint      GuiTextureResources::atlas              = 0;
 
 void GuiTextureResources::loadGuiTextures()
 {
@@ -18,7 +23,17 @@ void GuiTextureResources::loadGuiTextures()
 	const float w = 0.02f;   //width of a single text character
 	const float o = 0.0008f; //horizontal offset to adjust for centered vs non centered
 
-	INCR_NEW textureRing        = new GuiTexture(Loader::loadTexture("res/Images/Ring.png"),     o + 0.5f*w + 16*px, 0.0212f+48*py,  32*px, 32*py, 0 );
-	INCR_NEW textureBlueLine    = new GuiTexture(Loader::loadTexture("res/Images/BlueLine.png"), 0.5f, 0.5f, 10*16*px, 10*128*py, 29.5f);
+	//All of the images share one texture, so that they get batched together when drawn
+	std::vector<std::string> fileNames;
+	fileNames.push_back("res/Images/Ring.png");
+	fileNames.push_back("res/Images/BlueLine.png");
+	std::vector<Vector4f> rects;
+	atlas = Loader::loadTextureAtlas(&fileNames, 4, 2, &rects);
+
+	INCR_NEW textureRing        = new GuiTexture(atlas, o + 0.5f*w + 16*px, 0.0212f+48*py,  32*px, 32*py, 0 );
+	INCR_NEW textureBlueLine    = new GuiTexture(atlas, 0.5f, 0.5f, 10*16*px, 10*128*py, 29.5f);
 	INCR_NEW textureRankDisplay = new GuiTexture(0, 0.5f, 0.8f, 128*px, 128*py, 0);
+
+	textureRing    ->setTexture(atlas, &rects[0]);
+	textureBlueLine->setTexture(atlas, &rects[1]);
 }
\ No newline at end of file
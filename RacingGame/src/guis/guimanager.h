@@ -13,12 +13,12 @@ class GuiManager
 private:
 	static GUIText* timerColon;
 	static GUIText* timerPeriod;
-	static GUIText* timerMin1[10];
-	static GUIText* timerMin2[10];
-	static GUIText* timerSec1[10];
-	static GUIText* timerSec2[10];
-	static GUIText* timerCen1[10];
-	static GUIText* timerCen2[10];
+	static GUIText* timerMin1;
+	static GUIText* timerMin2;
+	static GUIText* timerSec1;
+	static GUIText* timerSec2;
+	static GUIText* timerCen1;
+	static GUIText* timerCen2;
 
 	static bool timerIsRunning;
 	static float timerValue;
@@ -50,6 +50,9 @@ private:
 
 	static void setTimerInvisible();
 
+	//Shows the input text, greyed out if the button isn't pressed
+	static void setInputColour(GUIText* text, bool pressed);
+
 public:
 	static FontType* fontVip;
 
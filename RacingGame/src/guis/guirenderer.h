@@ -4,20 +4,50 @@
 class GuiTexture;
 class GuiShader;
 
+#include <glad/glad.h>
 #include <list>
-#include "../models/models.h"
+#include <vector>
 
+#include "../toolbox/framestats.h"
+
+//A run of quads in the vertex buffer that all use the same texture
+struct GuiBatch
+{
+	GLuint textureID;
+	int firstQuad;
+	int quadCount;
+};
+
+//Every visible gui is written into one streaming vbo each frame. The guis are still drawn
+// in the order of the list, so only guis next to each other that share a texture (or atlas)
+// get drawn together.
 class GuiRenderer
 {
 private:
-	static RawModel quadModel;
+	//x, y, u, v
+	static const int VERTEX_DATA_LENGTH = 4;
+	static const int INITIAL_QUAD_CAPACITY = 64;
+
 	static GuiShader* shader;
 
+	static GLuint vao;
+	static GLuint vbo;
+	static int quadCapacity;
+
+	static std::vector<GuiBatch> batches;
+
+	static FrameStats stats;
+
+	//Returns how many quads were written
+	static int fillVbo(std::list<GuiTexture*>* guis);
+
+	static float* writeQuad(float* data, GuiTexture* gui);
+
 public:
 	static void init();
-	
+
 	static void render(std::list<GuiTexture*>* guis);
-	
+
 	static void cleanUp();
 };
 
@@ -14,8 +14,6 @@ private:
 	GLuint vertexShaderID;
 	GLuint fragmentShaderID;
 
-	int location_transformationMatrix;
-
 public:
 	GuiShader(const char* vertFile, const char* fragFile);
 
@@ -25,9 +23,6 @@ public:
 
 	void cleanUp();
 
-	void loadTransformation(Matrix4f* matrix);
-
-
 protected:
 	void bindAttributes();
 
@@ -36,8 +31,6 @@ protected:
 	void getAllUniformLocations();
 
 	int getUniformLocation(const char* uniName);
-
-	void loadMatrix(int location, Matrix4f* matrix);
 };
 
 #endif
\ No newline at end of file
@@ -8,6 +8,7 @@ class GuiTexture
 {
 private:
 	GLuint textureID;
+	Vector4f textureRect; //x, y, width, height of the image in the texture, in texture coords
 	Vector2f position;
 	Vector2f sizeRaw;
 	Vector2f sizeScaled;
@@ -26,8 +27,15 @@ public:
 
 	GLuint getTexture();
 
+	//Uses the whole texture
 	void setTexture(GLuint newTextureID);
 
+	//Uses only the part of the texture that rect covers (x, y, width, height in texture coords).
+	//Meant for images that are packed into an atlas.
+	void setTexture(GLuint newTextureID, Vector4f* rect);
+
+	Vector4f* getTextureRect();
+
 	//WARNING: ONLY use this to read the position, do NOT use this to write to the position, use setX and setY
 	Vector2f* getPosition();
 
@@ -12,6 +12,9 @@ public:
 	static GuiTexture* textureBlueLine;
 	static GuiTexture* textureRankDisplay;
 
+	//Texture that every image above is packed into
+	static GLuint atlas;
+
 	static void loadGuiTextures();
 };
 #endif
\ No newline at end of file
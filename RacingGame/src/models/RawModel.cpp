@@ -7,13 +7,18 @@
 
 RawModel::RawModel()
 {
-
+	this->firstIndex = 0;
+	this->indexType = GL_UNSIGNED_INT;
+	this->radius = 0;
 }
 
 RawModel::RawModel(GLuint vaoID, int vertexCount, std::list<GLuint>* vboIDs)
 {
 	this->vaoID = vaoID;
 	this->vertexCount = vertexCount;
+	this->firstIndex = 0;
+	this->indexType = GL_UNSIGNED_INT;
+	this->radius = 0;
 
 	for (auto id : (*vboIDs))
 	{
@@ -41,13 +46,67 @@ void RawModel::setVertexCount(int newCount)
 	this->vertexCount = newCount;
 }
 
+void RawModel::setFirstIndex(int newFirstIndex)
+{
+	this->firstIndex = newFirstIndex;
+}
+
+int RawModel::getFirstIndex()
+{
+	return firstIndex;
+}
+
+void RawModel::setIndexType(GLenum newIndexType)
+{
+	this->indexType = newIndexType;
+}
+
+GLenum RawModel::getIndexType()
+{
+	return indexType;
+}
+
+GLvoid* RawModel::getIndexOffset()
+{
+	if (indexType == GL_UNSIGNED_SHORT)
+	{
+		return (GLvoid*)(firstIndex*sizeof(GLushort));
+	}
+	return (GLvoid*)(firstIndex*sizeof(GLuint));
+}
+
 std::list<GLuint>* RawModel::getVboIDs()
 {
 	return &vboIDs;
 }
 
+Vector3f* RawModel::getCenter()
+{
+	return &center;
+}
+
+void RawModel::setCenter(Vector3f* newCenter)
+{
+	center.set(newCenter);
+}
+
+float RawModel::getRadius()
+{
+	return radius;
+}
+
+void RawModel::setRadius(float newRadius)
+{
+	this->radius = newRadius;
+}
+
 void RawModel::deleteMe()
 {
+	if (vboIDs.size() == 0)
+	{
+		return;
+	}
+
 	Loader::deleteVAO(vaoID);
 	for (auto vbo : vboIDs)
 	{
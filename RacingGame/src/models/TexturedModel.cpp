@@ -15,6 +15,10 @@ TexturedModel::TexturedModel(RawModel* model, ModelTexture* texture)
 	//Copy over the RawModel data
 	this->rawModel.setVaoID(model->getVaoID());
 	this->rawModel.setVertexCount(model->getVertexCount());
+	this->rawModel.setFirstIndex(model->getFirstIndex());
+	this->rawModel.setIndexType(model->getIndexType());
+	this->rawModel.setCenter(model->getCenter());
+	this->rawModel.setRadius(model->getRadius());
 
 	std::list<GLuint>* myVBOs = this->rawModel.getVboIDs();
 	std::list<GLuint>* theirVBOs = model->getVboIDs();
@@ -33,6 +37,8 @@ TexturedModel::TexturedModel(RawModel* model, ModelTexture* texture)
 	this->texture.setGlowAmount(texture->getGlowAmount());
 	this->texture.setScrollX(texture->getScrollX());
 	this->texture.setScrollY(texture->getScrollY());
+	this->texture.setUsesTextureArray(texture->getUsesTextureArray());
+	this->texture.setTextureLayer(texture->getTextureLayer());
 }
 
 RawModel* TexturedModel::getRawModel()
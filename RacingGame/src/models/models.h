@@ -6,13 +6,18 @@
 #include <list>
 
 #include "../textures/modeltexture.h"
+#include "../toolbox/vector.h"
 
 class RawModel
 {
 private:
 	GLuint vaoID;
 	int vertexCount;
+	int firstIndex;
+	GLenum indexType;
 	std::list<GLuint> vboIDs;
+	Vector3f center;
+	float radius;
 
 public:
 	RawModel();
@@ -25,6 +30,29 @@ public:
 	void setVertexCount(int newCount);
 	int getVertexCount();
 
+	//Models that are batched together share one index buffer, and each
+	// one draws its own range of it starting at firstIndex
+	void setFirstIndex(int newFirstIndex);
+	int getFirstIndex();
+
+	//GL_UNSIGNED_INT, or GL_UNSIGNED_SHORT for models with few enough vertices
+	void setIndexType(GLenum newIndexType);
+	GLenum getIndexType();
+
+	//The byte offset of the first index, for passing to glDrawElements
+	GLvoid* getIndexOffset();
+
+	//Center of the bounding box of the vertices that the indices use, in model space
+	Vector3f* getCenter();
+	void setCenter(Vector3f* newCenter);
+
+	//Radius of the sphere around the center that holds all of the vertices, in model space.
+	//0 means the bounds were never calculated.
+	float getRadius();
+	void setRadius(float newRadius);
+
+	//Models in a batch share the VAO of the first model in the batch, which
+	// is the only one that holds the vbos, so only that one deletes them
 	void deleteMe();
 
 	//for use in textured model constructor only
@@ -0,0 +1,412 @@
+#include "objparser.h"
+#include "../toolbox/mappedfile.h"
+#include "../toolbox/vector.h"
+#include "../engineTester/main.h"
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+
+//Every power of 10 that a double holds exactly
+static const double POWERS_OF_10[23] =
+{
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+ObjLineReader::ObjLineReader(const char* begin, const char* end)
+{
+	this->current = begin;
+	this->lineEnd = begin;
+	this->next = begin;
+	this->end = end;
+}
+
+void ObjLineReader::skipSpaces()
+{
+	while (current < lineEnd && (*current == ' ' || *current == '\t' || *current == '\r'))
+	{
+		current++;
+	}
+}
+
+bool ObjLineReader::nextLine()
+{
+	while (next < end)
+	{
+		current = next;
+		lineEnd = (const char*)memchr(current, '\n', end - current);
+		if (lineEnd == nullptr)
+		{
+			lineEnd = end;
+			next = end;
+		}
+		else
+		{
+			next = lineEnd + 1;
+		}
+
+		skipSpaces();
+		if (current < lineEnd)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ObjLineReader::readKeyword(const char* word)
+{
+	skipSpaces();
+	const char* c = current;
+	while (*word != 0)
+	{
+		if (c >= lineEnd || *c != *word)
+		{
+			return false;
+		}
+		c++;
+		word++;
+	}
+
+	//has to be the whole token, so "v" doesn't match "vt"
+	if (c < lineEnd && *c != ' ' && *c != '\t' && *c != '\r')
+	{
+		return false;
+	}
+
+	current = c;
+	return true;
+}
+
+std::string ObjLineReader::readName()
+{
+	skipSpaces();
+	const char* start = current;
+	while (current < lineEnd && *current != ' ' && *current != '\t' && *current != '\r')
+	{
+		current++;
+	}
+	return std::string(start, current - start);
+}
+
+float ObjLineReader::readFloat()
+{
+	skipSpaces();
+
+	bool negative = false;
+	if (current < lineEnd && (*current == '-' || *current == '+'))
+	{
+		negative = (*current == '-');
+		current++;
+	}
+
+	//Only the first 19 digits fit, the rest only move the decimal point
+	unsigned long long mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	while (current < lineEnd && *current >= '0' && *current <= '9')
+	{
+		if (digits < 19)
+		{
+			mantissa = mantissa*10 + (*current - '0');
+			digits += (mantissa != 0);
+		}
+		else
+		{
+			exponent++;
+		}
+		current++;
+	}
+
+	if (current < lineEnd && *current == '.')
+	{
+		current++;
+		while (current < lineEnd && *current >= '0' && *current <= '9')
+		{
+			if (digits < 19)
+			{
+				mantissa = mantissa*10 + (*current - '0');
+				digits += (mantissa != 0);
+				exponent--;
+			}
+			current++;
+		}
+	}
+
+	if (current < lineEnd && (*current == 'e' || *current == 'E'))
+	{
+		current++;
+		exponent += readInt();
+	}
+
+	double value = (double)mantissa;
+	if (exponent < 0)
+	{
+		value = (exponent >= -22) ? value/POWERS_OF_10[-exponent] : value*pow(10.0, exponent);
+	}
+	else if (exponent > 0)
+	{
+		value = (exponent <= 22) ? value*POWERS_OF_10[exponent] : value*pow(10.0, exponent);
+	}
+
+	return (float)(negative ? -value : value);
+}
+
+int ObjLineReader::readInt()
+{
+	skipSpaces();
+
+	bool negative = false;
+	if (current < lineEnd && (*current == '-' || *current == '+'))
+	{
+		negative = (*current == '-');
+		current++;
+	}
+
+	int value = 0;
+	while (current < lineEnd && *current >= '0' && *current <= '9')
+	{
+		value = value*10 + (*current - '0');
+		current++;
+	}
+
+	return negative ? -value : value;
+}
+
+bool ObjLineReader::isLineDone()
+{
+	skipSpaces();
+	return current >= lineEnd;
+}
+
+bool ObjLineReader::readFaceVertex(int* position, int* texture, int* normal)
+{
+	skipSpaces();
+	if (current >= lineEnd || ((*current < '0' || *current > '9') && *current != '-'))
+	{
+		return false;
+	}
+
+	*position = readInt();
+	*texture = 0;
+	*normal = 0;
+	if (current < lineEnd && *current == '/')
+	{
+		current++;
+		if (current < lineEnd && *current != '/')
+		{
+			*texture = readInt();
+		}
+		if (current < lineEnd && *current == '/')
+		{
+			current++;
+			*normal = readInt();
+		}
+	}
+	return true;
+}
+
+const char* ObjLineReader::getPosition()
+{
+	return current;
+}
+
+bool ObjFile::load(std::string fileName)
+{
+	#ifdef DEV_MODE
+	auto timeStart = std::chrono::high_resolution_clock::now();
+	#endif
+
+	MappedFile file;
+	if (!file.open(fileName))
+	{
+		return false;
+	}
+
+	const char* begin = file.getData();
+	size_t size = file.getSize();
+	const char* end = begin + size;
+
+	int pieceCount = (int)(size/PARALLEL_CHUNK_SIZE);
+	pieceCount = std::min(pieceCount, (int)std::thread::hardware_concurrency());
+	if (pieceCount <= 1)
+	{
+		pieceCount = 1;
+		parseRange(begin, end);
+		resolveRelativeIndices(0, 0, 0);
+	}
+	else
+	{
+		//Each piece starts at the beginning of a line
+		std::vector<const char*> splits;
+		splits.push_back(begin);
+		for (int i = 1; i < pieceCount; i++)
+		{
+			const char* split = std::max(begin + (size*i)/pieceCount, splits.back());
+			split = (const char*)memchr(split, '\n', end - split);
+			splits.push_back((split == nullptr) ? end : split + 1);
+		}
+		splits.push_back(end);
+
+		//This thread does the first piece while the others do the rest
+		std::vector<ObjFile> pieces(pieceCount - 1);
+		std::vector<std::thread> threads;
+		for (int i = 1; i < pieceCount; i++)
+		{
+			threads.push_back(std::thread(&ObjFile::parseRange, &pieces[i - 1], splits[i], splits[i + 1]));
+		}
+		parseRange(splits[0], splits[1]);
+		resolveRelativeIndices(0, 0, 0);
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		for (ObjFile& piece : pieces)
+		{
+			append(&piece);
+		}
+	}
+
+	#ifdef DEV_MODE
+	auto timeEnd = std::chrono::high_resolution_clock::now();
+	std::fprintf(stdout, "OBJ: '%s' (%d KB) parsed on %d threads in %f ms\n",
+		fileName.c_str(), (int)(size/1024), pieceCount,
+		std::chrono::duration<double, std::milli>(timeEnd - timeStart).count());
+	#endif
+
+	return true;
+}
+
+int ObjFile::getFaceCount()
+{
+	return (int)(faceVertices.size()/3);
+}
+
+void ObjFile::parseRange(const char* begin, const char* end)
+{
+	ObjLineReader reader(begin, end);
+	while (reader.nextLine())
+	{
+		if (reader.readKeyword("f"))
+		{
+			//Anything with more than 3 corners becomes a fan of triangles
+			ObjFaceVertex first;
+			ObjFaceVertex previous;
+			ObjFaceVertex corner;
+			int corners = 0;
+			while (reader.readFaceVertex(&corner.position, &corner.texture, &corner.normal))
+			{
+				//Negative indices count back from the last one so far. This piece doesn't
+				// know how many came before it, so they get fixed once the pieces are put together.
+				if (corner.position < 0)
+				{
+					corner.position += (int)positions.size() + 1 - RELATIVE_INDEX_BASE;
+				}
+				if (corner.texture < 0)
+				{
+					corner.texture += (int)textureCoords.size() + 1 - RELATIVE_INDEX_BASE;
+				}
+				if (corner.normal < 0)
+				{
+					corner.normal += (int)normals.size() + 1 - RELATIVE_INDEX_BASE;
+				}
+
+				if (corners == 0)
+				{
+					first = corner;
+				}
+				else if (corners >= 2)
+				{
+					faceVertices.push_back(first);
+					faceVertices.push_back(previous);
+					faceVertices.push_back(corner);
+				}
+				previous = corner;
+				corners++;
+			}
+		}
+		else if (reader.readKeyword("v"))
+		{
+			float x = reader.readFloat();
+			float y = reader.readFloat();
+			float z = reader.readFloat();
+			positions.push_back(Vector3f(x, y, z));
+		}
+		else if (reader.readKeyword("vt"))
+		{
+			float u = reader.readFloat();
+			float v = reader.readFloat();
+			textureCoords.push_back(Vector2f(u, v));
+		}
+		else if (reader.readKeyword("vn"))
+		{
+			float x = reader.readFloat();
+			float y = reader.readFloat();
+			float z = reader.readFloat();
+			normals.push_back(Vector3f(x, y, z));
+		}
+		else if (reader.readKeyword("usemtl"))
+		{
+			ObjMaterialUse use;
+			use.name = reader.readName();
+			use.firstFace = getFaceCount();
+			materials.push_back(use);
+		}
+		else if (reader.readKeyword("mtllib"))
+		{
+			if (mtllib.empty())
+			{
+				mtllib = reader.readName();
+			}
+		}
+	}
+}
+
+void ObjFile::resolveRelativeIndices(int positionOffset, int textureOffset, int normalOffset)
+{
+	for (ObjFaceVertex& corner : faceVertices)
+	{
+		if (corner.position < -RELATIVE_INDEX_BASE/2)
+		{
+			corner.position += RELATIVE_INDEX_BASE + positionOffset;
+		}
+		if (corner.texture < -RELATIVE_INDEX_BASE/2)
+		{
+			corner.texture += RELATIVE_INDEX_BASE + textureOffset;
+		}
+		if (corner.normal < -RELATIVE_INDEX_BASE/2)
+		{
+			corner.normal += RELATIVE_INDEX_BASE + normalOffset;
+		}
+	}
+}
+
+void ObjFile::append(ObjFile* other)
+{
+	int faceOffset = getFaceCount();
+
+	other->resolveRelativeIndices((int)positions.size(), (int)textureCoords.size(), (int)normals.size());
+
+	positions.insert(positions.end(), other->positions.begin(), other->positions.end());
+	textureCoords.insert(textureCoords.end(), other->textureCoords.begin(), other->textureCoords.end());
+	normals.insert(normals.end(), other->normals.begin(), other->normals.end());
+	faceVertices.insert(faceVertices.end(), other->faceVertices.begin(), other->faceVertices.end());
+
+	for (ObjMaterialUse& use : other->materials)
+	{
+		materials.push_back(use);
+		materials.back().firstFace += faceOffset;
+	}
+
+	if (mtllib.empty())
+	{
+		mtllib = other->mtllib;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "vertexcacheoptimizer.h"
+
+#include <vector>
+#include <cmath>
+
+
+float VertexCacheOptimizer::scoreVertex(int cachePosition, int trianglesLeft)
+{
+	//Nothing left to draw with this vertex
+	if (trianglesLeft == 0)
+	{
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+	if (cachePosition >= 0)
+	{
+		if (cachePosition < 3)
+		{
+			//Used by the last triangle. It gets a fixed score so that the next
+			// triangle doesn't always share an edge with the last one.
+			score = 0.75f;
+		}
+		else
+		{
+			float scale = 1.0f/(CACHE_SIZE - 3);
+			score = powf(1.0f - (cachePosition - 3)*scale, 1.5f);
+		}
+	}
+
+	//Vertices with only a few triangles left get finished off first
+	score += 2.0f*powf((float)trianglesLeft, -0.5f);
+
+	return score;
+}
+
+void VertexCacheOptimizer::optimize(std::vector<int>* indices, int vertexCount)
+{
+	int triangleCount = (int)indices->size()/3;
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	std::vector<int> trianglesLeft(vertexCount, 0);
+	for (int index : (*indices))
+	{
+		trianglesLeft[index]++;
+	}
+
+	//The triangles that use each vertex, as one range of vertexTriangles per vertex.
+	//Triangles that get added are moved past the end of the range.
+	std::vector<int> firstTriangle(vertexCount + 1, 0);
+	for (int v = 0; v < vertexCount; v++)
+	{
+		firstTriangle[v + 1] = firstTriangle[v] + trianglesLeft[v];
+	}
+	std::vector<int> vertexTriangles(indices->size());
+	std::vector<int> fill(firstTriangle.begin(), firstTriangle.end() - 1);
+	for (int i = 0; i < (int)indices->size(); i++)
+	{
+		vertexTriangles[fill[(*indices)[i]]++] = i/3;
+	}
+
+	std::vector<int> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScore(vertexCount);
+	for (int v = 0; v < vertexCount; v++)
+	{
+		vertexScore[v] = scoreVertex(-1, trianglesLeft[v]);
+	}
+
+	int bestTriangle = -1;
+	float bestScore = -1.0f;
+	std::vector<float> triangleScore(triangleCount);
+	std::vector<bool> triangleAdded(triangleCount, false);
+	for (int t = 0; t < triangleCount; t++)
+	{
+		int* triangle = &(*indices)[t*3];
+		triangleScore[t] = vertexScore[triangle[0]] + vertexScore[triangle[1]] + vertexScore[triangle[2]];
+		if (triangleScore[t] > bestScore)
+		{
+			bestScore = triangleScore[t];
+			bestTriangle = t;
+		}
+	}
+
+	std::vector<int> cache;
+	std::vector<int> newCache;
+	cache.reserve(CACHE_SIZE + 3);
+	newCache.reserve(CACHE_SIZE + 3);
+
+	std::vector<int> newIndices;
+	newIndices.reserve(indices->size());
+
+	int nextUnadded = 0;
+	for (int added = 0; added < triangleCount; added++)
+	{
+		if (bestTriangle < 0)
+		{
+			//None of the vertices in the cache have triangles left, so start
+			// again from the first triangle that hasn't been added
+			while (triangleAdded[nextUnadded])
+			{
+				nextUnadded++;
+			}
+			bestTriangle = nextUnadded;
+		}
+
+		int* triangle = &(*indices)[bestTriangle*3];
+		triangleAdded[bestTriangle] = true;
+
+		newCache.clear();
+		for (int c = 0; c < 3; c++)
+		{
+			int v = triangle[c];
+			newIndices.push_back(v);
+			newCache.push_back(v);
+
+			int* remaining = &vertexTriangles[firstTriangle[v]];
+			int count = trianglesLeft[v];
+			for (int i = 0; i < count; i++)
+			{
+				if (remaining[i] == bestTriangle)
+				{
+					remaining[i] = remaining[count - 1];
+					remaining[count - 1] = bestTriangle;
+					break;
+				}
+			}
+			trianglesLeft[v]--;
+		}
+
+		//Everything that was in the cache moves back behind the new triangle
+		for (int v : cache)
+		{
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+			{
+				newCache.push_back(v);
+			}
+		}
+
+		//Vertices past the end of the cache fall out of it, but their triangles still need new scores
+		for (int i = 0; i < (int)newCache.size(); i++)
+		{
+			int v = newCache[i];
+			cachePosition[v] = (i < CACHE_SIZE) ? i : -1;
+			vertexScore[v] = scoreVertex(cachePosition[v], trianglesLeft[v]);
+		}
+
+		bestTriangle = -1;
+		bestScore = -1.0f;
+		for (int v : newCache)
+		{
+			for (int i = firstTriangle[v]; i < firstTriangle[v] + trianglesLeft[v]; i++)
+			{
+				int t = vertexTriangles[i];
+				int* other = &(*indices)[t*3];
+				triangleScore[t] = vertexScore[other[0]] + vertexScore[other[1]] + vertexScore[other[2]];
+				if (triangleScore[t] > bestScore)
+				{
+					bestScore = triangleScore[t];
+					bestTriangle = t;
+				}
+			}
+		}
+
+		if ((int)newCache.size() > CACHE_SIZE)
+		{
+			newCache.resize(CACHE_SIZE);
+		}
+		cache.swap(newCache);
+	}
+
+	indices->swap(newIndices);
+}
+
+float VertexCacheOptimizer::calculateAcmr(std::vector<int>* indices, int vertexCount, int cacheSize)
+{
+	int triangleCount = (int)indices->size()/3;
+	if (triangleCount == 0)
+	{
+		return 0.0f;
+	}
+
+	//When each vertex last went into the cache, as a count of misses
+	std::vector<int> timeAdded(vertexCount, -cacheSize - 1);
+	int misses = 0;
+	for (int index : (*indices))
+	{
+		if (misses - timeAdded[index] > cacheSize)
+		{
+			timeAdded[index] = misses;
+			misses++;
+		}
+	}
+
+	return (float)misses/triangleCount;
+}
\ No newline at end of file
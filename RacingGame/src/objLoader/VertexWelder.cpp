@@ -0,0 +1,74 @@
+#include "vertexwelder.h"
+
+#include <vector>
+
+
+VertexWelder::VertexWelder(int expectedVertexCount)
+{
+	//Keep the table at most half full
+	unsigned int size = 64;
+	while (size < (unsigned int)expectedVertexCount*2)
+	{
+		size *= 2;
+	}
+
+	table.assign(size, -1);
+	mask = size - 1;
+	vertices.reserve(expectedVertexCount);
+}
+
+unsigned int VertexWelder::hash(int position, int texture, int normal)
+{
+	unsigned int h = (unsigned int)position*73856093u;
+	h ^= (unsigned int)texture*19349663u;
+	h ^= (unsigned int)normal*83492791u;
+	return h ^ (h >> 16);
+}
+
+int VertexWelder::weld(int position, int texture, int normal)
+{
+	unsigned int slot = hash(position, texture, normal) & mask;
+	while (table[slot] != -1)
+	{
+		WeldedVertex* vertex = &vertices[table[slot]];
+		if (vertex->position == position &&
+			vertex->texture  == texture &&
+			vertex->normal   == normal)
+		{
+			return table[slot];
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	int index = (int)vertices.size();
+	WeldedVertex newVertex;
+	newVertex.position = position;
+	newVertex.texture = texture;
+	newVertex.normal = normal;
+	vertices.push_back(newVertex);
+	table[slot] = index;
+
+	if (vertices.size()*2 > table.size())
+	{
+		grow();
+	}
+
+	return index;
+}
+
+void VertexWelder::grow()
+{
+	table.assign(table.size()*2, -1);
+	mask = (unsigned int)table.size() - 1;
+
+	for (int i = 0; i < (int)vertices.size(); i++)
+	{
+		WeldedVertex* vertex = &vertices[i];
+		unsigned int slot = hash(vertex->position, vertex->texture, vertex->normal) & mask;
+		while (table[slot] != -1)
+		{
+			slot = (slot + 1) & mask;
+		}
+		table[slot] = i;
+	}
+}
\ No newline at end of file
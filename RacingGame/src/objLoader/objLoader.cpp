@@ -5,6 +5,9 @@
 #include <iostream>
 #include <vector>
 #include <list>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
 
 //#include <ctime>
 
@@ -12,43 +15,115 @@
 #include "../models/models.h"
 #include "../renderEngine/renderEngine.h"
 #include "../toolbox/vector.h"
-#include "vertex.h"
+#include "vertexwelder.h"
+#include "vertexcacheoptimizer.h"
 #include "../engineTester/main.h"
-#include "../toolbox/split.h"
 #include "../collision/collisionmodel.h"
 #include "../collision/triangle3d.h"
 #include "fakeTexture.h"
+#include "objparser.h"
+#include "../toolbox/mappedfile.h"
 
 void parseMtl(std::string filePath, std::string fileName);
 
-void processVertex(char** vertex,
-	std::vector<Vertex*>* vertices,
+//The indices start at 1, like in the files
+void processVertex(int, int, int,
+	VertexWelder* welder,
 	std::vector<int>* indices);
 
-void processVertexBinary(int, int, int,
-	std::vector<Vertex*>* vertices,
-	std::vector<int>* indices);
+//Moves the vertices into the order that the indices first use them, so that the gpu reads the vertex buffer in order
+void reorderVertices(std::vector<WeldedVertex>* vertices, std::vector<std::vector<int>>* materialIndices);
+
+void convertDataToInterleavedArray(std::vector<WeldedVertex>* vertices, std::vector<Vector3f>* positions, std::vector<Vector2f>* textures,
+	std::vector<Vector3f>* normals, std::vector<float>* interleavedArray);
+
+void addTextureLayers(std::vector<float>* interleavedArray, std::vector<std::vector<int>>* materialIndices);
+
+void createTexturedModels(std::list<TexturedModel*>* models, std::vector<WeldedVertex>* vertices,
+	std::vector<Vector3f>* positions, std::vector<Vector2f>* textures, std::vector<Vector3f>* normals, std::vector<std::vector<int>>* materialIndices);
+
+void createTexturedModelsInterleaved(std::list<TexturedModel*>* models, std::vector<float>* interleavedArray,
+	std::vector<std::vector<int>>* materialIndices);
+
+void createObjTexturedModels(std::list<TexturedModel*>* models, ObjFile* obj);
+
+//Adds the material with the given name from the last mtl file to the model being loaded
+void useMaterial(std::string name);
+
+void clearMaterials();
 
-void dealWithAlreadyProcessedVertex(Vertex*, 
-	int, 
-	int, 
-	std::vector<int>*, 
-	std::vector<Vertex*>*);
+//Reads the collision types, sounds and particles of each material. Returns false if the file couldn't be opened.
+bool parseCollisionMtl(std::string fileName, std::list<FakeTexture>* fakeTextures);
 
-void removeUnusedVertices(std::vector<Vertex*>* vertices);
+void loadMaterialTextures(std::vector<std::string>* fileNames, std::vector<ModelTexture>* textures);
 
-void convertDataToArrays(std::vector<Vertex*>* vertices, std::vector<Vector2f>* textures,
-	std::vector<Vector3f>* normals, std::vector<float>* verticesArray, std::vector<float>* texturesArray,
-	std::vector<float>* normalsArray);
+int readCookedModel(std::string filePath, std::string fileName, std::vector<float>* vertices,
+	std::vector<std::vector<int>>* materialIndices, std::vector<ModelTexture>* textures, std::vector<std::string>* textureFileNames);
 
 std::vector<ModelTexture> modelTextures;
 
 std::vector<ModelTexture> modelTexturesList;
 std::vector<std::string> textureNamesList;
 
+//Image file of each texture, in the same order as modelTextures and modelTexturesList
+std::vector<std::string> modelTextureFileNames;
+std::vector<std::string> textureFileNamesList;
+
+bool packTexturesIntoArrays = false;
+
+//When cooking, the source files are only parsed. No textures get loaded and nothing
+// goes to the gpu, the final vertices, indices and materials are kept here instead.
+bool cookingModel = false;
+std::vector<float> cookedVertices;
+std::vector<std::vector<int>> cookedIndices;
+std::vector<ModelTexture> cookedTextures;
+std::vector<std::string> cookedTextureFileNames;
+
+//Files the package was cooked from (relative to the model's folder), and their hashes
+std::vector<std::string> cookedSourceFileNames;
+std::vector<unsigned long long> cookedSourceHashes;
+
+const int COOKED_MODEL_VERSION = 2;
+
+static unsigned long long hashBytes(const char* bytes, size_t size)
+{
+	//FNV-1a
+	unsigned long long hash = 14695981039346656037ull;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= (unsigned char)bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+//Returns false if the file can't be read
+static bool hashFile(std::string fileName, unsigned long long* hash)
+{
+	MappedFile file;
+	if (!file.open(fileName))
+	{
+		return false;
+	}
+
+	*hash = hashBytes(file.getData(), file.getSize());
+	return true;
+}
+
+void setPackTexturesIntoArrays(bool pack)
+{
+	packTexturesIntoArrays = pack;
+}
+
 
 int loadModel(std::list<TexturedModel*>* models, std::string filePath, std::string fileName)
 {
+	int attemptCooked = loadCookedModel(models, filePath, fileName+".cobj");
+	if (attemptCooked != -1)
+	{
+		return attemptCooked;
+	}
+
 	int attemptBinary = loadBinaryModel(models, filePath, fileName+".binobj");
 	
 	if (attemptBinary == -1)
@@ -97,11 +172,11 @@ int loadBinaryModel(std::list<TexturedModel*>* models, std::string filePath, std
 	std::string line;
 
 	std::string mtlname = "";
-	std::vector<Vertex*>  vertices;
+	std::vector<Vector3f> positions;
 	std::vector<Vector2f> textures;
 	std::vector<Vector3f> normals;
 	std::vector<std::string> indiceMaterials;
-	std::vector<RawModel> rawModelsList;
+	std::vector<std::vector<int>> materialIndices;
 
 	int mtllibLength;
 	fread(&mtllibLength, sizeof(int), 1, file);
@@ -122,9 +197,9 @@ int loadBinaryModel(std::list<TexturedModel*>* models, std::string filePath, std
 		fread(t, sizeof(float), 3, file);
 
 		Vector3f vertex(t[0], t[1], t[2]);
-		Vertex* newVertex = new Vertex((int)vertices.size(), &vertex); INCR_NEW
-		vertices.push_back(newVertex);
+		positions.push_back(vertex);
 	}
+	VertexWelder welder(numVertices);
 
 	int numTexCoords;
 	fread(&numTexCoords, sizeof(int), 1, file);
@@ -163,14 +238,7 @@ int loadBinaryModel(std::list<TexturedModel*>* models, std::string filePath, std
 		}
 		indiceMaterials.push_back(matname);
 
-		for (unsigned int i = 0; i < textureNamesList.size(); i++) //search for the right texture to use based off its name
-		{
-			std::string testName = textureNamesList[i];
-			if (testName == matname) //we've found the right texture!
-			{
-				modelTextures.push_back(modelTexturesList[i]); //put a copy of the texture into modelTextures
-			}
-		}
+		useMaterial(matname);
 
 		std::vector<int> indices;
 		int numFaces;
@@ -181,42 +249,20 @@ int loadBinaryModel(std::list<TexturedModel*>* models, std::string filePath, std
 
 			fread(&f[0], sizeof(int), 9, file);
 
-			processVertexBinary(f[0], f[1], f[2], &vertices, &indices);
-			processVertexBinary(f[3], f[4], f[5], &vertices, &indices);
-			processVertexBinary(f[6], f[7], f[8], &vertices, &indices);
+			processVertex(f[0], f[1], f[2], &welder, &indices);
+			processVertex(f[3], f[4], f[5], &welder, &indices);
+			processVertex(f[6], f[7], f[8], &welder, &indices);
 		}
 
-		//save the model we've been building so far...
-		removeUnusedVertices(&vertices);
-
-		std::vector<float> verticesArray;
-		std::vector<float> texturesArray;
-		std::vector<float> normalsArray;
-		convertDataToArrays(&vertices, &textures, &normals, &verticesArray, &texturesArray, &normalsArray);
-		rawModelsList.push_back(Loader::loadToVAO(&verticesArray, &texturesArray, &normalsArray, &indices));
+		//save the indices of the model we've been building so far...
+		materialIndices.push_back(indices);
 	}
 
 	fclose(file);
 
-	//go through rawModelsList and modelTextures to construct and add to the given TexturedModel list
-	for (unsigned int i = 0; i < rawModelsList.size(); i++)
-	{
-		TexturedModel* tm = new TexturedModel(&rawModelsList[i], &modelTextures[i]); INCR_NEW
-		models->push_back(tm);
-	}
-
-	for (auto vertex : vertices)
-	{
-		delete vertex; INCR_DEL
-	}
-
-	modelTextures.clear();
-	modelTexturesList.clear();
-	textureNamesList.clear();
+	createTexturedModels(models, &welder.vertices, &positions, &textures, &normals, &materialIndices);
 
-	modelTextures.shrink_to_fit();
-	modelTexturesList.shrink_to_fit();
-	textureNamesList.shrink_to_fit();
+	clearMaterials();
 
 	return 0;
 }
@@ -228,166 +274,19 @@ int loadObjModel(std::list<TexturedModel*>* models, std::string filePath, std::s
 		return 1;
 	}
 
-	std::ifstream file(filePath+fileName);
-	if (!file.is_open())
+	ObjFile obj;
+	if (!obj.load(filePath+fileName))
 	{
 		//std::fprintf(stdout, "Error: Cannot load file '%s'\n", (filePath + fileName).c_str());
-		file.close();
 		return -1;
 	}
 
-	std::string line;
-
-	std::vector<Vertex*> vertices;
-	std::vector<Vector2f> textures;
-	std::vector<Vector3f> normals;
-	std::vector<int> indices;
-
-	std::vector<RawModel> rawModelsList;
-
-	int foundFaces = 0;
-
-
-	//clock_t t;
-	//t = clock();
-	//printf("Calculating total...\n");
-
-	while (!file.eof())
-	{
-		getline(file, line);
-
-		char lineBuf[256];
-		memcpy(lineBuf, line.c_str(), line.size()+1);
-
-		int splitLength = 0;
-		char** lineSplit = split(lineBuf, ' ', &splitLength);
-
-		if (splitLength > 0)
-		{
-			if (foundFaces == 0)
-			{
-				//Find the mtl filename
-				if (strcmp(lineSplit[0], "mtllib") == 0)
-				{
-					parseMtl(filePath, lineSplit[1]);
-				}
-				else if (strcmp(lineSplit[0], "v") == 0)
-				{
-					std::string p1(lineSplit[1]);
-					std::string p2(lineSplit[2]);
-					std::string p3(lineSplit[3]);
-					Vector3f vertex(std::stof(p1, nullptr), std::stof(p2, nullptr), std::stof(p3, nullptr));
-					Vertex* newVertex = new Vertex((int)vertices.size(), &vertex); INCR_NEW
-					vertices.push_back(newVertex);
-				}
-				else if (strcmp(lineSplit[0], "vt") == 0)
-				{
-					std::string t1(lineSplit[1]);
-					std::string t2(lineSplit[2]);
-					Vector2f texCoord(std::stof(t1, nullptr), std::stof(t2, nullptr));
-					textures.push_back(texCoord);
-				}
-				else if (strcmp(lineSplit[0], "vn") == 0)
-				{
-					std::string n1(lineSplit[1]);
-					std::string n2(lineSplit[2]);
-					std::string n3(lineSplit[3]);
-					Vector3f normal(std::stof(n1, nullptr), std::stof(n2, nullptr), std::stof(n3, nullptr));
-					normals.push_back(normal);
-				}
-				else if (strcmp(lineSplit[0], "usemtl") == 0) //first usetml found, before any faces entered
-				{
-					for (unsigned int i = 0; i < textureNamesList.size(); i++) //search for the right texture to use based off its name
-					{
-						std::string testName = textureNamesList[i];
-						if (testName == lineSplit[1]) //we've found the right texture!
-						{
-							modelTextures.push_back(modelTexturesList[i]); //put a copy of the texture into modelTextures
-						}
-					}
-				}
-				else if (strcmp(lineSplit[0], "f") == 0)
-				{
-					foundFaces = 1;
-				}
-			}
-
-			if (foundFaces == 1)
-			{
-				if (strcmp(lineSplit[0], "f") == 0)
-				{
-					int dummy = 0;
-					char** vertex1 = split(lineSplit[1], '/', &dummy);
-					char** vertex2 = split(lineSplit[2], '/', &dummy);
-					char** vertex3 = split(lineSplit[3], '/', &dummy);
-
-					processVertex(vertex1, &vertices, &indices);
-					processVertex(vertex2, &vertices, &indices);
-					processVertex(vertex3, &vertices, &indices);
-
-					free(vertex1);
-					free(vertex2);
-					free(vertex3);
-				}
-				else if (strcmp(lineSplit[0], "usemtl") == 0 && (vertices.size() > 0)) //found another new material, so save the previous model and start a new one
-				{
-					for (unsigned int i = 0; i < textureNamesList.size(); i++) //search for the right texture to use based off its name
-					{
-						std::string testName = textureNamesList[i];
-						if (testName == lineSplit[1]) //we've found the right texture!
-						{
-							modelTextures.push_back(modelTexturesList[i]); //put a copy of the texture into modelTextures
-						}
-					}
-
-					//save the model we've been building so far...
-					removeUnusedVertices(&vertices);
-					std::vector<float> verticesArray;
-					std::vector<float> texturesArray;
-					std::vector<float> normalsArray;
-
-					convertDataToArrays(&vertices, &textures, &normals, &verticesArray, &texturesArray, &normalsArray);
-					rawModelsList.push_back(Loader::loadToVAO(&verticesArray, &texturesArray, &normalsArray, &indices));
-
-					indices.clear();
-				}
-			}
-		}
-		free(lineSplit);
-	}
-	file.close();
-
-	//t = clock() - t;
-	//printf("Total: It took me %d clicks (%f seconds).\n", t, ((float)t) / CLOCKS_PER_SEC);
-
-	removeUnusedVertices(&vertices);
-
-	std::vector<float> verticesArray;
-	std::vector<float> texturesArray;
-	std::vector<float> normalsArray;
-
-	convertDataToArrays(&vertices, &textures, &normals, &verticesArray, &texturesArray, &normalsArray);
-	rawModelsList.push_back(Loader::loadToVAO(&verticesArray, &texturesArray, &normalsArray, &indices));
-
-	//go through rawModelsList and modelTextures to construct and add to the given TexturedModel list
-	for (unsigned int i = 0; i < rawModelsList.size(); i++)
-	{
-		TexturedModel* tm = new TexturedModel(&rawModelsList[i], &modelTextures[i]); INCR_NEW
-		models->push_back(tm);
-	}
-
-	for (auto vertex : vertices)
+	if (!obj.mtllib.empty())
 	{
-		delete vertex; INCR_DEL
+		parseMtl(filePath, obj.mtllib);
 	}
 
-	modelTextures.clear();
-	modelTexturesList.clear();
-	textureNamesList.clear();
-
-	modelTextures.shrink_to_fit();
-	modelTexturesList.shrink_to_fit();
-	textureNamesList.shrink_to_fit();
+	createObjTexturedModels(models, &obj);
 
 	return 0;
 }
@@ -396,24 +295,25 @@ void parseMtl(std::string filePath, std::string fileName)
 {
 	//array that obj will fill in, using our generated arrays
 	modelTextures.clear();
+	modelTextureFileNames.clear();
 
 	//arrays that we fill in, from the mtl file
 	modelTexturesList.clear();
 	textureNamesList.clear();
+	textureFileNamesList.clear();
 
-	std::ifstream file(filePath+fileName);
-	if (!file.is_open())
+	MappedFile file;
+	if (!file.open(filePath+fileName))
 	{
 		std::fprintf(stderr, "Error: Cannot load file '%s'\n", (filePath + fileName).c_str());
-		file.close();
 		return;
 	}
 
-	//clock_t t;
-	//t = clock();
-	//printf("Calculating MTL...\n");
-
-	std::string line;
+	if (cookingModel)
+	{
+		cookedSourceFileNames.push_back(fileName);
+		cookedSourceHashes.push_back(hashBytes(file.getData(), file.getSize()));
+	}
 
 	//default values
 	float currentShineDamperValue = 20.0f;
@@ -424,248 +324,131 @@ void parseMtl(std::string filePath, std::string fileName)
 	float currentScrollXValue = 0.0f;
 	float currentScrollYValue = 0.0f;
 
-	while (!file.eof())
-	{
-		getline(file, line);
-
-		char lineBuf[256];
-		memcpy(lineBuf, line.c_str(), line.size()+1);
+	//the textures are loaded all at once after the whole file is read
+	std::vector<std::string> textureFileNames;
 
-		int splitLength = 0;
-		char** lineSplit = split(lineBuf, ' ', &splitLength);
-
-		if (splitLength > 0)
+	ObjLineReader reader(file.getData(), file.getData() + file.getSize());
+	while (reader.nextLine())
+	{
+		if (reader.readKeyword("newmtl")) //new material found, add its name to array
 		{
-			if (strcmp(lineSplit[0], "newmtl") == 0) //new material found, add its name to array
-			{
-				textureNamesList.push_back(lineSplit[1]);
-				currentShineDamperValue = 0.0f;
-				currentReflectivityValue = 0.0f;
-				currentTransparencyValue = 1.0f;
-				currentFakeLightingValue = 1.0f;
-				currentGlowAmountValue = 0.0f;
-				currentScrollXValue = 0.0f;
-				currentScrollYValue = 0.0f;
-			}
-			else if (strcmp(lineSplit[0], "\tmap_Kd") == 0 || strcmp(lineSplit[0], "map_Kd") == 0) //end of material found, generate it with all its attrributes
-			{
-				std::string imageFilenameString = filePath+lineSplit[1];
-				char* fname = (char*)imageFilenameString.c_str();
-				ModelTexture newTexture(Loader::loadTexture(fname)); //generate new texture
-				newTexture.setShineDamper(currentShineDamperValue);
-				newTexture.setReflectivity(currentReflectivityValue);
-				newTexture.setHasTransparency(1);
-				newTexture.setUsesFakeLighting(0);
-				if (currentTransparencyValue > 0.0f)
-				{
-					newTexture.setHasTransparency(0);
-				}
-				if (currentFakeLightingValue < 1.0f)
-				{
-					newTexture.setUsesFakeLighting(1);
-				}
-				newTexture.setGlowAmount(currentGlowAmountValue);
-				newTexture.setScrollX(currentScrollXValue);
-				newTexture.setScrollY(currentScrollYValue);
-				modelTexturesList.push_back(newTexture); //put a copy of newTexture into the list
-			}
-			else if (strcmp(lineSplit[0], "\tNs") == 0 || strcmp(lineSplit[0], "Ns") == 0)
-			{
-				currentShineDamperValue = std::stof(lineSplit[1]);
-			}
-			else if (strcmp(lineSplit[0], "\tNi") == 0 || strcmp(lineSplit[0], "Ni") == 0)
-			{
-				currentReflectivityValue = std::stof(lineSplit[1]);
-			}
-			else if (strcmp(lineSplit[0], "\tTr") == 0 || strcmp(lineSplit[0], "Tr") == 0)
-			{
-				currentTransparencyValue = std::stof(lineSplit[1]);
-			}
-			else if (strcmp(lineSplit[0], "\td") == 0 || strcmp(lineSplit[0], "d") == 0)
-			{
-				currentFakeLightingValue = std::stof(lineSplit[1]);
-			}
-			else if (strcmp(lineSplit[0], "\tglow") == 0 || strcmp(lineSplit[0], "glow") == 0)
-			{
-				currentGlowAmountValue = std::stof(lineSplit[1]);
-			}
-			else if (strcmp(lineSplit[0], "\tscrollX") == 0 || strcmp(lineSplit[0], "scrollX") == 0)
+			textureNamesList.push_back(reader.readName());
+			currentShineDamperValue = 0.0f;
+			currentReflectivityValue = 0.0f;
+			currentTransparencyValue = 1.0f;
+			currentFakeLightingValue = 1.0f;
+			currentGlowAmountValue = 0.0f;
+			currentScrollXValue = 0.0f;
+			currentScrollYValue = 0.0f;
+		}
+		else if (reader.readKeyword("map_Kd")) //end of material found, generate it with all its attrributes
+		{
+			ModelTexture newTexture(0);
+			textureFileNames.push_back(filePath+reader.readName());
+			newTexture.setShineDamper(currentShineDamperValue);
+			newTexture.setReflectivity(currentReflectivityValue);
+			newTexture.setHasTransparency(1);
+			newTexture.setUsesFakeLighting(0);
+			if (currentTransparencyValue > 0.0f)
 			{
-				currentScrollXValue = std::stof(lineSplit[1]);
+				newTexture.setHasTransparency(0);
 			}
-			else if (strcmp(lineSplit[0], "\tscrollY") == 0 || strcmp(lineSplit[0], "scrollY") == 0)
+			if (currentFakeLightingValue < 1.0f)
 			{
-				currentScrollYValue = std::stof(lineSplit[1]);
+				newTexture.setUsesFakeLighting(1);
 			}
+			newTexture.setGlowAmount(currentGlowAmountValue);
+			newTexture.setScrollX(currentScrollXValue);
+			newTexture.setScrollY(currentScrollYValue);
+			modelTexturesList.push_back(newTexture); //put a copy of newTexture into the list
+		}
+		else if (reader.readKeyword("Ns"))
+		{
+			currentShineDamperValue = reader.readFloat();
+		}
+		else if (reader.readKeyword("Ni"))
+		{
+			currentReflectivityValue = reader.readFloat();
+		}
+		else if (reader.readKeyword("Tr"))
+		{
+			currentTransparencyValue = reader.readFloat();
+		}
+		else if (reader.readKeyword("d"))
+		{
+			currentFakeLightingValue = reader.readFloat();
+		}
+		else if (reader.readKeyword("glow"))
+		{
+			currentGlowAmountValue = reader.readFloat();
+		}
+		else if (reader.readKeyword("scrollX"))
+		{
+			currentScrollXValue = reader.readFloat();
+		}
+		else if (reader.readKeyword("scrollY"))
+		{
+			currentScrollYValue = reader.readFloat();
 		}
-
-		free(lineSplit);
 	}
 	file.close();
 
-	//t = clock() - t;
-	//printf("MTL: It took me %d clicks (%f seconds).\n", t, ((float)t) / CLOCKS_PER_SEC);
-
+	textureFileNamesList = textureFileNames;
+	loadMaterialTextures(&textureFileNamesList, &modelTexturesList);
 }
 
-
-
-int loadObjModelWithMTL(std::list<TexturedModel*>* models, std::string filePath, std::string fileNameOBJ, std::string fileNameMTL)
+void loadMaterialTextures(std::vector<std::string>* fileNames, std::vector<ModelTexture>* textures)
 {
-	if (models->size() > 0)
-	{
-		return 1;
-	}
-
-	std::ifstream file(filePath + fileNameOBJ);
-	if (!file.is_open())
+	if (cookingModel)
 	{
-		std::fprintf(stderr, "Error: Cannot load file '%s'\n", (filePath + fileNameOBJ).c_str());
-		file.close();
-		return -1;
+		return;
 	}
 
-	std::string line;
-
-	std::vector<Vertex*> vertices;
-	std::vector<Vector2f> textures;
-	std::vector<Vector3f> normals;
-	std::vector<int> indices;
-
-	std::vector<RawModel> rawModelsList;
-
-	int foundFaces = 0;
-
-	parseMtl(filePath, fileNameMTL);
-
-	while (!file.eof())
+	if (packTexturesIntoArrays)
 	{
-		getline(file, line);
-
-		char lineBuf[256];
-		memcpy(lineBuf, line.c_str(), line.size()+1);
-
-		int splitLength = 0;
-		char** lineSplit = split(lineBuf, ' ', &splitLength);
-
-		if (splitLength > 0)
+		std::vector<GLuint> textureIDs;
+		std::vector<int> layers;
+		Loader::loadTexturesPacked(fileNames, &textureIDs, &layers);
+		for (unsigned int i = 0; i < textures->size(); i++)
 		{
-			if (foundFaces == 0)
-			{
-				if (strcmp(lineSplit[0], "v") == 0)
-				{
-					std::string p1(lineSplit[1]);
-					std::string p2(lineSplit[2]);
-					std::string p3(lineSplit[3]);
-					Vector3f vertex(std::stof(p1, nullptr), std::stof(p2, nullptr), std::stof(p3, nullptr));
-					Vertex* newVertex = new Vertex((int)vertices.size(), &vertex);
-					INCR_NEW
-					vertices.push_back(newVertex);
-				}
-				else if (strcmp(lineSplit[0], "vt") == 0)
-				{
-					std::string t1(lineSplit[1]);
-					std::string t2(lineSplit[2]);
-					Vector2f texCoord(std::stof(t1, nullptr), std::stof(t2, nullptr));
-					textures.push_back(texCoord);
-				}
-				else if (strcmp(lineSplit[0], "vn") == 0)
-				{
-					std::string n1(lineSplit[1]);
-					std::string n2(lineSplit[2]);
-					std::string n3(lineSplit[3]);
-					Vector3f normal(std::stof(n1, nullptr), std::stof(n2, nullptr), std::stof(n3, nullptr));
-					normals.push_back(normal);
-				}
-				else if (strcmp(lineSplit[0], "usemtl") == 0) //first usetml found, before any faces entered
-				{
-					for (unsigned int i = 0; i < textureNamesList.size(); i++) //search for the right texture to use based off its name
-					{
-						std::string testName = textureNamesList[i];
-						if (testName == lineSplit[1]) //we've found the right texture!
-						{
-							modelTextures.push_back(modelTexturesList[i]); //put a copy of the texture into modelTextures
-						}
-					}
-				}
-				else if (strcmp(lineSplit[0], "f") == 0)
-				{
-					foundFaces = 1;
-				}
-			}
-
-			if (foundFaces == 1)
+			(*textures)[i].setID(textureIDs[i]);
+			if (layers[i] >= 0)
 			{
-				if (strcmp(lineSplit[0], "f") == 0)
-				{
-					int dummy = 0;
-					char** vertex1 = split(lineSplit[1], '/', &dummy);
-					char** vertex2 = split(lineSplit[2], '/', &dummy);
-					char** vertex3 = split(lineSplit[3], '/', &dummy);
-
-					processVertex(vertex1, &vertices, &indices);
-					processVertex(vertex2, &vertices, &indices);
-					processVertex(vertex3, &vertices, &indices);
-
-					free(vertex1);
-					free(vertex2);
-					free(vertex3);
-				}
-				else if (strcmp(lineSplit[0], "usemtl") == 0 && (vertices.size() > 0)) //found another new material, so save the previous model and start a new one
-				{
-					for (unsigned int i = 0; i < textureNamesList.size(); i++) //search for the right texture to use based off its name
-					{
-						std::string testName = textureNamesList[i];
-						if (testName == lineSplit[1]) //we've found the right texture!
-						{
-							modelTextures.push_back(modelTexturesList[i]); //put a copy of the texture into modelTextures
-						}
-					}
-
-					//save the model we've been building so far...
-					removeUnusedVertices(&vertices);
-					std::vector<float> verticesArray;
-					std::vector<float> texturesArray;
-					std::vector<float> normalsArray;
-
-					convertDataToArrays(&vertices, &textures, &normals, &verticesArray, &texturesArray, &normalsArray);
-					rawModelsList.push_back(Loader::loadToVAO(&verticesArray, &texturesArray, &normalsArray, &indices));
-
-					indices.clear();
-				}
+				(*textures)[i].setUsesTextureArray(1);
+				(*textures)[i].setTextureLayer(layers[i]);
 			}
 		}
-		free(lineSplit);
 	}
-	file.close();
+	else
+	{
+		std::vector<GLuint> textureIDs;
+		Loader::loadTextures(fileNames, &textureIDs);
+		for (unsigned int i = 0; i < textures->size(); i++)
+		{
+			(*textures)[i].setID(textureIDs[i]);
+		}
+	}
+}
 
-	removeUnusedVertices(&vertices);
-	std::vector<float> verticesArray;
-	std::vector<float> texturesArray;
-	std::vector<float> normalsArray;
 
-	convertDataToArrays(&vertices, &textures, &normals, &verticesArray, &texturesArray, &normalsArray);
-	rawModelsList.push_back(Loader::loadToVAO(&verticesArray, &texturesArray, &normalsArray, &indices)); //put a copy of the final model into rawModelsList
 
-	//go through rawModelsList and modelTextures to construct and add to the given TexturedModel list
-	for (unsigned int i = 0; i < rawModelsList.size(); i++)
+int loadObjModelWithMTL(std::list<TexturedModel*>* models, std::string filePath, std::string fileNameOBJ, std::string fileNameMTL)
+{
+	if (models->size() > 0)
 	{
-		TexturedModel* tm = new TexturedModel(&rawModelsList[i], &modelTextures[i]); INCR_NEW
-		models->push_back(tm);
+		return 1;
 	}
 
-	for (auto vertex : vertices)
+	ObjFile obj;
+	if (!obj.load(filePath + fileNameOBJ))
 	{
-		delete vertex; INCR_DEL
+		std::fprintf(stderr, "Error: Cannot load file '%s'\n", (filePath + fileNameOBJ).c_str());
+		return -1;
 	}
 
-	modelTextures.clear();
-	modelTexturesList.clear();
-	textureNamesList.clear();
+	parseMtl(filePath, fileNameMTL);
 
-	modelTextures.shrink_to_fit();
-	modelTexturesList.shrink_to_fit();
-	textureNamesList.shrink_to_fit();
+	createObjTexturedModels(models, &obj);
 
 	return 0;
 }
@@ -700,11 +483,11 @@ int loadBinaryModelWithMTL(std::list<TexturedModel*>* models, std::string filePa
 	std::string line;
 
 	std::string mtlname = "";
-	std::vector<Vertex*>  vertices;
+	std::vector<Vector3f> positions;
 	std::vector<Vector2f> textures;
 	std::vector<Vector3f> normals;
 	std::vector<std::string> indiceMaterials;
-	std::vector<RawModel> rawModelsList;
+	std::vector<std::vector<int>> materialIndices;
 
 	int mtllibLength;
 	fread(&mtllibLength, sizeof(int), 1, file);
@@ -725,9 +508,9 @@ int loadBinaryModelWithMTL(std::list<TexturedModel*>* models, std::string filePa
 		fread(t, sizeof(float), 3, file);
 
 		Vector3f vertex(t[0], t[1], t[2]);
-		Vertex* newVertex = new Vertex((int)vertices.size(), &vertex); INCR_NEW
-		vertices.push_back(newVertex);
+		positions.push_back(vertex);
 	}
+	VertexWelder welder(numVertices);
 
 	int numTexCoords;
 	fread(&numTexCoords, sizeof(int), 1, file);
@@ -766,14 +549,7 @@ int loadBinaryModelWithMTL(std::list<TexturedModel*>* models, std::string filePa
 		}
 		indiceMaterials.push_back(matname);
 
-		for (unsigned int i = 0; i < textureNamesList.size(); i++) //search for the right texture to use based off its name
-		{
-			std::string testName = textureNamesList[i];
-			if (testName == matname) //we've found the right texture!
-			{
-				modelTextures.push_back(modelTexturesList[i]); //put a copy of the texture into modelTextures
-			}
-		}
+		useMaterial(matname);
 
 		std::vector<int> indices;
 		int numFaces;
@@ -784,155 +560,601 @@ int loadBinaryModelWithMTL(std::list<TexturedModel*>* models, std::string filePa
 
 			fread(&f[0], sizeof(int), 9, file);
 
-			processVertexBinary(f[0], f[1], f[2], &vertices, &indices);
-			processVertexBinary(f[3], f[4], f[5], &vertices, &indices);
-			processVertexBinary(f[6], f[7], f[8], &vertices, &indices);
+			processVertex(f[0], f[1], f[2], &welder, &indices);
+			processVertex(f[3], f[4], f[5], &welder, &indices);
+			processVertex(f[6], f[7], f[8], &welder, &indices);
 		}
 
-		//save the model we've been building so far...
-		removeUnusedVertices(&vertices);
-
-		std::vector<float> verticesArray;
-		std::vector<float> texturesArray;
-		std::vector<float> normalsArray;
-		convertDataToArrays(&vertices, &textures, &normals, &verticesArray, &texturesArray, &normalsArray);
-		rawModelsList.push_back(Loader::loadToVAO(&verticesArray, &texturesArray, &normalsArray, &indices));
+		//save the indices of the model we've been building so far...
+		materialIndices.push_back(indices);
 	}
 
 	fclose(file);
 
-	//go through rawModelsList and modelTextures to construct and add to the given TexturedModel list
-	for (unsigned int i = 0; i < rawModelsList.size(); i++)
+	createTexturedModels(models, &welder.vertices, &positions, &textures, &normals, &materialIndices);
+
+	clearMaterials();
+
+	return 0;
+}
+
+//Turns a parsed obj file into the same vertices and material indices that the binary loader makes
+void createObjTexturedModels(std::list<TexturedModel*>* models, ObjFile* obj)
+{
+	VertexWelder welder((int)obj->positions.size());
+
+	//Faces that leave out the texture coords or the normal use the first one
+	if (obj->textureCoords.size() == 0)
 	{
-		TexturedModel* tm = new TexturedModel(&rawModelsList[i], &modelTextures[i]); INCR_NEW
-		models->push_back(tm);
+		obj->textureCoords.push_back(Vector2f(0, 0));
+	}
+	if (obj->normals.size() == 0)
+	{
+		obj->normals.push_back(Vector3f(0, 1, 0));
 	}
 
-	for (auto vertex : vertices)
+	std::vector<int> indices;
+	std::vector<std::vector<int>> materialIndices;
+	unsigned int nextMaterial = 0;
+	int faceCount = obj->getFaceCount();
+	for (int f = 0; f <= faceCount; f++)
 	{
-		delete vertex; INCR_DEL
+		//a material that comes after the first face ends the indices of the one before it
+		while (nextMaterial < obj->materials.size() && obj->materials[nextMaterial].firstFace == f)
+		{
+			if (f > 0)
+			{
+				materialIndices.push_back(indices);
+				indices.clear();
+			}
+			useMaterial(obj->materials[nextMaterial].name);
+			nextMaterial++;
+		}
+
+		if (f < faceCount)
+		{
+			ObjFaceVertex* corners = &obj->faceVertices[f*3];
+			for (int c = 0; c < 3; c++)
+			{
+				processVertex(corners[c].position, std::max(1, corners[c].texture), std::max(1, corners[c].normal), &welder, &indices);
+			}
+		}
 	}
+	materialIndices.push_back(indices);
+
+	createTexturedModels(models, &welder.vertices, &obj->positions, &obj->textureCoords, &obj->normals, &materialIndices);
 
+	clearMaterials();
+}
+
+void useMaterial(std::string name)
+{
+	for (unsigned int i = 0; i < textureNamesList.size(); i++) //search for the right texture to use based off its name
+	{
+		//materials without a map_Kd never got a texture
+		if (textureNamesList[i] == name && i < modelTexturesList.size()) //we've found the right texture!
+		{
+			modelTextures.push_back(modelTexturesList[i]); //put a copy of the texture into modelTextures
+			modelTextureFileNames.push_back(textureFileNamesList[i]);
+		}
+	}
+}
+
+void clearMaterials()
+{
 	modelTextures.clear();
 	modelTexturesList.clear();
 	textureNamesList.clear();
+	modelTextureFileNames.clear();
+	textureFileNamesList.clear();
 
 	modelTextures.shrink_to_fit();
 	modelTexturesList.shrink_to_fit();
 	textureNamesList.shrink_to_fit();
-
-	return 0;
+	modelTextureFileNames.shrink_to_fit();
+	textureFileNamesList.shrink_to_fit();
 }
 
-void processVertex(char** vertex,
-	std::vector<Vertex*>* vertices,
+void processVertex(int vIndex, int tIndex, int nIndex,
+	VertexWelder* welder,
 	std::vector<int>* indices)
 {
-	int index = atoi(vertex[0]) - 1;
-	int textureIndex = atoi(vertex[1]) - 1;
-	int normalIndex = atoi(vertex[2]) - 1;
+	indices->push_back(welder->weld(vIndex - 1, tIndex - 1, nIndex - 1));
+}
+
+void convertDataToInterleavedArray(
+	std::vector<WeldedVertex>* vertices, 
+	std::vector<Vector3f>* positions,
+	std::vector<Vector2f>* textures,
+	std::vector<Vector3f>* normals, 
+	std::vector<float>* interleavedArray)
+{
+	interleavedArray->reserve(vertices->size()*8);
+	for (WeldedVertex& currentVertex : (*vertices))
+	{
+		Vector3f* position = &(*positions)[currentVertex.position];
+		Vector2f* textureCoord = &(*textures)[currentVertex.texture];
+		Vector3f* normalVector = &(*normals)[currentVertex.normal];
+		interleavedArray->push_back(position->x);
+		interleavedArray->push_back(position->y);
+		interleavedArray->push_back(position->z);
+		interleavedArray->push_back(textureCoord->x);
+		interleavedArray->push_back(1 - textureCoord->y);
+		interleavedArray->push_back(normalVector->x);
+		interleavedArray->push_back(normalVector->y);
+		interleavedArray->push_back(normalVector->z);
+	}
+}
 
-	Vertex* currentVertex = (*vertices)[index]; //check bounds on this?
-	if (currentVertex->isSet() == 0)
+//Every material in a file shares the same vertices, so they are uploaded only once
+// into a single interleaved buffer, and each material gets its own range of a single
+// index buffer. Materials that need exactly the same gl state to draw get merged into
+// one range, so that the whole group can be drawn with a single draw call.
+void createTexturedModels(
+	std::list<TexturedModel*>* models, 
+	std::vector<WeldedVertex>* vertices,
+	std::vector<Vector3f>* positions,
+	std::vector<Vector2f>* textures, 
+	std::vector<Vector3f>* normals, 
+	std::vector<std::vector<int>>* materialIndices)
+{
+	#ifdef DEV_MODE
+	auto timeStart = std::chrono::high_resolution_clock::now();
+	int totalTriangles = 0;
+	float totalMissesBefore = 0;
+	float totalMissesAfter = 0;
+	#endif
+
+	for (std::vector<int>& range : (*materialIndices))
 	{
-		currentVertex->setTextureIndex(textureIndex);
-		currentVertex->setNormalIndex(normalIndex);
-		indices->push_back(index);
+		#ifdef DEV_MODE
+		int triangles = (int)range.size()/3;
+		totalTriangles += triangles;
+		totalMissesBefore += triangles*VertexCacheOptimizer::calculateAcmr(&range, (int)vertices->size(), 32);
+		#endif
+
+		VertexCacheOptimizer::optimize(&range, (int)vertices->size());
+
+		#ifdef DEV_MODE
+		totalMissesAfter += triangles*VertexCacheOptimizer::calculateAcmr(&range, (int)vertices->size(), 32);
+		#endif
 	}
-	else
+	reorderVertices(vertices, materialIndices);
+
+	#ifdef DEV_MODE
+	auto timeEnd = std::chrono::high_resolution_clock::now();
+	if (totalTriangles > 0)
 	{
-		dealWithAlreadyProcessedVertex(currentVertex, textureIndex, normalIndex, indices, vertices);
+		std::fprintf(stdout, "Vertex cache: %d vertices, %d triangles, ACMR %f -> %f in %f ms\n",
+			(int)vertices->size(), totalTriangles, totalMissesBefore/totalTriangles, totalMissesAfter/totalTriangles,
+			std::chrono::duration<double, std::milli>(timeEnd - timeStart).count());
+	}
+	#endif
+
+	std::vector<float> interleavedArray;
+	convertDataToInterleavedArray(vertices, positions, textures, normals, &interleavedArray);
+
+	if (cookingModel)
+	{
+		//Materials without a texture never get drawn, so they are left out of the package
+		unsigned int materialCount = (unsigned int)std::min(materialIndices->size(), modelTextures.size());
+		cookedVertices.swap(interleavedArray);
+		cookedIndices.assign(materialIndices->begin(), materialIndices->begin() + materialCount);
+		cookedTextures.assign(modelTextures.begin(), modelTextures.begin() + materialCount);
+		cookedTextureFileNames.assign(modelTextureFileNames.begin(), modelTextureFileNames.begin() + materialCount);
+		return;
 	}
+
+	createTexturedModelsInterleaved(models, &interleavedArray, materialIndices);
 }
 
-void processVertexBinary(int vIndex, int tIndex, int nIndex,
-	std::vector<Vertex*>* vertices,
-	std::vector<int>* indices)
+void createTexturedModelsInterleaved(
+	std::list<TexturedModel*>* models,
+	std::vector<float>* interleavedArray,
+	std::vector<std::vector<int>>* materialIndices)
 {
-	vIndex--;
-	tIndex--;
-	nIndex--;
+	bool hasTextureLayers = false;
+	for (ModelTexture& texture : modelTextures)
+	{
+		if (texture.getUsesTextureArray())
+		{
+			hasTextureLayers = true;
+		}
+	}
 
-	Vertex* currentVertex = (*vertices)[vIndex]; //check bounds on this?
-	if (currentVertex->isSet() == 0)
+	if (hasTextureLayers)
 	{
-		currentVertex->setTextureIndex(tIndex);
-		currentVertex->setNormalIndex(nIndex);
-		indices->push_back(vIndex);
+		addTextureLayers(interleavedArray, materialIndices);
 	}
-	else
+
+	std::vector<ModelTexture> mergedTextures;
+	std::vector<std::vector<int>> mergedIndices;
+	for (unsigned int i = 0; i < materialIndices->size() && i < modelTextures.size(); i++)
+	{
+		unsigned int m = 0;
+		while (m < mergedTextures.size() && !mergedTextures[m].hasSameState(&modelTextures[i]))
+		{
+			m++;
+		}
+
+		if (m == mergedTextures.size())
+		{
+			mergedTextures.push_back(modelTextures[i]);
+			mergedIndices.push_back(std::vector<int>());
+		}
+
+		std::vector<int>* range = &(*materialIndices)[i];
+		mergedIndices[m].insert(mergedIndices[m].end(), range->begin(), range->end());
+	}
+
+	std::vector<RawModel> rawModelsList = Loader::loadToVAOBatch(interleavedArray, &mergedIndices, hasTextureLayers);
+
+	//go through rawModelsList and mergedTextures to construct and add to the given TexturedModel list
+	for (unsigned int i = 0; i < rawModelsList.size(); i++)
 	{
-		dealWithAlreadyProcessedVertex(currentVertex, tIndex, nIndex, indices, vertices);
+		TexturedModel* tm = new TexturedModel(&rawModelsList[i], &mergedTextures[i]); INCR_NEW
+		models->push_back(tm);
 	}
 }
 
-void dealWithAlreadyProcessedVertex(
-	Vertex* previousVertex,
-	int newTextureIndex,
-	int newNormalIndex,
-	std::vector<int>* indices,
-	std::vector<Vertex*>* vertices)
+//Materials that are packed into a texture array need to know which layer to sample
+// from, so each vertex gets the layer of the material that uses it. Vertices that are
+// shared by materials on different layers get duplicated.
+void addTextureLayers(std::vector<float>* interleavedArray, std::vector<std::vector<int>>* materialIndices)
 {
-	if (previousVertex->hasSameTextureAndNormal(newTextureIndex, newNormalIndex))
+	int vertexCount = (int)interleavedArray->size()/8;
+	std::vector<float> layeredArray;
+	layeredArray.reserve(vertexCount*9);
+	for (int v = 0; v < vertexCount; v++)
 	{
-		indices->push_back(previousVertex->getIndex());
+		float* vertex = &(*interleavedArray)[v*8];
+		layeredArray.insert(layeredArray.end(), vertex, vertex+8);
+		layeredArray.push_back(-1.0f);
 	}
-	else
+
+	std::unordered_map<long long, int> duplicates;
+	for (unsigned int i = 0; i < materialIndices->size() && i < modelTextures.size(); i++)
 	{
-		Vertex* anotherVertex = previousVertex->getDuplicateVertex();
-		if (anotherVertex != nullptr)
+		if (!modelTextures[i].getUsesTextureArray())
 		{
-			dealWithAlreadyProcessedVertex(anotherVertex, newTextureIndex, newNormalIndex, indices, vertices);
+			continue;
 		}
-		else
+
+		int layer = modelTextures[i].getTextureLayer();
+		for (int& index : (*materialIndices)[i])
 		{
-			Vertex* duplicateVertex = new Vertex((int)vertices->size(), previousVertex->getPosition()); INCR_NEW
+			float* vertexLayer = &layeredArray[index*9 + 8];
+			if (*vertexLayer < 0.0f)
+			{
+				*vertexLayer = (float)layer;
+			}
+			else if (*vertexLayer != (float)layer)
+			{
+				long long key = (((long long)index) << 16) | layer;
+				auto found = duplicates.find(key);
+				if (found != duplicates.end())
+				{
+					index = found->second;
+				}
+				else
+				{
+					float duplicate[9];
+					memcpy(duplicate, &layeredArray[index*9], 8*sizeof(float));
+					duplicate[8] = (float)layer;
+
+					int newIndex = (int)(layeredArray.size()/9);
+					layeredArray.insert(layeredArray.end(), duplicate, duplicate+9);
+					duplicates[key] = newIndex;
+					index = newIndex;
+				}
+			}
+		}
+	}
 
-			duplicateVertex->setTextureIndex(newTextureIndex);
-			duplicateVertex->setNormalIndex(newNormalIndex);
+	interleavedArray->swap(layeredArray);
+}
 
-			previousVertex->setDuplicateVertex(duplicateVertex);
-			vertices->push_back(duplicateVertex);
-			indices->push_back(duplicateVertex->getIndex());
+void reorderVertices(std::vector<WeldedVertex>* vertices, std::vector<std::vector<int>>* materialIndices)
+{
+	std::vector<int> newIndex(vertices->size(), -1);
+	std::vector<WeldedVertex> reordered;
+	reordered.reserve(vertices->size());
+	for (std::vector<int>& range : (*materialIndices))
+	{
+		for (int& index : range)
+		{
+			if (newIndex[index] == -1)
+			{
+				newIndex[index] = (int)reordered.size();
+				reordered.push_back((*vertices)[index]);
+			}
+			index = newIndex[index];
 		}
 	}
+	vertices->swap(reordered);
 }
 
+//Cooked model packages (.cobj) hold what createTexturedModels would have made out of an
+// .obj or .binobj, so loading one is only a few freads and the upload. Layout:
+//  char[4] "cob\0", int version
+//  int sourceCount, then for each .binobj/.obj/.mtl it was cooked from:
+//   int length, chars of the file name (relative to the model's folder), unsigned long long FNV-1a hash
+//  int vertexCount, then vertexCount*8 floats (position, texture coords, normal)
+//  int materialCount, then for each material:
+//   int length, chars of the image file (relative to the model's folder)
+//   float shineDamper, float reflectivity, int hasTransparency, int usesFakeLighting,
+//   float glowAmount, float scrollX, float scrollY
+//   int indexCount, then indexCount ints
+int loadCookedModel(std::list<TexturedModel*>* models, std::string filePath, std::string fileName)
+{
+	if (models->size() > 0)
+	{
+		return 1;
+	}
 
-void convertDataToArrays(
-	std::vector<Vertex*>* vertices, 
-	std::vector<Vector2f>* textures,
-	std::vector<Vector3f>* normals, 
-	std::vector<float>* verticesArray, 
-	std::vector<float>* texturesArray,
-	std::vector<float>* normalsArray)
+	std::vector<float> vertices;
+	std::vector<std::vector<int>> materialIndices;
+	std::vector<std::string> textureFileNames;
+
+	modelTextures.clear();
+	int result = readCookedModel(filePath, fileName, &vertices, &materialIndices, &modelTextures, &textureFileNames);
+	if (result != 0)
+	{
+		modelTextures.clear();
+		return result;
+	}
+
+	loadMaterialTextures(&textureFileNames, &modelTextures);
+
+	createTexturedModelsInterleaved(models, &vertices, &materialIndices);
+
+	modelTextures.clear();
+	modelTextures.shrink_to_fit();
+
+	return 0;
+}
+
+int readCookedModel(std::string filePath, std::string fileName, std::vector<float>* vertices,
+	std::vector<std::vector<int>>* materialIndices, std::vector<ModelTexture>* textures, std::vector<std::string>* textureFileNames)
 {
-	for (auto currentVertex : (*vertices))
-	{
-		Vector3f* position = currentVertex->getPosition();
-		Vector2f* textureCoord = &(*textures)[currentVertex->getTextureIndex()];
-		Vector3f* normalVector = &(*normals)[currentVertex->getNormalIndex()];
-		verticesArray->push_back(position->x);
-		verticesArray->push_back(position->y);
-		verticesArray->push_back(position->z);
-		texturesArray->push_back(textureCoord->x);
-		texturesArray->push_back(1 - textureCoord->y);
-		normalsArray->push_back(normalVector->x);
-		normalsArray->push_back(normalVector->y);
-		normalsArray->push_back(normalVector->z);
+	FILE* file = nullptr;
+	int err = fopen_s(&file, (filePath+fileName).c_str(), "rb");
+	if (file == nullptr || err != 0)
+	{
+		return -1;
+	}
+
+	char fileType[4];
+	int version = 0;
+	if (fread(fileType, sizeof(char), 4, file) != 4 ||
+		fileType[0] != 'c' ||
+		fileType[1] != 'o' ||
+		fileType[2] != 'b' ||
+		fileType[3] != 0 ||
+		fread(&version, sizeof(int), 1, file) != 1 ||
+		version != COOKED_MODEL_VERSION)
+	{
+		std::fprintf(stdout, "Error: File '%s' is not a valid .cobj file, loading the source instead\n", (filePath+fileName).c_str());
+		fclose(file);
+		return -1;
+	}
+
+	//A package that is older than what it was cooked from is ignored
+	int sourceCount = 0;
+	bool valid = fread(&sourceCount, sizeof(int), 1, file) == 1 && sourceCount > 0;
+	for (int s = 0; valid && s < sourceCount; s++)
+	{
+		int nameLength = 0;
+		valid = fread(&nameLength, sizeof(int), 1, file) == 1 && nameLength > 0;
+		std::string name(valid ? nameLength : 0, ' ');
+		unsigned long long sourceHash = 0;
+		unsigned long long currentHash = 0;
+		valid = valid &&
+			fread(&name[0], sizeof(char), nameLength, file) == (size_t)nameLength &&
+			fread(&sourceHash, sizeof(unsigned long long), 1, file) == 1;
+
+		if (valid && hashFile(filePath+name, &currentHash) && currentHash != sourceHash)
+		{
+			std::fprintf(stdout, "Warning: '%s' has changed since '%s' was cooked, loading the source instead\n",
+				(filePath+name).c_str(), (filePath+fileName).c_str());
+			fclose(file);
+			return -1;
+		}
+	}
+
+	int vertexCount = 0;
+	valid = valid && fread(&vertexCount, sizeof(int), 1, file) == 1 && vertexCount >= 0;
+	if (valid)
+	{
+		vertices->resize(vertexCount*8);
+		valid = vertexCount == 0 || fread(&(*vertices)[0], sizeof(float), vertexCount*8, file) == (size_t)(vertexCount*8);
+	}
+
+	int materialCount = 0;
+	valid = valid && fread(&materialCount, sizeof(int), 1, file) == 1 && materialCount >= 0;
+	for (int m = 0; valid && m < materialCount; m++)
+	{
+		int nameLength = 0;
+		valid = fread(&nameLength, sizeof(int), 1, file) == 1 && nameLength >= 0;
+		std::string name(valid ? nameLength : 0, ' ');
+		valid = valid && (nameLength == 0 || fread(&name[0], sizeof(char), nameLength, file) == (size_t)nameLength);
+
+		float f[2];
+		int t[2];
+		float g[3];
+		valid = valid &&
+			fread(f, sizeof(float), 2, file) == 2 &&
+			fread(t, sizeof(int),   2, file) == 2 &&
+			fread(g, sizeof(float), 3, file) == 3;
+
+		ModelTexture texture(0);
+		texture.setShineDamper(f[0]);
+		texture.setReflectivity(f[1]);
+		texture.setHasTransparency(t[0]);
+		texture.setUsesFakeLighting(t[1]);
+		texture.setGlowAmount(g[0]);
+		texture.setScrollX(g[1]);
+		texture.setScrollY(g[2]);
+
+		int indexCount = 0;
+		valid = valid && fread(&indexCount, sizeof(int), 1, file) == 1 && indexCount >= 0;
+		std::vector<int> indices(valid ? indexCount : 0);
+		valid = valid && (indexCount == 0 || fread(&indices[0], sizeof(int), indexCount, file) == (size_t)indexCount);
+
+		if (valid)
+		{
+			for (int index : indices)
+			{
+				if (index < 0 || index >= vertexCount)
+				{
+					valid = false;
+					break;
+				}
+			}
+		}
+
+		if (valid)
+		{
+			textures->push_back(texture);
+			textureFileNames->push_back(filePath+name);
+			materialIndices->push_back(std::vector<int>());
+			materialIndices->back().swap(indices);
+		}
 	}
+
+	fclose(file);
+
+	if (!valid)
+	{
+		std::fprintf(stdout, "Error: File '%s' is cut off or corrupt, loading the source instead\n", (filePath+fileName).c_str());
+		vertices->clear();
+		materialIndices->clear();
+		textures->clear();
+		textureFileNames->clear();
+		return -1;
+	}
+
+	return 0;
 }
 
-void removeUnusedVertices(std::vector<Vertex*>* vertices)
+int cookModel(std::string filePath, std::string fileName)
 {
-	for (auto vertex : (*vertices))
+	cookingModel = true;
+	cookedVertices.clear();
+	cookedIndices.clear();
+	cookedTextures.clear();
+	cookedTextureFileNames.clear();
+	cookedSourceFileNames.clear();
+	cookedSourceHashes.clear();
+
+	auto parseStart = std::chrono::high_resolution_clock::now();
+
+	std::list<TexturedModel*> noModels;
+	std::string sourceName = fileName+".binobj";
+	int result = loadBinaryModel(&noModels, filePath, sourceName);
+	if (result == -1)
+	{
+		sourceName = fileName+".obj";
+		result = loadObjModel(&noModels, filePath, sourceName);
+	}
+
+	unsigned long long sourceHash = 0;
+	if (result == 0 && hashFile(filePath+sourceName, &sourceHash))
+	{
+		cookedSourceFileNames.push_back(sourceName);
+		cookedSourceHashes.push_back(sourceHash);
+	}
+
+	auto parseEnd = std::chrono::high_resolution_clock::now();
+
+	cookingModel = false;
+
+	if (result != 0)
+	{
+		std::fprintf(stdout, "Error: Cannot cook '%s', no .binobj or .obj could be read\n", (filePath+fileName).c_str());
+		return -1;
+	}
+
+	std::string packageName = filePath+fileName+".cobj";
+	FILE* file = nullptr;
+	int err = fopen_s(&file, packageName.c_str(), "wb");
+	if (file == nullptr || err != 0)
 	{
-		if (vertex->isSet() == 0)
+		std::fprintf(stdout, "Error: Cannot write file '%s'\n", packageName.c_str());
+		return -1;
+	}
+
+	int version = COOKED_MODEL_VERSION;
+	int vertexCount = (int)cookedVertices.size()/8;
+	int materialCount = (int)cookedIndices.size();
+	int sourceCount = (int)cookedSourceFileNames.size();
+	fwrite("cob", sizeof(char), 4, file);
+	fwrite(&version, sizeof(int), 1, file);
+	fwrite(&sourceCount, sizeof(int), 1, file);
+	for (int s = 0; s < sourceCount; s++)
+	{
+		int nameLength = (int)cookedSourceFileNames[s].size();
+		fwrite(&nameLength, sizeof(int), 1, file);
+		fwrite(cookedSourceFileNames[s].c_str(), sizeof(char), nameLength, file);
+		fwrite(&cookedSourceHashes[s], sizeof(unsigned long long), 1, file);
+	}
+	fwrite(&vertexCount, sizeof(int), 1, file);
+	if (vertexCount > 0)
+	{
+		fwrite(&cookedVertices[0], sizeof(float), vertexCount*8, file);
+	}
+	fwrite(&materialCount, sizeof(int), 1, file);
+	for (int m = 0; m < materialCount; m++)
+	{
+		//the package is read from wherever the model is, so the image is stored relative to it
+		std::string name = cookedTextureFileNames[m].substr(filePath.size());
+		int nameLength = (int)name.size();
+		fwrite(&nameLength, sizeof(int), 1, file);
+		fwrite(name.c_str(), sizeof(char), nameLength, file);
+
+		ModelTexture* texture = &cookedTextures[m];
+		float f[2] = {texture->getShineDamper(), texture->getReflectivity()};
+		int   t[2] = {texture->getHasTransparency(), texture->getUsesFakeLighting()};
+		float g[3] = {texture->getGlowAmount(), texture->getScrollX(), texture->getScrollY()};
+		fwrite(f, sizeof(float), 2, file);
+		fwrite(t, sizeof(int),   2, file);
+		fwrite(g, sizeof(float), 3, file);
+
+		int indexCount = (int)cookedIndices[m].size();
+		fwrite(&indexCount, sizeof(int), 1, file);
+		if (indexCount > 0)
 		{
-			vertex->setTextureIndex(0);
-			vertex->setNormalIndex(0);
+			fwrite(&cookedIndices[m][0], sizeof(int), indexCount, file);
 		}
 	}
+	fclose(file);
+
+	//Everything but the gpu upload, which is the same for both
+	auto readStart = std::chrono::high_resolution_clock::now();
+
+	std::vector<float> vertices;
+	std::vector<std::vector<int>> materialIndices;
+	std::vector<ModelTexture> textures;
+	std::vector<std::string> textureFileNames;
+	readCookedModel(filePath, fileName+".cobj", &vertices, &materialIndices, &textures, &textureFileNames);
+
+	auto readEnd = std::chrono::high_resolution_clock::now();
+
+	std::fprintf(stdout, "Cooked '%s': %d vertices, %d materials. Parsing the source took %f ms, reading the package takes %f ms\n",
+		packageName.c_str(), vertexCount, materialCount,
+		std::chrono::duration<double, std::milli>(parseEnd - parseStart).count(),
+		std::chrono::duration<double, std::milli>(readEnd - readStart).count());
+
+	cookedVertices.clear();
+	cookedIndices.clear();
+	cookedTextures.clear();
+	cookedTextureFileNames.clear();
+	cookedSourceFileNames.clear();
+	cookedSourceHashes.clear();
+	cookedVertices.shrink_to_fit();
+	cookedIndices.shrink_to_fit();
+
+	return 0;
 }
 
 CollisionModel* loadCollisionModel(std::string filePath, std::string fileName)
@@ -945,154 +1167,116 @@ CollisionModel* loadCollisionModel(std::string filePath, std::string fileName)
 	char currSound = 0;
 	char currParticle = 0;
 
-	std::ifstream file("res/" + filePath + fileName + ".obj");
-	if (!file.is_open())
+	ObjFile obj;
+	if (!obj.load("res/" + filePath + fileName + ".obj"))
 	{
 		std::fprintf(stdout, "Error: Cannot load file '%s'\n", ("res/" + filePath + fileName + ".obj").c_str());
-		file.close();
 		return collisionModel;
 	}
 
-	std::string line;
+	if (!obj.mtllib.empty())
+	{
+		if (!parseCollisionMtl("res/" + filePath + obj.mtllib, &fakeTextures))
+		{
+			std::fprintf(stdout, "Error: Cannot load file '%s'\n", ("res/" + filePath + obj.mtllib).c_str());
+			return collisionModel;
+		}
+	}
 
-	std::vector<Vector3f> vertices;
+	unsigned int nextMaterial = 0;
+	int faceCount = obj.getFaceCount();
+	for (int f = 0; f < faceCount; f++)
+	{
+		while (nextMaterial < obj.materials.size() && obj.materials[nextMaterial].firstFace == f)
+		{
+			currType = 0;
+			currSound = -1;
+			currParticle = 0;
 
+			for (FakeTexture& dummy : fakeTextures)
+			{
+				if (dummy.name == obj.materials[nextMaterial].name)
+				{
+					currType = dummy.type;
+					currSound = dummy.sound;
+					currParticle = dummy.particle;
+				}
+			}
+			nextMaterial++;
+		}
 
+		ObjFaceVertex* corners = &obj.faceVertices[f*3];
+		Vector3f* vert1 = &obj.positions[corners[0].position - 1];
+		Vector3f* vert2 = &obj.positions[corners[1].position - 1];
+		Vector3f* vert3 = &obj.positions[corners[2].position - 1];
 
-	while (!file.eof())
-	{
-		getline(file, line);
+		Triangle3D* tri = new Triangle3D(vert1, vert2, vert3, currType, currSound, currParticle); INCR_NEW
 
-		char lineBuf[256];
-		memcpy(lineBuf, line.c_str(), line.size()+1);
+		collisionModel->triangles.push_back(tri);
+	}
 
-		int splitLength = 0;
-		char** lineSplit = split(lineBuf, ' ', &splitLength);
+	collisionModel->generateMinMaxValues();
+
+	return collisionModel;
+}
 
-		if (splitLength > 0)
+bool parseCollisionMtl(std::string fileName, std::list<FakeTexture>* fakeTextures)
+{
+	MappedFile file;
+	if (!file.open(fileName))
+	{
+		return false;
+	}
+
+	ObjLineReader reader(file.getData(), file.getData() + file.getSize());
+	while (reader.nextLine())
+	{
+		if (reader.readKeyword("newmtl"))
+		{
+			FakeTexture fktex;
+
+			fktex.name = reader.readName();
+			fakeTextures->push_back(fktex);
+		}
+		else if (fakeTextures->size() == 0)
+		{
+			continue;
+		}
+		else if (reader.readKeyword("type"))
 		{
-			if (strcmp(lineSplit[0], "v") == 0)
+			if (reader.readKeyword("heal"))
 			{
-				Vector3f vertex;
-				vertex.x = std::stof(lineSplit[1]);
-				vertex.y = std::stof(lineSplit[2]);
-				vertex.z = std::stof(lineSplit[3]);
-				vertices.push_back(vertex);
+				fakeTextures->back().type = 1;
 			}
-			else if (strcmp(lineSplit[0], "f") == 0)
+			else if (reader.readKeyword("slip"))
 			{
-				int len = 0;
-				char** vertex1 = split(lineSplit[1], '/', &len);
-				char** vertex2 = split(lineSplit[2], '/', &len);
-				char** vertex3 = split(lineSplit[3], '/', &len);
-
-				Vector3f* vert1 = &vertices[std::stoi(vertex1[0]) - 1];
-				Vector3f* vert2 = &vertices[std::stoi(vertex2[0]) - 1];
-				Vector3f* vert3 = &vertices[std::stoi(vertex3[0]) - 1];
-
-				Triangle3D* tri = new Triangle3D(vert1, vert2, vert3, currType, currSound, currParticle); INCR_NEW
-
-				collisionModel->triangles.push_back(tri);
-
-				free(vertex1);
-				free(vertex2);
-				free(vertex3);
+				fakeTextures->back().type = 2;
 			}
-			else if (strcmp(lineSplit[0], "usemtl") == 0)
+			else if (reader.readKeyword("brake"))
 			{
-				currType = 0;
-				currSound = -1;
-				currParticle = 0;
-
-				for (FakeTexture dummy : fakeTextures)
-				{
-					if (dummy.name == lineSplit[1])
-					{
-						currType = dummy.type;
-						currSound = dummy.sound;
-						currParticle = dummy.particle;
-					}
-				}
+				fakeTextures->back().type = 3;
 			}
-			else if (strcmp(lineSplit[0], "mtllib") == 0)
+			else if (reader.readKeyword("boost"))
 			{
-				std::ifstream fileMTL("res/" + filePath + lineSplit[1]);
-				if (!fileMTL.is_open())
-				{
-					std::fprintf(stdout, "Error: Cannot load file '%s'\n", ("res/" + filePath + lineSplit[1]).c_str());
-					fileMTL.close();
-					file.close();
-					return collisionModel;
-				}
-
-				std::string lineMTL;
-
-				while (!fileMTL.eof())
-				{
-					getline(fileMTL, lineMTL);
-
-					char lineBufMTL[256];
-					memcpy(lineBufMTL, lineMTL.c_str(), lineMTL.size()+1);
-
-					int splitLengthMTL = 0;
-					char** lineSplitMTL = split(lineBufMTL, ' ', &splitLengthMTL);
-
-					if (splitLengthMTL > 1)
-					{
-						if (strcmp(lineSplitMTL[0], "newmtl") == 0)
-						{
-							FakeTexture fktex;
-
-							fktex.name = lineSplitMTL[1];
-							fakeTextures.push_back(fktex);
-						}
-						else if (strcmp(lineSplitMTL[0], "type") == 0 ||
-								 strcmp(lineSplitMTL[0], "\ttype") == 0)
-						{
-							if (strcmp(lineSplitMTL[1], "heal") == 0)
-							{
-								fakeTextures.back().type = 1;
-							}
-							else if (strcmp(lineSplitMTL[1], "slip") == 0)
-							{
-								fakeTextures.back().type = 2;
-							}
-							else if (strcmp(lineSplitMTL[1], "brake") == 0)
-							{
-								fakeTextures.back().type = 3;
-							}
-							else if (strcmp(lineSplitMTL[1], "boost") == 0)
-							{
-								fakeTextures.back().type = 4;
-							}
-							else if (strcmp(lineSplitMTL[1], "wall") == 0)
-							{
-								fakeTextures.back().type = 5;
-							}
-						}
-						else if (strcmp(lineSplitMTL[0], "sound") == 0 ||
-								 strcmp(lineSplitMTL[0], "\tsound") == 0)
-						{
-							fakeTextures.back().sound = (char)round(std::stof(lineSplitMTL[1]));
-						}
-						else if (strcmp(lineSplitMTL[0], "particle") == 0 ||
-								 strcmp(lineSplitMTL[0], "\tparticle") == 0)
-						{
-							fakeTextures.back().particle = (char)round(std::stof(lineSplitMTL[1]));
-						}
-					}
-					free(lineSplitMTL);
-				}
-				fileMTL.close();
+				fakeTextures->back().type = 4;
+			}
+			else if (reader.readKeyword("wall"))
+			{
+				fakeTextures->back().type = 5;
 			}
 		}
-		free(lineSplit);
+		else if (reader.readKeyword("sound"))
+		{
+			fakeTextures->back().sound = (char)round(reader.readFloat());
+		}
+		else if (reader.readKeyword("particle"))
+		{
+			fakeTextures->back().particle = (char)round(reader.readFloat());
+		}
 	}
 	file.close();
 
-	collisionModel->generateMinMaxValues();
-
-	return collisionModel;
+	return true;
 }
 
 CollisionModel* loadBinaryCollisionModel(std::string filePath, std::string fileName)
@@ -1135,75 +1319,11 @@ CollisionModel* loadBinaryCollisionModel(std::string filePath, std::string fileN
 		mtlname = mtlname + nextChar;
 	}
 
+	if (!parseCollisionMtl("res/" + filePath + mtlname, &fakeTextures))
 	{
-		std::ifstream fileMTL("res/" + filePath + mtlname);
-		if (!fileMTL.is_open())
-		{
-			std::fprintf(stdout, "Error: Cannot load file '%s'\n", ("res/" + filePath + mtlname).c_str());
-			fileMTL.close();
-			fclose(file);
-			return collisionModel;
-		}
-
-		std::string lineMTL;
-
-		while (!fileMTL.eof())
-		{
-			getline(fileMTL, lineMTL);
-
-			char lineBufMTL[256];
-			memcpy(lineBufMTL, lineMTL.c_str(), lineMTL.size()+1);
-
-			int splitLengthMTL = 0;
-			char** lineSplitMTL = split(lineBufMTL, ' ', &splitLengthMTL);
-
-			if (splitLengthMTL > 1)
-			{
-				if (strcmp(lineSplitMTL[0], "newmtl") == 0)
-				{
-					FakeTexture fktex;
-
-					fktex.name = lineSplitMTL[1];
-					fakeTextures.push_back(fktex);
-				}
-				else if (strcmp(lineSplitMTL[0], "type") == 0 ||
-						 strcmp(lineSplitMTL[0], "\ttype") == 0)
-				{
-					if (strcmp(lineSplitMTL[1], "heal") == 0)
-					{
-						fakeTextures.back().type = 1;
-					}
-					else if (strcmp(lineSplitMTL[1], "slip") == 0)
-					{
-						fakeTextures.back().type = 2;
-					}
-					else if (strcmp(lineSplitMTL[1], "brake") == 0)
-					{
-						fakeTextures.back().type = 3;
-					}
-					else if (strcmp(lineSplitMTL[1], "boost") == 0)
-					{
-						fakeTextures.back().type = 4;
-					}
-					else if (strcmp(lineSplitMTL[1], "wall") == 0)
-					{
-						fakeTextures.back().type = 5;
-					}
-				}
-				else if (strcmp(lineSplitMTL[0], "sound") == 0 ||
-						 strcmp(lineSplitMTL[0], "\tsound") == 0)
-				{
-					fakeTextures.back().sound = (char)round(std::stof(lineSplitMTL[1]));
-				}
-				else if (strcmp(lineSplitMTL[0], "particle") == 0 ||
-						 strcmp(lineSplitMTL[0], "\tparticle") == 0)
-				{
-					fakeTextures.back().particle = (char)round(std::stof(lineSplitMTL[1]));
-				}
-			}
-			free(lineSplitMTL);
-		}
-		fileMTL.close();
+		std::fprintf(stdout, "Error: Cannot load file '%s'\n", ("res/" + filePath + mtlname).c_str());
+		fclose(file);
+		return collisionModel;
 	}
 
 
@@ -1262,13 +1382,7 @@ CollisionModel* loadBinaryCollisionModel(std::string filePath, std::string fileN
 	}
 	fclose(file);
 
-	modelTextures.clear();
-	modelTexturesList.clear();
-	textureNamesList.clear();
-
-	modelTextures.shrink_to_fit();
-	modelTexturesList.shrink_to_fit();
-	textureNamesList.shrink_to_fit();
+	clearMaterials();
 
 	collisionModel->generateMinMaxValues();
 
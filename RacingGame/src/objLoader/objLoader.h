@@ -7,12 +7,19 @@ class CollisionModel;
 #include <list>
 #include <string>
 
-//Attempts to load a mode as either an OBJ or binary format.
-//Checks for binary file first, then tries OBJ.
+//Attempts to load a mode as either a cooked package, OBJ or binary format.
+//Checks for a cooked package first, then the binary file, then tries OBJ.
 //Each TexturedModel contained within 'models' must be deleted later.
 //Returns 0 if successful, 1 if model is already loaded, -1 if file couldn't be loaded
 int loadModel(std::list<TexturedModel*>* models, std::string filePath, std::string fileName);
 
+//Loads a .cobj package made by cookModel. The vertices and indices in it are
+// already final, so they go straight to the gpu.
+//Each TexturedModel contained within 'models' must be deleted later.
+//Returns 0 if successful, 1 if model is already loaded, -1 if the package is missing,
+// broken, or older than the files it was cooked from
+int loadCookedModel(std::list<TexturedModel*>* models, std::string filePath, std::string fileName);
+
 //Each TexturedModel contained within 'models' must be deleted later.
 //Returns 0 if successful, 1 if model is already loaded, -1 if file couldn't be loaded
 int loadObjModel(std::list<TexturedModel*>* models, std::string filePath, std::string fileName);
@@ -29,6 +36,16 @@ int loadObjModelWithMTL(std::list<TexturedModel*>* models, std::string filePath,
 //Returns 0 if successful, 1 if model is already loaded, -1 if file couldn't be loaded
 int loadBinaryModelWithMTL(std::list<TexturedModel*>* models, std::string filePath, std::string fileNameBin, std::string fileNameMTL);
 
+//When turned on, the textures of models that are loaded afterwards get packed into
+// texture arrays wherever they are the same size, so that the materials that use them
+// can be merged and drawn with a single texture binding. Meant for stage models.
+void setPackTexturesIntoArrays(bool pack);
+
+//Turns filePath+fileName .binobj (or .obj) and its .mtl into filePath+fileName.cobj,
+// which loadModel will pick up from then on. Doesn't need a gl context.
+//Returns 0 if successful, -1 if the source couldn't be read or the package couldn't be written
+int cookModel(std::string filePath, std::string fileName);
+
 //The CollisionModel returned must be deleted later.
 CollisionModel* loadCollisionModel(std::string filePath, std::string fileName);
 
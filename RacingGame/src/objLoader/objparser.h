@@ -0,0 +1,96 @@
+#ifndef OBJPARSER_H
+#define OBJPARSER_H
+
+#include <string>
+#include <vector>
+#include "../toolbox/vector.h"
+
+//Walks through the lines of a text file in memory, reading tokens and
+// numbers in place. Nothing is copied or allocated, except for readName.
+class ObjLineReader
+{
+private:
+	const char* current;
+	const char* lineEnd;
+	const char* next;
+	const char* end;
+
+	void skipSpaces();
+
+public:
+	ObjLineReader(const char* begin, const char* end);
+
+	//Moves to the next line that has something on it. Returns false at the end of the text.
+	bool nextLine();
+
+	//Returns true if the next token on the line is word, and moves past it
+	bool readKeyword(const char* word);
+
+	//Returns the next token on the line, or an empty string if the line is done
+	std::string readName();
+
+	float readFloat();
+
+	int readInt();
+
+	bool isLineDone();
+
+	//Reads one corner of a face as position/texture/normal. Parts that are left
+	// out are 0. Returns false if the line is done.
+	bool readFaceVertex(int* position, int* texture, int* normal);
+
+	//Where the reader is in the text
+	const char* getPosition();
+};
+
+//One corner of a triangle. The indices start at 1, like in the file.
+struct ObjFaceVertex
+{
+	int position;
+	int texture;
+	int normal;
+};
+
+//A material that the faces use, starting at firstFace
+struct ObjMaterialUse
+{
+	std::string name;
+	int firstFace;
+};
+
+//Everything in an obj file. Faces with more than 3 corners are split into triangles.
+class ObjFile
+{
+public:
+	//Files bigger than this get split into pieces that are parsed on their own threads
+	static const int PARALLEL_CHUNK_SIZE = 256*1024;
+
+	std::string mtllib;
+	std::vector<Vector3f> positions;
+	std::vector<Vector2f> textureCoords;
+	std::vector<Vector3f> normals;
+	std::vector<ObjFaceVertex> faceVertices;
+	std::vector<ObjMaterialUse> materials;
+
+	//Returns false if the file couldn't be opened
+	bool load(std::string fileName);
+
+	int getFaceCount();
+
+private:
+	//Negative indices in a face are stored as this much below the index they
+	// point to in the piece, until the piece knows where it starts
+	static const int RELATIVE_INDEX_BASE = 1 << 30;
+
+	//Parses the whole lines between begin and end
+	void parseRange(const char* begin, const char* end);
+
+	//Turns the relative indices of this piece into normal ones, given how many
+	// positions, texture coords and normals came before the piece
+	void resolveRelativeIndices(int positionOffset, int textureOffset, int normalOffset);
+
+	//Adds the contents of a piece that was parsed after this one
+	void append(ObjFile* other);
+};
+
+#endif
\ No newline at end of file
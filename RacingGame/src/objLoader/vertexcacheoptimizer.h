@@ -0,0 +1,27 @@
+#ifndef VERTEXCACHEOPTIMIZER_H
+#define VERTEXCACHEOPTIMIZER_H
+
+#include <vector>
+
+//Reorders the triangles of a model so that the vertices get used again while
+// they are still in the gpu's post transform cache, so that fewer vertices have
+// to go through the vertex shader. This is Tom Forsyth's "Linear-Speed Vertex
+// Cache Optimisation", which scores each vertex by where it is in a simulated
+// LRU cache and by how many triangles still need it, and always adds the
+// triangle with the best score next.
+class VertexCacheOptimizer
+{
+private:
+	static const int CACHE_SIZE = 32;
+
+	static float scoreVertex(int cachePosition, int trianglesLeft);
+
+public:
+	//indices is a triangle list that uses vertices 0 to vertexCount-1
+	static void optimize(std::vector<int>* indices, int vertexCount);
+
+	//Average number of vertices that miss a FIFO cache of the given size per triangle.
+	//Lower is better, 0.5 is about the best possible for a big regular mesh.
+	static float calculateAcmr(std::vector<int>* indices, int vertexCount, int cacheSize);
+};
+#endif
\ No newline at end of file
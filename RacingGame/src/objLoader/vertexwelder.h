@@ -0,0 +1,39 @@
+#ifndef VERTEXWELDER_H
+#define VERTEXWELDER_H
+
+#include <vector>
+
+//One vertex of a model, as indices into the positions, texture coords and normals of the file
+struct WeldedVertex
+{
+	int position;
+	int texture;
+	int normal;
+};
+
+//Gives every different combination of position, texture coords and normal its own vertex.
+//The combinations that have been seen are kept in an open addressing hash table, so
+// finding out if a corner of a face is a new vertex doesn't allocate anything.
+class VertexWelder
+{
+private:
+	//Index into vertices, or -1 if the slot is empty
+	std::vector<int> table;
+	unsigned int mask;
+
+	static unsigned int hash(int position, int texture, int normal);
+
+	//Doubles the size of the table and puts all of the vertices back into it
+	void grow();
+
+public:
+	//The vertices in the order that they were first used
+	std::vector<WeldedVertex> vertices;
+
+	//expectedVertexCount is only a guess of how big the table needs to be
+	VertexWelder(int expectedVertexCount);
+
+	//Returns the index of the vertex with the given indices (starting at 0), adding it if it is new
+	int weld(int position, int texture, int normal);
+};
+#endif
\ No newline at end of file
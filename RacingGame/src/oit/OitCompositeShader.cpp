@@ -0,0 +1,69 @@
+#include "oitcompositeshader.h"
+#include "../renderEngine/renderEngine.h"
+
+#include <glad/glad.h>
+
+OitCompositeShader::OitCompositeShader(const char* vFile, const char* fFile)
+{
+	vertexShaderID = Loader::loadShader(vFile, GL_VERTEX_SHADER);
+	fragmentShaderID = Loader::loadShader(fFile, GL_FRAGMENT_SHADER);
+	programID = glCreateProgram();
+	glAttachShader(programID, vertexShaderID);
+	glAttachShader(programID, fragmentShaderID);
+	bindAttributes();
+	glLinkProgram(programID);
+	glValidateProgram(programID);
+	getAllUniformLocations();
+}
+
+void OitCompositeShader::start()
+{
+	glUseProgram(programID);
+}
+
+void OitCompositeShader::stop()
+{
+	glUseProgram(0);
+}
+
+void OitCompositeShader::cleanUp()
+{
+	stop();
+	glDetachShader(programID, vertexShaderID);
+	glDetachShader(programID, fragmentShaderID);
+	glDeleteShader(vertexShaderID);
+	glDeleteShader(fragmentShaderID);
+	glDeleteProgram(programID);
+}
+
+void OitCompositeShader::connectTextureUnits()
+{
+	loadInt(location_accumTexture, 0);
+	loadInt(location_revealTexture, 1);
+}
+
+void OitCompositeShader::bindAttributes()
+{
+	bindAttribute(0, "position");
+}
+
+void OitCompositeShader::bindAttribute(int attribute, const char* variableName)
+{
+	glBindAttribLocation(programID, attribute, variableName);
+}
+
+void OitCompositeShader::getAllUniformLocations()
+{
+	location_accumTexture = getUniformLocation("accumTexture");
+	location_revealTexture = getUniformLocation("revealTexture");
+}
+
+int OitCompositeShader::getUniformLocation(const char* uniformName)
+{
+	return glGetUniformLocation(programID, uniformName);
+}
+
+void OitCompositeShader::loadInt(int location, int value)
+{
+	glUniform1i(location, value);
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include <glad/glad.h>
+#include <vector>
+
+#include "weightedblendedoit.h"
+#include "oitcompositeshader.h"
+#include "../renderEngine/renderEngine.h"
+#include "../engineTester/main.h"
+
+WeightedBlendedOit::WeightedBlendedOit(int width, int height)
+{
+	this->width = width;
+	this->height = height;
+	this->sceneFrameBuffer = 0;
+
+	createFrameBuffer();
+
+	std::vector<float> positions;
+	positions.push_back(-1); positions.push_back( 1);
+	positions.push_back(-1); positions.push_back(-1);
+	positions.push_back( 1); positions.push_back( 1);
+	positions.push_back( 1); positions.push_back(-1);
+	quadModel = Loader::loadToVAO(&positions, 2);
+
+	shader = new OitCompositeShader("res/Shaders/bloom/simpleVertex.txt", "res/Shaders/oit/compositeFragment.txt"); INCR_NEW
+	shader->start();
+	shader->connectTextureUnits();
+	shader->stop();
+}
+
+void WeightedBlendedOit::createFrameBuffer()
+{
+	glGenFramebuffers(1, &frameBuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+
+	glGenTextures(1, &accumTexture);
+	glBindTexture(GL_TEXTURE_2D, accumTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, accumTexture, 0);
+
+	glGenTextures(1, &revealTexture);
+	glBindTexture(GL_TEXTURE_2D, revealTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, revealTexture, 0);
+
+	glGenRenderbuffers(1, &depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+	GLenum drawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+	glDrawBuffers(2, drawBuffers);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void WeightedBlendedOit::bindFrameBuffer()
+{
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &sceneFrameBuffer);
+
+	//Transparent geometry still has to be hidden behind the opaque scene
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneFrameBuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, frameBuffer);
+	while (glGetError() != GL_NO_ERROR)
+	{
+
+	}
+	glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+	//The depth formats didn't match. Nothing gets hidden then, but at least
+	// it isn't tested against whatever was left in the depth buffer.
+	if (glGetError() != GL_NO_ERROR)
+	{
+		glDepthMask(true);
+		glClear(GL_DEPTH_BUFFER_BIT);
+	}
+
+	const float clearAccum[4]  = {0, 0, 0, 0};
+	const float clearReveal[4] = {1, 1, 1, 1};
+	glClearBufferfv(GL_COLOR, 0, clearAccum);
+	glClearBufferfv(GL_COLOR, 1, clearReveal);
+
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(false);
+	glEnable(GL_BLEND);
+	glBlendFunci(0, GL_ONE, GL_ONE);
+	glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+}
+
+void WeightedBlendedOit::composite()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, sceneFrameBuffer);
+
+	glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
+	glDisable(GL_DEPTH_TEST);
+
+	shader->start();
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, accumTexture);
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, revealTexture);
+
+	glBindVertexArray(quadModel.getVaoID());
+	glEnableVertexAttribArray(0);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	glDisableVertexAttribArray(0);
+	glBindVertexArray(0);
+	shader->stop();
+
+	glEnable(GL_DEPTH_TEST);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void WeightedBlendedOit::cleanUp()
+{
+	shader->cleanUp();
+	delete shader; INCR_DEL
+	glDeleteFramebuffers(1, &frameBuffer);
+	glDeleteTextures(1, &accumTexture);
+	glDeleteTextures(1, &revealTexture);
+	glDeleteRenderbuffers(1, &depthBuffer);
+}
\ No newline at end of file
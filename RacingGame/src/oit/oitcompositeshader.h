@@ -0,0 +1,39 @@
+#ifndef OITCOMPOSITESHADER_H
+#define OITCOMPOSITESHADER_H
+
+#include <glad/glad.h>
+
+class OitCompositeShader
+{
+private:
+	GLuint programID;
+	GLuint vertexShaderID;
+	GLuint fragmentShaderID;
+
+	int location_accumTexture;
+	int location_revealTexture;
+
+public:
+	OitCompositeShader(const char* vFile, const char* fFile);
+
+	void start();
+
+	void stop();
+
+	void cleanUp();
+
+	void connectTextureUnits();
+
+protected:
+	void bindAttributes();
+
+	void bindAttribute(int attribute, const char* variableName);
+
+	void getAllUniformLocations();
+
+	int getUniformLocation(const char* uniformName);
+
+	void loadInt(int location, int value);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef WEIGHTEDBLENDEDOIT_H
+#define WEIGHTEDBLENDEDOIT_H
+
+class OitCompositeShader;
+
+#include <glad/glad.h>
+#include "../models/models.h"
+
+//Weighted blended order independent transparency (McGuire and Bavoil 2013).
+//Transparent geometry is drawn once, in any order, into an accumulation
+// target and a revealage target. Those are then composited over the scene.
+class WeightedBlendedOit
+{
+private:
+	int width;
+	int height;
+
+	GLuint frameBuffer;
+	GLuint accumTexture;
+	GLuint revealTexture;
+	GLuint depthBuffer;
+
+	GLint sceneFrameBuffer;
+
+	RawModel quadModel;
+	OitCompositeShader* shader;
+
+	void createFrameBuffer();
+
+public:
+	WeightedBlendedOit(int width, int height);
+
+	//Copies the depth of the opaque scene over and sets the gl state
+	// for drawing transparent geometry into the OIT targets
+	void bindFrameBuffer();
+
+	//Blends the accumulated transparent geometry over the scene
+	// that was bound when bindFrameBuffer was called
+	void composite();
+
+	void cleanUp();
+};
+#endif
\ No newline at end of file
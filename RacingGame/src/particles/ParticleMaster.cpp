@@ -1,138 +1,328 @@
 #include "particlemaster.h"
-#include "particle.h"
+#include "particlepool.h"
 #include "particlerenderer.h"
 #include "particleshader.h"
 #include "particletexture.h"
+#include "particleresources.h"
 #include "../toolbox/matrix.h"
+#include "../toolbox/vector.h"
 #include "../entities/camera.h"
-#include "insertionsort.h"
 #include "../engineTester/main.h"
 
 #include <unordered_map>
-#include <list>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
-std::unordered_map<ParticleTexture*, std::list<Particle*>> ParticleMaster::particles;
+extern float dt;
+
+#define STRESS_TEST_RATE 100000.0f
+#define STRESS_TEST_LIFE 0.3f
+
+//Pools get split into jobs of this many particles (a multiple of 4 for the SSE update)
+#define UPDATE_CHUNK_SIZE 2048
+#define MAX_UPDATE_WORKERS 3
+
+#define STAT_UPDATE_TIME 0
+
+//A range of one pool for a worker to update
+struct ParticleUpdateJob
+{
+	ParticlePool* pool;
+	int begin;
+	int end;
+};
+
+//The update workers sleep until jobGeneration changes, then take jobs until
+// there are none left. The main thread takes jobs too, then waits until every
+// worker has checked in, so that the job list is never changed under them.
+static std::vector<std::thread*> updateWorkers;
+static std::vector<ParticleUpdateJob> updateJobs;
+static std::mutex updateMutex;
+static std::condition_variable updateJobsReady;
+static std::condition_variable updateJobsDone;
+static std::atomic<int> updateNextJob(0);
+static int updateJobGeneration = 0;
+static int updateWorkersFinished = 0;
+static bool updateWorkersQuit = false;
+static Vector3f updateCameraPosition;
+static float updateDt = 0;
+
+static void runUpdateJobs()
+{
+	while (true)
+	{
+		int index = updateNextJob.fetch_add(1);
+		if (index >= (int)updateJobs.size())
+		{
+			break;
+		}
+
+		ParticleUpdateJob* job = &updateJobs[index];
+		job->pool->updateRange(job->begin, job->end, &updateCameraPosition, updateDt);
+	}
+}
+
+static void updateWorkerLoop()
+{
+	int seenGeneration = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(updateMutex);
+			updateJobsReady.wait(lock, [&]{ return updateWorkersQuit || updateJobGeneration != seenGeneration; });
+			if (updateWorkersQuit)
+			{
+				return;
+			}
+			seenGeneration = updateJobGeneration;
+		}
+
+		runUpdateJobs();
+
+		std::lock_guard<std::mutex> lock(updateMutex);
+		updateWorkersFinished++;
+		if (updateWorkersFinished == (int)updateWorkers.size())
+		{
+			updateJobsDone.notify_one();
+		}
+	}
+}
+
+//Fast xorshift generator for the stress test, so that emitting doesn't get measured as mt19937
+static unsigned int stressTestRandomState = 2463534242u;
+
+static float stressTestRandom()
+{
+	stressTestRandomState ^= stressTestRandomState << 13;
+	stressTestRandomState ^= stressTestRandomState >> 17;
+	stressTestRandomState ^= stressTestRandomState << 5;
+	return (stressTestRandomState >> 8)*(1.0f/16777216.0f);
+}
+
+std::unordered_map<ParticleTexture*, ParticlePool*> ParticleMaster::pools;
 ParticleRenderer* ParticleMaster::renderer = nullptr;
+bool ParticleMaster::stressTest = false;
+float ParticleMaster::stressTestTimer = 0;
+FrameStats ParticleMaster::stats;
 
 void ParticleMaster::init(Matrix4f* projectionMatrix)
 {
 	ParticleMaster::renderer = new ParticleRenderer(projectionMatrix); INCR_NEW
+
+	int workerCount = (int)std::thread::hardware_concurrency() - 1;
+	if (workerCount > MAX_UPDATE_WORKERS)
+	{
+		workerCount = MAX_UPDATE_WORKERS;
+	}
+	for (int i = 0; i < workerCount; i++)
+	{
+		updateWorkers.push_back(new std::thread(updateWorkerLoop)); INCR_NEW
+	}
 }
 
-//There was a crash in here once for some reason... something with 'list'?
 void ParticleMaster::update(Camera* cam)
 {
-	std::unordered_map<ParticleTexture*, std::list<Particle*>>::iterator mapIt = ParticleMaster::particles.begin();
-	bool deletedEntry = false;
-
-	while (mapIt != ParticleMaster::particles.end())
+	#ifdef DEV_MODE
+	auto timeStart = std::chrono::high_resolution_clock::now();
+	if (ParticleMaster::stressTest)
 	{
-		std::list<Particle*>* list = &mapIt->second;
+		ParticleMaster::emitStressTestParticles(cam, dt);
+	}
+	#endif
 
-		std::list<Particle*>::iterator it = list->begin();
+	int totalCount = 0;
+	updateJobs.clear();
+	for (auto& entry : ParticleMaster::pools)
+	{
+		ParticlePool* pool = entry.second;
+		for (int begin = 0; begin < pool->count; begin += UPDATE_CHUNK_SIZE)
+		{
+			ParticleUpdateJob job;
+			job.pool = pool;
+			job.begin = begin;
+			job.end = begin + UPDATE_CHUNK_SIZE < pool->count ? begin + UPDATE_CHUNK_SIZE : pool->count;
+			updateJobs.push_back(job);
+		}
+		totalCount += pool->count;
+	}
 
-		deletedEntry = false;
+	updateCameraPosition.set(&cam->eye);
+	updateDt = dt;
+	updateNextJob = 0;
 
-		while (it != list->end())
+	//Waking the workers costs more than it saves on a single job
+	if (updateWorkers.size() == 0 || updateJobs.size() < 2)
+	{
+		runUpdateJobs();
+	}
+	else
+	{
 		{
-			Particle* p = *it;
-
-			bool stillAlive = p->update(cam);
-			if (stillAlive == false)
-			{
-				delete p; INCR_DEL //maybe switch this with next line?
-				it = list->erase(it);
-
-				if (list->size() == 0)
-				{
-					mapIt = ParticleMaster::particles.erase(mapIt);
-					deletedEntry = true;
-				}
-			}
-			else
-			{
-				it++;
-			}
+			std::lock_guard<std::mutex> lock(updateMutex);
+			updateWorkersFinished = 0;
+			updateJobGeneration++;
 		}
+		updateJobsReady.notify_all();
+
+		runUpdateJobs();
 
-		if (deletedEntry == false)
+		std::unique_lock<std::mutex> lock(updateMutex);
+		updateJobsDone.wait(lock, []{ return updateWorkersFinished == (int)updateWorkers.size(); });
+	}
+
+	if (totalCount > 0)
+	{
+		for (auto& entry : ParticleMaster::pools)
 		{
-			//InsertionSort::sortHighToLow(list); //Maybe remove this for debug?
-			mapIt++;
+			entry.second->removeDeadParticles();
 		}
 	}
-	/*
-	for (auto entry : particles)
-	{
-		std::list<Particle*>* list = &entry.second;
 
-		for (Particle* particle : (*list))
+	#ifdef DEV_MODE
+	auto timeEnd = std::chrono::high_resolution_clock::now();
+	ParticleMaster::stats.add(STAT_UPDATE_TIME, std::chrono::duration<double, std::milli>(timeEnd - timeStart).count());
+	if (ParticleMaster::stats.endFrame())
+	{
+		int liveParticles = 0;
+		for (auto& entry : ParticleMaster::pools)
 		{
-			bool stillAlive = particle->update(cam);
-			if (stillAlive == false)
-			{
-
-			}
+			liveParticles += entry.second->count;
 		}
+		std::fprintf(stdout, "Particles: %d live, %f ms per update (%supdate on %d threads)\n",
+			liveParticles, ParticleMaster::stats.getAverage(STAT_UPDATE_TIME),
+			ParticleMaster::stressTest ? "stress test emit + " : "", (int)updateWorkers.size() + 1);
+		ParticleMaster::renderer->printSortStats();
+	}
+	#endif
+}
 
-		InsertionSort::sortHighToLow(list);
-	}*/
+void ParticleMaster::emitStressTestParticles(Camera* cam, float dt)
+{
+	ParticleMaster::stressTestTimer += STRESS_TEST_RATE*dt;
+	int toEmit = (int)ParticleMaster::stressTestTimer;
+	ParticleMaster::stressTestTimer -= toEmit;
+
+	Vector3f pos;
+	Vector3f vel;
+	for (int i = 0; i < toEmit; i++)
+	{
+		pos.set(cam->target.x + 20*(stressTestRandom() - 0.5f),
+		        cam->target.y + 20*(stressTestRandom() - 0.5f),
+		        cam->target.z + 20*(stressTestRandom() - 0.5f));
+		vel.set(20*(stressTestRandom() - 0.5f),
+		        20*(stressTestRandom() - 0.5f),
+		        20*(stressTestRandom() - 0.5f));
+		ParticleMaster::createParticle(ParticleResources::textureDust, &pos, &vel, 10.0f, STRESS_TEST_LIFE, 0, 1.0f, -1.0f, false, false);
+	}
 }
 
 void ParticleMaster::renderParticles(Camera* camera, float brightness, int clipSide)
 {
-	ParticleMaster::renderer->render(&ParticleMaster::particles, camera, brightness, clipSide);
+	ParticleMaster::renderer->render(&ParticleMaster::pools, camera, brightness, clipSide);
 }
 
 void ParticleMaster::cleanUp()
 {
 	ParticleMaster::renderer->cleanUp();
+
+	{
+		std::lock_guard<std::mutex> lock(updateMutex);
+		updateWorkersQuit = true;
+	}
+	updateJobsReady.notify_all();
+	for (std::thread* worker : updateWorkers)
+	{
+		worker->join();
+		delete worker; INCR_DEL
+	}
+	updateWorkers.clear();
 }
 
-void ParticleMaster::addParticle(Particle* particle)
+ParticlePool* ParticleMaster::getPool(ParticleTexture* texture)
 {
-	std::list<Particle*>* list = &ParticleMaster::particles[particle->getTexture()];
-	list->push_back(particle);
+	ParticlePool* pool = ParticleMaster::pools[texture];
+	if (pool == nullptr)
+	{
+		pool = new ParticlePool(texture); INCR_NEW
+		ParticleMaster::pools[texture] = pool;
+	}
+	return pool;
 }
 
-void ParticleMaster::updateProjectionMatrix(Matrix4f* projectionMatrix)
+void ParticleMaster::createParticle(int exhaustTextureIndex, Vector3f* position, float lifeLength, float scale, bool onlyRendersOnce)
 {
-	if (ParticleMaster::renderer != nullptr)
+	if (!Global::renderParticles)
 	{
-		ParticleMaster::renderer->updateProjectionMatrix(projectionMatrix);
+		return;
 	}
+
+	Vector3f zero(0, 0, 0);
+	ParticleMaster::getPool(ParticleResources::exhaustTextures[exhaustTextureIndex])->addParticle(
+		position, nullptr, &zero, 0, lifeLength, 0, scale, 0, scale, 0, onlyRendersOnce);
 }
 
-void ParticleMaster::deleteAllParticles()
+void ParticleMaster::createParticle(ParticleTexture* texture, Vector3f* position, Vector3f* velocity, float lifeLength, float scale, bool onlyRendersOnce)
 {
-	std::unordered_map<ParticleTexture*, std::list<Particle*>>::iterator mapIt = ParticleMaster::particles.begin();
-	bool deletedEntry = false;
-
-	while (mapIt != ParticleMaster::particles.end())
+	if (!Global::renderParticles)
 	{
-		std::list<Particle*>* list = &mapIt->second;
+		return;
+	}
+
+	ParticleMaster::getPool(texture)->addParticle(
+		position, nullptr, velocity, 0, lifeLength, 0, scale, 0, scale, 0, onlyRendersOnce);
+}
 
-		std::list<Particle*>::iterator it = list->begin();
+void ParticleMaster::createParticle(ParticleTexture* texture, Vector3f* position, Vector3f* velocity, float gravityEffect,
+	float lifeLength, float rotation, float scale, float scaleChange, bool posIsRef, bool onlyRendersOnce)
+{
+	if (!Global::renderParticles)
+	{
+		return;
+	}
 
-		deletedEntry = false;
+	ParticleMaster::getPool(texture)->addParticle(
+		position, posIsRef ? position : nullptr, velocity, gravityEffect, lifeLength, rotation, scale, scaleChange, scale, scaleChange, onlyRendersOnce);
+}
 
-		while (it != list->end())
-		{
-			Particle* p = *it;
+void ParticleMaster::createParticle(ParticleTexture* texture, Vector3f* position, Vector3f* velocity, float gravityEffect,
+	float lifeLength, float rotation, float scaleX, float scaleXChange, float scaleY, float scaleYChange,
+	bool posIsRef, bool onlyRendersOnce)
+{
+	if (!Global::renderParticles)
+	{
+		return;
+	}
 
-			delete p; INCR_DEL
-			it = list->erase(it);
+	ParticleMaster::getPool(texture)->addParticle(
+		position, posIsRef ? position : nullptr, velocity, gravityEffect, lifeLength, rotation, scaleX, scaleXChange, scaleY, scaleYChange, onlyRendersOnce);
+}
 
-			if (list->size() == 0)
-			{
-				mapIt = ParticleMaster::particles.erase(mapIt);
-				deletedEntry = true;
-			}
-		}
+void ParticleMaster::updateProjectionMatrix(Matrix4f* projectionMatrix)
+{
+	if (ParticleMaster::renderer != nullptr)
+	{
+		ParticleMaster::renderer->updateProjectionMatrix(projectionMatrix);
+	}
+}
 
-		if (deletedEntry == false)
-		{
-			mapIt++;
-		}
+//The pools keep their memory, so that the next level doesn't have to allocate it again
+void ParticleMaster::deleteAllParticles()
+{
+	for (auto& entry : ParticleMaster::pools)
+	{
+		entry.second->clear();
 	}
 }
+
+void ParticleMaster::toggleStressTest()
+{
+	ParticleMaster::stressTest = !ParticleMaster::stressTest;
+	ParticleMaster::stressTestTimer = 0;
+	ParticleMaster::stats.reset();
+	std::fprintf(stdout, "Particle stress test %s\n", ParticleMaster::stressTest ? "on" : "off");
+}
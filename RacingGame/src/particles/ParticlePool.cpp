@@ -0,0 +1,271 @@
+#include "particlepool.h"
+#include "particletexture.h"
+#include "../toolbox/vector.h"
+
+#include <cmath>
+#include <vector>
+
+//x64 always has SSE2, 32 bit builds need /arch:SSE2
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_POOL_SSE
+#include <emmintrin.h>
+#endif
+
+ParticlePool::ParticlePool(ParticleTexture* texture)
+{
+	this->texture = texture;
+	this->count = 0;
+
+	positionX.resize(CAPACITY);
+	positionY.resize(CAPACITY);
+	positionZ.resize(CAPACITY);
+	positionRef.resize(CAPACITY);
+	velocityX.resize(CAPACITY);
+	velocityY.resize(CAPACITY);
+	velocityZ.resize(CAPACITY);
+	gravityEffect.resize(CAPACITY);
+	lifeLength.resize(CAPACITY);
+	elapsedTime.resize(CAPACITY);
+	rotation.resize(CAPACITY);
+	scaleX.resize(CAPACITY);
+	scaleXChange.resize(CAPACITY);
+	scaleY.resize(CAPACITY);
+	scaleYChange.resize(CAPACITY);
+	distance.resize(CAPACITY);
+	texOffset1X.resize(CAPACITY);
+	texOffset1Y.resize(CAPACITY);
+	texOffset2X.resize(CAPACITY);
+	texOffset2Y.resize(CAPACITY);
+	blend.resize(CAPACITY);
+	onlyRendersOnce.resize(CAPACITY);
+	alive.resize(CAPACITY);
+}
+
+bool ParticlePool::addParticle(Vector3f* position, Vector3f* positionRef, Vector3f* velocity, float gravityEffect,
+	float lifeLength, float rotation, float scaleX, float scaleXChange, float scaleY, float scaleYChange,
+	bool onlyRendersOnce)
+{
+	if (count >= CAPACITY)
+	{
+		return false;
+	}
+
+	int i = count;
+	this->positionX[i]       = position->x;
+	this->positionY[i]       = position->y;
+	this->positionZ[i]       = position->z;
+	this->positionRef[i]     = positionRef;
+	this->velocityX[i]       = velocity->x;
+	this->velocityY[i]       = velocity->y;
+	this->velocityZ[i]       = velocity->z;
+	this->gravityEffect[i]   = gravityEffect;
+	this->lifeLength[i]      = lifeLength;
+	this->elapsedTime[i]     = 0;
+	this->rotation[i]        = rotation;
+	this->scaleX[i]          = scaleX;
+	this->scaleXChange[i]    = scaleXChange;
+	this->scaleY[i]          = scaleY;
+	this->scaleYChange[i]    = scaleYChange;
+	this->distance[i]        = 0;
+	this->texOffset1X[i]     = 0;
+	this->texOffset1Y[i]     = 0;
+	this->texOffset2X[i]     = 0;
+	this->texOffset2Y[i]     = 0;
+	this->blend[i]           = 0;
+	this->onlyRendersOnce[i] = onlyRendersOnce;
+	this->alive[i]           = 1;
+	count++;
+
+	return true;
+}
+
+void ParticlePool::updateRange(int begin, int end, Vector3f* cameraPosition, float dt)
+{
+	int i = begin;
+
+	#ifdef PARTICLE_POOL_SSE
+	const float rows = (float)texture->getNumberOfRows();
+	const __m128 zero      = _mm_setzero_ps();
+	const __m128 one       = _mm_set1_ps(1.0f);
+	const __m128 delta     = _mm_set1_ps(dt);
+	const __m128 cameraX   = _mm_set1_ps(cameraPosition->x);
+	const __m128 cameraY   = _mm_set1_ps(cameraPosition->y);
+	const __m128 cameraZ   = _mm_set1_ps(cameraPosition->z);
+	const __m128 rowCount  = _mm_set1_ps(rows);
+	const __m128 stages    = _mm_set1_ps(rows*rows);
+	const __m128 lastStage = _mm_set1_ps(rows*rows - 1);
+
+	//4 particles at a time. Same math as updateParticle, but everything it
+	// does with ints is done with truncated floats, since the values are small.
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 velY = _mm_loadu_ps(&velocityY[i]);
+		velY = _mm_sub_ps(velY, _mm_mul_ps(_mm_loadu_ps(&gravityEffect[i]), delta));
+		_mm_storeu_ps(&velocityY[i], velY);
+
+		__m128 sx = _mm_add_ps(_mm_loadu_ps(&scaleX[i]), _mm_mul_ps(_mm_loadu_ps(&scaleXChange[i]), delta));
+		__m128 sy = _mm_add_ps(_mm_loadu_ps(&scaleY[i]), _mm_mul_ps(_mm_loadu_ps(&scaleYChange[i]), delta));
+		_mm_storeu_ps(&scaleX[i], _mm_max_ps(zero, sx));
+		_mm_storeu_ps(&scaleY[i], _mm_max_ps(zero, sy));
+
+		__m128 px = _mm_add_ps(_mm_loadu_ps(&positionX[i]), _mm_mul_ps(_mm_loadu_ps(&velocityX[i]), delta));
+		__m128 py = _mm_add_ps(_mm_loadu_ps(&positionY[i]), _mm_mul_ps(velY, delta));
+		__m128 pz = _mm_add_ps(_mm_loadu_ps(&positionZ[i]), _mm_mul_ps(_mm_loadu_ps(&velocityZ[i]), delta));
+		_mm_storeu_ps(&positionX[i], px);
+		_mm_storeu_ps(&positionY[i], py);
+		_mm_storeu_ps(&positionZ[i], pz);
+
+		__m128 distX = _mm_sub_ps(cameraX, px);
+		__m128 distY = _mm_sub_ps(cameraY, py);
+		__m128 distZ = _mm_sub_ps(cameraZ, pz);
+		__m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(distX, distX), _mm_mul_ps(distY, distY)), _mm_mul_ps(distZ, distZ));
+		_mm_storeu_ps(&distance[i], dist);
+
+		__m128 elapsed = _mm_loadu_ps(&elapsedTime[i]);
+		__m128 life    = _mm_loadu_ps(&lifeLength[i]);
+
+		__m128 atlasProgression = _mm_mul_ps(_mm_div_ps(elapsed, life), stages);
+		__m128 index1 = _mm_cvtepi32_ps(_mm_cvttps_epi32(atlasProgression));
+		__m128 index2 = _mm_max_ps(index1, _mm_min_ps(_mm_add_ps(index1, one), lastStage));
+		_mm_storeu_ps(&blend[i], _mm_sub_ps(atlasProgression, index1));
+
+		__m128 row1 = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(index1, rowCount)));
+		__m128 row2 = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(index2, rowCount)));
+		__m128 column1 = _mm_sub_ps(index1, _mm_mul_ps(row1, rowCount));
+		__m128 column2 = _mm_sub_ps(index2, _mm_mul_ps(row2, rowCount));
+		_mm_storeu_ps(&texOffset1X[i], _mm_div_ps(column1, rowCount));
+		_mm_storeu_ps(&texOffset1Y[i], _mm_div_ps(row1,    rowCount));
+		_mm_storeu_ps(&texOffset2X[i], _mm_div_ps(column2, rowCount));
+		_mm_storeu_ps(&texOffset2Y[i], _mm_div_ps(row2,    rowCount));
+
+		elapsed = _mm_add_ps(elapsed, delta);
+		int aliveMask = _mm_movemask_ps(_mm_cmplt_ps(elapsed, life));
+
+		__m128 once = _mm_cmpneq_ps(zero, _mm_set_ps(
+			(float)onlyRendersOnce[i + 3], (float)onlyRendersOnce[i + 2],
+			(float)onlyRendersOnce[i + 1], (float)onlyRendersOnce[i]));
+		elapsed = _mm_or_ps(_mm_and_ps(once, life), _mm_andnot_ps(once, elapsed));
+		_mm_storeu_ps(&elapsedTime[i], elapsed);
+
+		alive[i]     = (char)( aliveMask       & 1);
+		alive[i + 1] = (char)((aliveMask >> 1) & 1);
+		alive[i + 2] = (char)((aliveMask >> 2) & 1);
+		alive[i + 3] = (char)((aliveMask >> 3) & 1);
+	}
+	#endif
+
+	for (; i < end; i++)
+	{
+		updateParticle(i, cameraPosition, dt);
+	}
+}
+
+void ParticlePool::updateParticle(int index, Vector3f* cameraPosition, float dt)
+{
+	int i = index;
+	velocityY[i] -= gravityEffect[i]*dt;
+	scaleX[i] = fmaxf(0, scaleX[i] + scaleXChange[i]*dt);
+	scaleY[i] = fmaxf(0, scaleY[i] + scaleYChange[i]*dt);
+
+	positionX[i] += velocityX[i]*dt;
+	positionY[i] += velocityY[i]*dt;
+	positionZ[i] += velocityZ[i]*dt;
+
+	float distX = cameraPosition->x - positionX[i];
+	float distY = cameraPosition->y - positionY[i];
+	float distZ = cameraPosition->z - positionZ[i];
+	distance[i] = distX*distX + distY*distY + distZ*distZ;
+
+	int rows = texture->getNumberOfRows();
+	float lifeFactor = elapsedTime[i] / lifeLength[i];
+	int stageCount = rows * rows;
+	float atlasProgression = lifeFactor * stageCount;
+	int index1 = (int)atlasProgression;
+	int index2 = index1 < stageCount - 1 ? index1 + 1 : index1;
+	blend[i] = fmodf(atlasProgression, 1);
+	texOffset1X[i] = (float)(index1 % rows) / rows;
+	texOffset1Y[i] = (float)(index1 / rows) / rows;
+	texOffset2X[i] = (float)(index2 % rows) / rows;
+	texOffset2Y[i] = (float)(index2 / rows) / rows;
+
+	elapsedTime[i] += dt;
+
+	alive[i] = elapsedTime[i] < lifeLength[i];
+
+	if (onlyRendersOnce[i])
+	{
+		elapsedTime[i] = lifeLength[i];
+	}
+}
+
+void ParticlePool::removeDeadParticles()
+{
+	int end = count;
+	int i = 0;
+	while (i < end)
+	{
+		if (alive[i])
+		{
+			i++;
+			continue;
+		}
+
+		//Fill the hole with the last particle that is still alive
+		end--;
+		while (end > i && !alive[end])
+		{
+			end--;
+		}
+
+		if (end > i)
+		{
+			copyParticle(end, i);
+			i++;
+		}
+	}
+	count = end;
+}
+
+void ParticlePool::copyParticle(int from, int to)
+{
+	positionX[to]       = positionX[from];
+	positionY[to]       = positionY[from];
+	positionZ[to]       = positionZ[from];
+	positionRef[to]     = positionRef[from];
+	velocityX[to]       = velocityX[from];
+	velocityY[to]       = velocityY[from];
+	velocityZ[to]       = velocityZ[from];
+	gravityEffect[to]   = gravityEffect[from];
+	lifeLength[to]      = lifeLength[from];
+	elapsedTime[to]     = elapsedTime[from];
+	rotation[to]        = rotation[from];
+	scaleX[to]          = scaleX[from];
+	scaleXChange[to]    = scaleXChange[from];
+	scaleY[to]          = scaleY[from];
+	scaleYChange[to]    = scaleYChange[from];
+	distance[to]        = distance[from];
+	texOffset1X[to]     = texOffset1X[from];
+	texOffset1Y[to]     = texOffset1Y[from];
+	texOffset2X[to]     = texOffset2X[from];
+	texOffset2Y[to]     = texOffset2Y[from];
+	blend[to]           = blend[from];
+	onlyRendersOnce[to] = onlyRendersOnce[from];
+	alive[to]           = alive[from];
+}
+
+void ParticlePool::getPosition(int index, Vector3f* position)
+{
+	if (positionRef[index] != nullptr)
+	{
+		position->set(positionRef[index]);
+	}
+	else
+	{
+		position->set(positionX[index], positionY[index], positionZ[index]);
+	}
+}
+
+void ParticlePool::clear()
+{
+	count = 0;
+}
\ No newline at end of file
@@ -1,5 +1,9 @@
-#include <list>
 #include <unordered_map>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
 #include <glad/glad.h>
 
 #include "../renderEngine/renderEngine.h"
@@ -7,13 +11,37 @@
 #include "../models/models.h"
 #include "particleshader.h"
 #include "../toolbox/vector.h"
-#include "particle.h"
+#include "particlepool.h"
 #include "particletexture.h"
 #include "particlerenderer.h"
 #include "../toolbox/maths.h"
+#include "../toolbox/radixsort.h"
 #include "../entities/camera.h"
 #include "../engineTester/main.h"
 
+//Floats per particle in the instance vbo:
+// position (3), rotation (1), scale (2), blend (1), opacity (1), texture offset 1 (2), texture offset 2 (2),
+// frame size (2), glow (1), nearest (1). Offsets and frame size are in atlas space.
+#define INSTANCE_DATA_LENGTH 16
+
+#define INITIAL_INSTANCE_CAPACITY 4096
+
+//Bit layout of the sort values: pool(17) particle(15). Pools hold at most 32768 particles.
+#define SORT_POOL_SHIFT    15
+#define SORT_PARTICLE_MASK 0x7FFF
+
+//Bit layout of the sort keys: pool(32) depth(24). The pool bits are 0 when sorting across pools.
+#define SORT_KEY_POOL_SHIFT 32
+
+//Far particles get small keys, so they get drawn first. Squared distances are never negative,
+// so the float bits sort in the same order as the floats, and the top 24 bits are plenty.
+static inline unsigned long long depthKey(float distanceSquared)
+{
+	unsigned int bits;
+	memcpy(&bits, &distanceSquared, sizeof(bits));
+	return (unsigned long long)(0xFFFFFF - (bits >> 8));
+}
+
 
 ParticleRenderer::ParticleRenderer(Matrix4f* projectionMatrix)
 {
@@ -28,87 +56,238 @@ ParticleRenderer::ParticleRenderer(Matrix4f* projectionMatrix)
 	vertices.push_back(-0.5f);
 
 	quad = new RawModel(Loader::loadToVAO(&vertices, 2)); INCR_NEW
+
+	instanceCapacity = INITIAL_INSTANCE_CAPACITY;
+	instanceVbo = Loader::createStreamingVbo(instanceCapacity*INSTANCE_DATA_LENGTH*sizeof(float));
+	glBindVertexArray(quad->getVaoID());
+	glVertexAttribDivisor(1, 1);
+	glVertexAttribDivisor(2, 1);
+	glVertexAttribDivisor(3, 1);
+	glVertexAttribDivisor(4, 1);
+	glBindVertexArray(0);
+
+	resetSortStats();
+
 	shader = new ParticleShader(); INCR_NEW
 	shader->start();
 	shader->loadProjectionMatrix(projectionMatrix);
 	shader->stop();
 }
 
-void ParticleRenderer::render(std::unordered_map<ParticleTexture*, std::list<Particle*>>* particles, Camera* camera, float brightness, int clipSide)
+void ParticleRenderer::render(std::unordered_map<ParticleTexture*, ParticlePool*>* pools, Camera* camera, float brightness, int clipSide)
 {
+	sortParticles(pools, clipSide);
+	if (fillInstanceVbo() == 0)
+	{
+		return;
+	}
+
 	Matrix4f viewMatrix;
 	Maths::createViewMatrix(&viewMatrix, camera);
 	prepare();
+	shader->loadViewMatrix(&viewMatrix);
 	shader->loadBrightness(brightness);
 
-	switch (clipSide + 1)
+	for (ParticleBatch batch : batches)
 	{
-		case 0: //side -1
-			for (auto texture : (*particles))
-			{
-				//bind texture
-				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_2D, texture.first->getTextureID());
-				shader->loadOpacity(texture.first->getOpacity());
-				shader->loadGlow(texture.first->getGlow());
-				std::list<Particle*>* texturesList = &texture.second;
-				for (Particle* particle : (*texturesList))
-				{
-					if (particle->getPosition()->y < 0)
-					{
-						updateModelViewMatrix(particle->getPosition(), particle->getRotation(), particle->getScaleX(), particle->getScaleY(), &viewMatrix);
-						shader->loadTextureCoordInfo(particle->getTexOffset1(), particle->getTexOffset2(), (float)texture.first->getNumberOfRows(), particle->getBlend());
-						glDrawArrays(GL_TRIANGLE_STRIP, 0, quad->getVertexCount());
-					}
-				}
-			}
-			break;
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, batch.textureID);
 
-		case 1: //side 0
-			for (auto texture : (*particles))
-			{
-				//bind texture
-				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_2D, texture.first->getTextureID());
-				shader->loadOpacity(texture.first->getOpacity());
-				shader->loadGlow(texture.first->getGlow());
-
-				std::list<Particle*>* texturesList = &texture.second;
-				for (Particle* particle : (*texturesList))
-				{
-					updateModelViewMatrix(particle->getPosition(), particle->getRotation(), particle->getScaleX(), particle->getScaleY(), &viewMatrix);
-					shader->loadTextureCoordInfo(particle->getTexOffset1(), particle->getTexOffset2(), (float)texture.first->getNumberOfRows(), particle->getBlend());
-					glDrawArrays(GL_TRIANGLE_STRIP, 0, quad->getVertexCount());
-				}
-			}
-			break;
+		bindInstanceAttributes(batch.firstInstance);
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, quad->getVertexCount(), batch.instanceCount);
+	}
+
+	finishRendering();
+}
+
+void ParticleRenderer::sortParticles(std::unordered_map<ParticleTexture*, ParticlePool*>* pools, int clipSide)
+{
+	sortItems.clear();
+	sortPools.clear();
+
+	//-1 draws particles below the water, 1 draws particles above it, 0 draws everything
+	if (clipSide < -1 || clipSide > 1)
+	{
+		return;
+	}
+
+	#ifdef DEV_MODE
+	auto timeStart = std::chrono::high_resolution_clock::now();
+	#endif
+
+	bool sortAcrossPools = true;
+	GLuint sharedTextureID = 0;
+	for (auto& entry : (*pools))
+	{
+		if (entry.second->count == 0)
+		{
+			continue;
+		}
+
+		GLuint textureID = entry.first->getTextureID();
+		if (sortPools.size() > 0 && textureID != sharedTextureID)
+		{
+			sortAcrossPools = false;
+		}
+		sharedTextureID = textureID;
+		sortPools.push_back(entry.second);
+	}
 
-		case 2: //side 1
-			for (auto texture : (*particles))
+	Vector3f position;
+	for (unsigned int p = 0; p < (unsigned int)sortPools.size(); p++)
+	{
+		ParticlePool* pool = sortPools[p];
+		const unsigned long long poolBits = sortAcrossPools ? 0 : ((unsigned long long)p << SORT_KEY_POOL_SHIFT);
+
+		for (int i = 0; i < pool->count; i++)
+		{
+			if (clipSide != 0)
 			{
-				//bind texture
-				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_2D, texture.first->getTextureID());
-				shader->loadOpacity(texture.first->getOpacity());
-				shader->loadGlow(texture.first->getGlow());
-				std::list<Particle*>* texturesList = &texture.second;
-				for (Particle* particle : (*texturesList))
+				pool->getPosition(i, &position);
+				if ((clipSide == -1 && position.y >= 0) ||
+					(clipSide ==  1 && position.y <  0))
 				{
-					if (particle->getPosition()->y >= 0)
-					{
-						updateModelViewMatrix(particle->getPosition(), particle->getRotation(), particle->getScaleX(), particle->getScaleY(), &viewMatrix);
-						shader->loadTextureCoordInfo(particle->getTexOffset1(), particle->getTexOffset2(), (float)texture.first->getNumberOfRows(), particle->getBlend());
-						glDrawArrays(GL_TRIANGLE_STRIP, 0, quad->getVertexCount());
-					}
+					continue;
 				}
 			}
-			break;
 
-		default:
-			break;
+			RadixSortItem item;
+			item.key = poolBits | depthKey(pool->distance[i]);
+			item.value = (p << SORT_POOL_SHIFT) | (unsigned int)i;
+			sortItems.push_back(item);
+		}
 	}
 
-	finishRendering();
+	RadixSort::sort(&sortItems, &sortScratch);
+
+	#ifdef DEV_MODE
+	auto timeEnd = std::chrono::high_resolution_clock::now();
+	statsSortTime += std::chrono::duration<double, std::milli>(timeEnd - timeStart).count();
+	statsSorts++;
+	statsSortedParticles += (int)sortItems.size();
+	#endif
+}
+
+int ParticleRenderer::fillInstanceVbo()
+{
+	batches.clear();
+
+	int totalCount = (int)sortItems.size();
+	if (totalCount == 0)
+	{
+		return 0;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+
+	if (totalCount > instanceCapacity)
+	{
+		while (instanceCapacity < totalCount)
+		{
+			instanceCapacity *= 2;
+		}
+		glBufferData(GL_ARRAY_BUFFER, instanceCapacity*INSTANCE_DATA_LENGTH*sizeof(float), nullptr, GL_STREAM_DRAW);
+	}
+
+	//Invalidating the whole buffer lets the driver hand back fresh memory
+	// instead of waiting on the draws that are still reading the old data
+	float* data = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0, totalCount*INSTANCE_DATA_LENGTH*sizeof(float),
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (data == nullptr)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		return 0;
+	}
+
+	Vector3f position;
+	ParticlePool* currentPool = nullptr;
+	GLuint textureID = 0;
+	float atlasX = 0;
+	float atlasY = 0;
+	float atlasWidth = 1;
+	float atlasHeight = 1;
+	float frameWidth = 1;
+	float frameHeight = 1;
+	float opacity = 1;
+	float glow = 0;
+	float nearest = 0;
+
+	for (int n = 0; n < totalCount; n++)
+	{
+		unsigned int value = sortItems[n].value;
+		ParticlePool* pool = sortPools[value >> SORT_POOL_SHIFT];
+		int i = (int)(value & SORT_PARTICLE_MASK);
+
+		if (pool != currentPool)
+		{
+			ParticleTexture* texture = pool->texture;
+			textureID   = texture->getTextureID();
+			atlasX      = texture->getAtlasX();
+			atlasY      = texture->getAtlasY();
+			atlasWidth  = texture->getAtlasWidth();
+			atlasHeight = texture->getAtlasHeight();
+			frameWidth  = atlasWidth/texture->getNumberOfRows();
+			frameHeight = atlasHeight/texture->getNumberOfRows();
+			opacity     = texture->getOpacity();
+			glow        = texture->getGlow();
+			nearest     = texture->getNearest() ? 1.0f : 0.0f;
+			currentPool = pool;
+		}
+
+		if (batches.size() == 0 || batches.back().textureID != textureID)
+		{
+			ParticleBatch batch;
+			batch.textureID = textureID;
+			batch.firstInstance = n;
+			batch.instanceCount = 0;
+			batches.push_back(batch);
+		}
+		batches.back().instanceCount++;
+
+		pool->getPosition(i, &position);
+
+		float* instance = &data[n*INSTANCE_DATA_LENGTH];
+		instance[ 0] = position.x;
+		instance[ 1] = position.y;
+		instance[ 2] = position.z;
+		instance[ 3] = Maths::toRadians(pool->rotation[i]);
+		instance[ 4] = pool->scaleX[i];
+		instance[ 5] = pool->scaleY[i];
+		instance[ 6] = pool->blend[i];
+		instance[ 7] = opacity;
+		instance[ 8] = atlasX + pool->texOffset1X[i]*atlasWidth;
+		instance[ 9] = atlasY + pool->texOffset1Y[i]*atlasHeight;
+		instance[10] = atlasX + pool->texOffset2X[i]*atlasWidth;
+		instance[11] = atlasY + pool->texOffset2Y[i]*atlasHeight;
+		instance[12] = frameWidth;
+		instance[13] = frameHeight;
+		instance[14] = glow;
+		instance[15] = nearest;
+	}
+
+	//The data can get lost while mapped (when the screen mode changes for example)
+	if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE)
+	{
+		batches.clear();
+		totalCount = 0;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return totalCount;
+}
+
+void ParticleRenderer::bindInstanceAttributes(int firstInstance)
+{
+	const GLsizei stride = INSTANCE_DATA_LENGTH*sizeof(float);
+	const size_t offset = firstInstance*stride;
+
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(offset));
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(offset + 4*sizeof(float)));
+	glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(offset + 8*sizeof(float)));
+	glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(offset + 12*sizeof(float)));
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 void ParticleRenderer::cleanUp()
@@ -116,26 +295,18 @@ void ParticleRenderer::cleanUp()
 	shader->cleanUp();
 }
 
-void ParticleRenderer::updateModelViewMatrix(Vector3f* position, float rotation, float scaleX, float scaleY, Matrix4f* viewMatrix)
+void ParticleRenderer::printSortStats()
+{
+	std::fprintf(stdout, "Particle sort: %f ms for %f particles on average over %d sorts\n",
+		statsSortTime/fmax(1.0, (double)statsSorts), (double)statsSortedParticles/fmax(1.0, (double)statsSorts), statsSorts);
+	resetSortStats();
+}
+
+void ParticleRenderer::resetSortStats()
 {
-	Matrix4f modelMatrix;
-	modelMatrix.translate(position);
-	modelMatrix.m00 = viewMatrix->m00;
-	modelMatrix.m01 = viewMatrix->m10;
-	modelMatrix.m02 = viewMatrix->m20;
-	modelMatrix.m10 = viewMatrix->m01;
-	modelMatrix.m11 = viewMatrix->m11;
-	modelMatrix.m12 = viewMatrix->m21;
-	modelMatrix.m20 = viewMatrix->m02;
-	modelMatrix.m21 = viewMatrix->m12;
-	modelMatrix.m22 = viewMatrix->m22;
-	Vector3f axis(0, 0, 1);
-	modelMatrix.rotate(Maths::toRadians(rotation), &axis);
-	Vector3f scaleVec(scaleX, scaleY, 1);
-	modelMatrix.scale(&scaleVec);
-	Matrix4f modelViewMatrix = Matrix4f(modelMatrix);
-	viewMatrix->multiply(&modelViewMatrix, &modelViewMatrix);
-	shader->loadModelViewMatrix(&modelViewMatrix);
+	statsSortTime = 0;
+	statsSorts = 0;
+	statsSortedParticles = 0;
 }
 
 void ParticleRenderer::updateProjectionMatrix(Matrix4f* projectionMatrix)
@@ -150,6 +321,10 @@ void ParticleRenderer::prepare()
 	shader->start();
 	glBindVertexArray(quad->getVaoID());
 	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	glEnableVertexAttribArray(2);
+	glEnableVertexAttribArray(3);
+	glEnableVertexAttribArray(4);
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glDepthMask(false);
@@ -160,6 +335,10 @@ void ParticleRenderer::finishRendering()
 	glDepthMask(true);
 	glDisable(GL_BLEND);
 	glDisableVertexAttribArray(0);
+	glDisableVertexAttribArray(1);
+	glDisableVertexAttribArray(2);
+	glDisableVertexAttribArray(3);
+	glDisableVertexAttribArray(4);
 	glBindVertexArray(0);
 	shader->stop();
 }
@@ -2,9 +2,16 @@
 #include "particletexture.h"
 #include "../renderEngine/renderEngine.h"
 #include "../engineTester/main.h"
+#include "../toolbox/vector.h"
+
+#include <vector>
+#include <string>
 
 std::vector<ParticleTexture*> ParticleResources::exhaustTextures;
 
+ParticleTexture* ParticleResources::particleExhaustBlueFalcon = nullptr;
+ParticleTexture* ParticleResources::particleExhaustArwing = nullptr;
+
 ParticleTexture* ParticleResources::textureDust = nullptr;
 ParticleTexture* ParticleResources::textureDirt = nullptr;
 ParticleTexture* ParticleResources::textureSnowDrop = nullptr;
@@ -41,44 +48,79 @@ ParticleTexture* ParticleResources::textureBlackFadeOutAndIn = nullptr;
 ParticleTexture* ParticleResources::textureInWater = nullptr;
 ParticleTexture* ParticleResources::textureBlueLine = nullptr;
 
+//Every particle sprite sheet goes into one atlas, so that particles of
+// different types can be sorted together and drawn in a single draw call
 void ParticleResources::loadParticles()
 {
-	INCR_NEW exhaustTextures.push_back(new ParticleTexture(Loader::loadTexture("res/Images/Particles/ExhaustBlueFalcon.png"), 1, 0.2f, 1));
-	INCR_NEW exhaustTextures.push_back(new ParticleTexture(Loader::loadTexture("res/Images/Particles/ExhaustArwing.png"), 1, 0.3f, 1));
+	struct SpriteSheet
+	{
+		ParticleTexture** texture;
+		const char* fileName;
+		int numberOfRows;
+		float opacity;
+		float glow;
+		bool nearest;
+	};
+
+	SpriteSheet sheets[] =
+	{
+		{&particleExhaustBlueFalcon, "res/Images/Particles/ExhaustBlueFalcon.png",      1, 0.2f, 1, false},
+		{&particleExhaustArwing,     "res/Images/Particles/ExhaustArwing.png",          1, 0.3f, 1, false},
+		{&textureSnowDrop,           "res/Images/Particles/SnowDropAtlas.png",          2, 1.0f, 0, false},
+		{&textureDustCloud,          "res/Images/Particles/DustCloud.png",              1, 0.2f, 0, false},
+		{&textureSnowball,           "res/Images/Particles/Snowball.png",               1, 0.75f, 0, false},
+		{&textureStar,               "res/Images/Particles/Star.png",                   1, 1.0f, 0, false},
+		{&textureSparkleYellow,      "res/Images/Particles/SparkleYellow.png",          1, 1.0f, 1, false},
+		{&textureSparkleGreen,       "res/Images/Particles/SparkleGreen.png",           1, 1.0f, 1, false},
+		{&textureSparkleRed,         "res/Images/Particles/SparkleRed.png",             1, 1.0f, 1, false},
+		{&textureSparkleBlue,        "res/Images/Particles/SparkleBlue.png",            1, 1.0f, 1, false},
+		{&textureSparkleLightBlue,   "res/Images/Particles/SparkleLightBlue.png",       1, 1.0f, 1, false},
+		{&textureSparkleWhite,       "res/Images/Particles/SparkleWhite.png",           1, 1.0f, 1, false},
+		{&textureWaterDrop,          "res/Images/Particles/WaterDrop.png",              1, 1, 0, false},
+		{&textureWhiteTrail,         "res/Images/Particles/SpTrailWhite.png",           1, 0.3f, 1, false},
+		{&textureLightBlueTrail,     "res/Images/Particles/SpTrailLightBlue.png",       1, 0.1f, 1, false},
+		{&textureBlueTrail,          "res/Images/Particles/SpTrailBlue.png",            1, 0.1f, 1, false},
+		{&textureBlackTrail,         "res/Images/Particles/SpTrailBlack.png",           1, 0.1f, 1, false},
+		{&textureGrayTrail,          "res/Images/Particles/SpTrailGray.png",            1, 0.1f, 1, false},
+		{&texturePinkTrail,          "res/Images/Particles/SpTrailPink.png",            1, 0.1f, 1, false},
+		{&textureDarkGreenTrail,     "res/Images/Particles/SpTrailDarkGreen.png",       1, 0.1f, 1, false},
+		{&textureOrangeTrail,        "res/Images/Particles/SpTrailOrange.png",          1, 0.3f, 1, false},
+		{&textureRedTrail,           "res/Images/Particles/SpTrailRed.png",             1, 0.3f, 1, false},
+		{&textureDust,               "res/Images/Particles/DustAtlas.png",              4, 0.2f, 0, false},
+		{&textureDirt,               "res/Images/Particles/DirtAtlas.png",              4, 0.75f, 0, false},
+		{&textureSplash,             "res/Images/Particles/SplashAtlas.png",            4, 0.6f, 0, true },
+		{&textureBubble,             "res/Images/Particles/BubbleInverseAtlas.png",     4, 0.6f, 0, true },
+		{&textureExplosion1,         "res/Images/Particles/Explosion1Atlas.png",        4, 0.8f, 0, true },
+		{&textureExplosion2,         "res/Images/Particles/Explosion2Atlas.png",        4, 0.8f, 0, true },
+		{&textureExplosion3,         "res/Images/Particles/Explosion3Atlas.png",        4, 0.8f, 0, false},
+		{&textureBlackFade,          "res/Images/Particles/BlackFadeAtlas.png",         2, 1.0f, 0, false},
+		{&textureBlackFadeOut,       "res/Images/Particles/BlackFadeOutAtlas.png",      2, 1.0f, 0, false},
+		{&textureTear1,              "res/Images/Particles/Tear1.png",                  1, 1.0f, 0, false},
+		{&textureTear2,              "res/Images/Particles/Tear2.png",                  1, 1.0f, 0, false},
+		{&textureWhiteFadeOutAndIn,  "res/Images/Particles/WhiteFadeOutAndInAtlas.png", 2, 1.0f, 0, false},
+		{&textureBlackFadeOutAndIn,  "res/Images/Particles/BlackFadeOutAndInAtlas.png", 2, 1.0f, 0, false},
+		{&textureInWater,            "res/Images/Particles/InWater.png",                1, 0.1f, 1, false},
+		{&textureBlueLine,           "res/Images/Particles/BlueLine.png",               1, 1.0f, 1, false},
+	};
+
+	const int sheetCount = (int)(sizeof(sheets)/sizeof(SpriteSheet));
+
+	std::vector<std::string> fileNames;
+	for (int i = 0; i < sheetCount; i++)
+	{
+		fileNames.push_back(sheets[i].fileName);
+	}
+
+	//8 pixels of padding is enough for 3 mipmap levels to not bleed
+	std::vector<Vector4f> rects;
+	GLuint atlas = Loader::loadTextureAtlas(&fileNames, 8, 3, &rects);
+
+	for (int i = 0; i < sheetCount; i++)
+	{
+		SpriteSheet* sheet = &sheets[i];
+		INCR_NEW (*sheet->texture) = new ParticleTexture(atlas, &rects[i], sheet->numberOfRows, sheet->opacity, sheet->glow, sheet->nearest);
+	}
 
-	INCR_NEW textureSnowDrop          = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SnowDropAtlas.png"), 2, 1.0f, 0);
-	INCR_NEW textureDustCloud         = new ParticleTexture(Loader::loadTexture("res/Images/Particles/DustCloud.png"), 1, 0.2f, 0);
-	INCR_NEW textureSnowball          = new ParticleTexture(Loader::loadTexture("res/Images/Particles/Snowball.png"), 1, 0.75f, 0);
-	INCR_NEW textureStar              = new ParticleTexture(Loader::loadTexture("res/Images/Particles/Star.png"), 1, 1.0f, 0);
-	INCR_NEW textureSparkleYellow     = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SparkleYellow.png"), 1, 1.0f, 1);
-	INCR_NEW textureSparkleGreen      = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SparkleGreen.png"), 1, 1.0f, 1);
-	INCR_NEW textureSparkleRed        = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SparkleRed.png"), 1, 1.0f, 1);
-	INCR_NEW textureSparkleBlue       = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SparkleBlue.png"), 1, 1.0f, 1);
-	INCR_NEW textureSparkleLightBlue  = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SparkleLightBlue.png"), 1, 1.0f, 1);
-	INCR_NEW textureSparkleWhite      = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SparkleWhite.png"), 1, 1.0f, 1);
-	INCR_NEW textureWaterDrop         = new ParticleTexture(Loader::loadTexture("res/Images/Particles/WaterDrop.png"), 1, 1, 0);
-	INCR_NEW textureWhiteTrail        = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SpTrailWhite.png"), 1, 0.3f, 1);
-	INCR_NEW textureLightBlueTrail    = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SpTrailLightBlue.png"), 1, 0.1f, 1);
-	INCR_NEW textureBlueTrail         = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SpTrailBlue.png"), 1, 0.1f, 1);
-	INCR_NEW textureBlackTrail        = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SpTrailBlack.png"), 1, 0.1f, 1);
-	INCR_NEW textureGrayTrail         = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SpTrailGray.png"), 1, 0.1f, 1);
-	INCR_NEW texturePinkTrail         = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SpTrailPink.png"), 1, 0.1f, 1);
-	INCR_NEW textureDarkGreenTrail    = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SpTrailDarkGreen.png"), 1, 0.1f, 1);
-	INCR_NEW textureOrangeTrail       = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SpTrailOrange.png"), 1, 0.3f, 1);
-	INCR_NEW textureRedTrail          = new ParticleTexture(Loader::loadTexture("res/Images/Particles/SpTrailRed.png"), 1, 0.3f, 1);
-	INCR_NEW textureDust              = new ParticleTexture(Loader::loadTexture("res/Images/Particles/DustAtlas.png"), 4, 0.2f, 0);
-	INCR_NEW textureDirt              = new ParticleTexture(Loader::loadTexture("res/Images/Particles/DirtAtlas.png"), 4, 0.75f, 0);
-	INCR_NEW textureSplash            = new ParticleTexture(Loader::loadTextureNoInterpolation("res/Images/Particles/SplashAtlas.png"), 4, 0.6f, 0);
-	INCR_NEW textureBubble            = new ParticleTexture(Loader::loadTextureNoInterpolation("res/Images/Particles/BubbleInverseAtlas.png"), 4, 0.6f, 0);
-	INCR_NEW textureExplosion1        = new ParticleTexture(Loader::loadTextureNoInterpolation("res/Images/Particles/Explosion1Atlas.png"), 4, 0.8f, 0);
-	INCR_NEW textureExplosion2        = new ParticleTexture(Loader::loadTextureNoInterpolation("res/Images/Particles/Explosion2Atlas.png"), 4, 0.8f, 0);
-	INCR_NEW textureExplosion3        = new ParticleTexture(Loader::loadTexture("res/Images/Particles/Explosion3Atlas.png"), 4, 0.8f, 0);
-	INCR_NEW textureBlackFade         = new ParticleTexture(Loader::loadTexture("res/Images/Particles/BlackFadeAtlas.png"), 2, 1.0f, 0);
-	INCR_NEW textureBlackFadeOut      = new ParticleTexture(Loader::loadTexture("res/Images/Particles/BlackFadeOutAtlas.png"), 2, 1.0f, 0);
-	INCR_NEW textureTear1             = new ParticleTexture(Loader::loadTexture("res/Images/Particles/Tear1.png"), 1, 1.0f, 0);
-	INCR_NEW textureTear2             = new ParticleTexture(Loader::loadTexture("res/Images/Particles/Tear2.png"), 1, 1.0f, 0);
-	INCR_NEW textureWhiteFadeOutAndIn = new ParticleTexture(Loader::loadTexture("res/Images/Particles/WhiteFadeOutAndInAtlas.png"), 2, 1.0f, 0);
-	INCR_NEW textureBlackFadeOutAndIn = new ParticleTexture(Loader::loadTexture("res/Images/Particles/BlackFadeOutAndInAtlas.png"), 2, 1.0f, 0);
-	INCR_NEW textureInWater           = new ParticleTexture(Loader::loadTexture("res/Images/Particles/InWater.png"), 1, 0.1f, 1);
-	INCR_NEW textureBlueLine          = new ParticleTexture(Loader::loadTexture("res/Images/Particles/BlueLine.png"), 1, 1.0f, 1);
+	exhaustTextures.push_back(particleExhaustBlueFalcon);
+	exhaustTextures.push_back(particleExhaustArwing);
 }
\ No newline at end of file
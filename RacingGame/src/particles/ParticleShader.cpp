@@ -46,42 +46,28 @@ void ParticleShader::cleanUp()
 	glDeleteProgram(programID);
 }
 
-void ParticleShader::loadTextureCoordInfo(Vector2f* offset1, Vector2f* offset2, float numRows, float blend)
-{
-	load2DVector(location_texOffset1, offset1);
-	load2DVector(location_texOffset2, offset2);
-	Vector2f info(numRows, blend);
-	load2DVector(location_texCoordInfo, &info);
-}
-
 void ParticleShader::loadBrightness(float brightness)
 {
 	loadFloat(location_brightness, brightness);
 }
 
-void ParticleShader::loadOpacity(float opacity)
-{
-	loadFloat(location_opacity, opacity);
-}
-
-void ParticleShader::loadGlow(float glow)
-{
-	loadFloat(location_glow, glow);
-}
-
 void ParticleShader::loadProjectionMatrix(Matrix4f* projectionMatrix)
 {
 	loadMatrix(location_projectionMatrix, projectionMatrix);
 }
 
-void ParticleShader::loadModelViewMatrix(Matrix4f* modelView)
+void ParticleShader::loadViewMatrix(Matrix4f* viewMatrix)
 {
-	loadMatrix(location_modelViewMatrix, modelView);
+	loadMatrix(location_viewMatrix, viewMatrix);
 }
 
 void ParticleShader::bindAttributes()
 {
 	bindAttribute(0, "position");
+	bindAttribute(1, "positionRotation");
+	bindAttribute(2, "scaleBlend");
+	bindAttribute(3, "texOffsets");
+	bindAttribute(4, "frameInfo");
 }
 
 void ParticleShader::bindAttribute(int attribute, const char* variableName)
@@ -91,14 +77,9 @@ void ParticleShader::bindAttribute(int attribute, const char* variableName)
 
 void ParticleShader::getAllUniformLocations()
 {
-	location_modelViewMatrix  = getUniformLocation("modelViewMatrix");
+	location_viewMatrix       = getUniformLocation("viewMatrix");
 	location_projectionMatrix = getUniformLocation("projectionMatrix");
-	location_texOffset1       = getUniformLocation("texOffset1");
-	location_texOffset2       = getUniformLocation("texOffset2");
-	location_texCoordInfo     = getUniformLocation("texCoordInfo");
 	location_brightness       = getUniformLocation("brightness");
-	location_opacity          = getUniformLocation("opacity");
-	location_glow             = getUniformLocation("glow");
 }
 
 int ParticleShader::getUniformLocation(const char* uniformName)
@@ -1,4 +1,5 @@
 #include "particletexture.h"
+#include "../toolbox/vector.h"
 #include <glad/glad.h>
 
 ParticleTexture::ParticleTexture(GLuint textureID, int numberOfRows, float opacity, float glow)
@@ -7,6 +8,24 @@ ParticleTexture::ParticleTexture(GLuint textureID, int numberOfRows, float opaci
 	this->numberOfRows = numberOfRows;
 	this->opacity = opacity;
 	this->glow = glow;
+	this->atlasX = 0;
+	this->atlasY = 0;
+	this->atlasWidth = 1;
+	this->atlasHeight = 1;
+	this->nearest = false;
+}
+
+ParticleTexture::ParticleTexture(GLuint textureID, Vector4f* atlasRect, int numberOfRows, float opacity, float glow, bool nearest)
+{
+	this->textureID = textureID;
+	this->numberOfRows = numberOfRows;
+	this->opacity = opacity;
+	this->glow = glow;
+	this->atlasX = atlasRect->x;
+	this->atlasY = atlasRect->y;
+	this->atlasWidth = atlasRect->z;
+	this->atlasHeight = atlasRect->w;
+	this->nearest = nearest;
 }
 
 GLuint ParticleTexture::getTextureID()
@@ -28,3 +47,28 @@ float ParticleTexture::getGlow()
 {
 	return glow;
 }
+
+float ParticleTexture::getAtlasX()
+{
+	return atlasX;
+}
+
+float ParticleTexture::getAtlasY()
+{
+	return atlasY;
+}
+
+float ParticleTexture::getAtlasWidth()
+{
+	return atlasWidth;
+}
+
+float ParticleTexture::getAtlasHeight()
+{
+	return atlasHeight;
+}
+
+bool ParticleTexture::getNearest()
+{
+	return nearest;
+}
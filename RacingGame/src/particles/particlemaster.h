@@ -4,18 +4,29 @@
 class Matrix4f;
 class Camera;
 class ParticleTexture;
-class Particle;
+class ParticlePool;
 class ParticleRenderer;
+class Vector3f;
 
 #include <unordered_map>
-#include <list>
+
+#include "../toolbox/framestats.h"
 
 class ParticleMaster
 {
 private:
-	static std::unordered_map<ParticleTexture*, std::list<Particle*>> particles;
+	static std::unordered_map<ParticleTexture*, ParticlePool*> pools;
 	static ParticleRenderer* renderer;
 
+	static bool stressTest;
+	static float stressTestTimer;
+	static FrameStats stats;
+
+	//Returns the pool for this texture, making it the first time the texture is used
+	static ParticlePool* getPool(ParticleTexture* texture);
+
+	static void emitStressTestParticles(Camera* cam, float dt);
+
 public:
 	static void init(Matrix4f* projectionMatrix);
 
@@ -25,11 +36,25 @@ public:
 
 	static void cleanUp();
 
-	static void addParticle(Particle* particle);
+	//Emits a particle that stays in one spot, using one of the exhaust textures
+	static void createParticle(int exhaustTextureIndex, Vector3f* position, float lifeLength, float scale, bool onlyRendersOnce);
+
+	static void createParticle(ParticleTexture* texture, Vector3f* position, Vector3f* velocity, float lifeLength, float scale, bool onlyRendersOnce);
+
+	//If posIsRef is true, the particle is drawn wherever position points to for its whole life
+	static void createParticle(ParticleTexture* texture, Vector3f* position, Vector3f* velocity, float gravityEffect,
+		float lifeLength, float rotation, float scale, float scaleChange, bool posIsRef, bool onlyRendersOnce);
+
+	static void createParticle(ParticleTexture* texture, Vector3f* position, Vector3f* velocity, float gravityEffect,
+		float lifeLength, float rotation, float scaleX, float scaleXChange, float scaleY, float scaleYChange,
+		bool posIsRef, bool onlyRendersOnce);
 
 	static void updateProjectionMatrix(Matrix4f* projectionMatrix);
 
 	static void deleteAllParticles();
+
+	//Toggles emitting 100,000 particles per second around the camera, to measure the update cost
+	static void toggleStressTest();
 };
 
 #endif
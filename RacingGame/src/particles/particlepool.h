@@ -0,0 +1,74 @@
+#ifndef PARTICLEPOOL_H
+#define PARTICLEPOOL_H
+
+class ParticleTexture;
+class Vector3f;
+
+#include <vector>
+
+//Holds every live particle that uses one texture, as a structure of arrays.
+//The arrays are allocated once at full capacity, and dead particles are
+// swap-removed with the last live one, so the live particles are always
+// packed into [0, count) and nothing gets allocated while particles are made.
+class ParticlePool
+{
+public:
+	//Particles emitted while the pool is full are dropped
+	static const int CAPACITY = 32768;
+
+	ParticleTexture* texture;
+	int count;
+
+	std::vector<float> positionX;
+	std::vector<float> positionY;
+	std::vector<float> positionZ;
+	//Where the particle is drawn, if it follows something else's position. nullptr if it doesn't.
+	std::vector<Vector3f*> positionRef;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+	std::vector<float> velocityZ;
+	std::vector<float> gravityEffect;
+	std::vector<float> lifeLength;
+	std::vector<float> elapsedTime;
+	std::vector<float> rotation;
+	std::vector<float> scaleX;
+	std::vector<float> scaleXChange;
+	std::vector<float> scaleY;
+	std::vector<float> scaleYChange;
+	//Squared distance to the camera
+	std::vector<float> distance;
+	std::vector<float> texOffset1X;
+	std::vector<float> texOffset1Y;
+	std::vector<float> texOffset2X;
+	std::vector<float> texOffset2Y;
+	std::vector<float> blend;
+	std::vector<char> onlyRendersOnce;
+	//Set by updateRange, read by removeDeadParticles
+	std::vector<char> alive;
+
+private:
+	void updateParticle(int index, Vector3f* cameraPosition, float dt);
+
+	void copyParticle(int from, int to);
+
+public:
+	ParticlePool(ParticleTexture* texture);
+
+	//Adds a new particle to the end of the pool. Returns false if the pool is full.
+	bool addParticle(Vector3f* position, Vector3f* positionRef, Vector3f* velocity, float gravityEffect,
+		float lifeLength, float rotation, float scaleX, float scaleXChange, float scaleY, float scaleYChange,
+		bool onlyRendersOnce);
+
+	//Moves the particles in [begin, end) forward by dt and marks the ones that have died.
+	//Different threads can update ranges that don't overlap at the same time.
+	void updateRange(int begin, int end, Vector3f* cameraPosition, float dt);
+
+	//Swap-removes every particle that updateRange marked as dead, in one pass
+	void removeDeadParticles();
+
+	//The position that the particle should be drawn at
+	void getPosition(int index, Vector3f* position);
+
+	void clear();
+};
+#endif
\ No newline at end of file
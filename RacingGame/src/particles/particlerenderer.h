@@ -5,35 +5,71 @@ class Matrix4f;
 class RawModel;
 class ParticleShader;
 class Vector3f;
-class Particle;
+class ParticlePool;
 class ParticleTexture;
 class Camera;
 
 
 #include "../renderEngine/renderEngine.h"
-#include <list>
+#include "../toolbox/radixsort.h"
 #include <unordered_map>
+#include <vector>
 #include <glad/glad.h>
 
+//The particles that use one GL texture, as a range of the instance vbo
+struct ParticleBatch
+{
+	GLuint textureID;
+	int firstInstance;
+	int instanceCount;
+};
+
 class ParticleRenderer
 {
 private:
 	RawModel* quad;
 	ParticleShader* shader;
 
+	//Every particle that gets drawn is written into this once per render
+	GLuint instanceVbo;
+	int instanceCapacity;
+	std::vector<ParticleBatch> batches;
+
+	//Back to front draw order. Each value is a pool number and the index of the particle in that pool.
+	std::vector<RadixSortItem> sortItems;
+	std::vector<RadixSortItem> sortScratch;
+	std::vector<ParticlePool*> sortPools;
+
+	double statsSortTime;
+	int statsSorts;
+	int statsSortedParticles;
+
+	//Sorts the particles that are on the clip side from back to front. If every pool
+	// uses the same GL texture (an atlas), they are sorted all together. Otherwise
+	// they are sorted within each pool, since each pool is its own draw.
+	void sortParticles(std::unordered_map<ParticleTexture*, ParticlePool*>* pools, int clipSide);
+
+	//Writes the sorted particles into the instance vbo, and makes a batch for each run of the same GL texture
+	int fillInstanceVbo();
+
+	void bindInstanceAttributes(int firstInstance);
+
 	void prepare();
 
 	void finishRendering();
 
-	void updateModelViewMatrix(Vector3f* position, float rotation, float scaleX, float scaleY, Matrix4f* viewMatrix);
-
 public:
 	ParticleRenderer(Matrix4f* projectionMatrix);
 
-	void render(std::unordered_map<ParticleTexture*, std::list<Particle*>>* particles, Camera* camera, float brightness, int clipSide);
+	void render(std::unordered_map<ParticleTexture*, ParticlePool*>* pools, Camera* camera, float brightness, int clipSide);
 
 	void updateProjectionMatrix(Matrix4f* projectionMatrix);
 
 	void cleanUp();
+
+	//Prints the average sort time since the last call
+	void printSortStats();
+
+	void resetSortStats();
 };
 #endif
\ No newline at end of file
@@ -17,14 +17,9 @@ private:
 	GLuint vertexShaderID;
 	GLuint fragmentShaderID;
 
-	int location_modelViewMatrix;
+	int location_viewMatrix;
 	int location_projectionMatrix;
-	int location_texOffset1;
-	int location_texOffset2;
-	int location_texCoordInfo;
 	int location_brightness;
-	int location_opacity;
-	int location_glow;
 
 	float matrixBuffer[16];
 
@@ -37,17 +32,11 @@ public:
 
 	void cleanUp();
 
-	void loadTextureCoordInfo(Vector2f* offset1, Vector2f* offset2, float numRows, float blend);
-
 	void loadBrightness(float brightness);
 
-	void loadOpacity(float opacity);
-
-	void loadGlow(float glow);
-
 	void loadProjectionMatrix(Matrix4f* projectionMatrix);
 
-	void loadModelViewMatrix(Matrix4f* modelView);
+	void loadViewMatrix(Matrix4f* viewMatrix);
 
 
 protected:
@@ -1,6 +1,8 @@
 #ifndef PARTICLETEXTURE_H
 #define PARTICLETEXTURE_H
 
+class Vector4f;
+
 #include <glad/glad.h>
 
 class ParticleTexture
@@ -11,9 +13,21 @@ private:
 	float opacity;
 	float glow;
 
+	//Where this sprite sheet is inside of the texture, in texture coordinates
+	float atlasX;
+	float atlasY;
+	float atlasWidth;
+	float atlasHeight;
+
+	//Sample the closest texel instead of interpolating
+	bool nearest;
+
 public:
 	ParticleTexture(GLuint textureID, int numberOfRows, float opacity, float glow);
 
+	//For a sprite sheet that was packed into an atlas. atlasRect is (x, y, width, height).
+	ParticleTexture(GLuint textureID, Vector4f* atlasRect, int numberOfRows, float opacity, float glow, bool nearest);
+
 	GLuint getTextureID();
 
 	int getNumberOfRows();
@@ -21,5 +35,15 @@ public:
 	float getOpacity();
 
 	float getGlow();
+
+	float getAtlasX();
+
+	float getAtlasY();
+
+	float getAtlasWidth();
+
+	float getAtlasHeight();
+
+	bool getNearest();
 };
 #endif
\ No newline at end of file
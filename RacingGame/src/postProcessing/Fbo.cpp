@@ -33,7 +33,7 @@ void Fbo::cleanUp()
 	glDeleteTextures(1, &depthTexture);
 	glDeleteRenderbuffers(1, &depthBuffer);
 	glDeleteRenderbuffers(1, &colourBuffer);
-	glDeleteRenderbuffers(1, &colourBuffer2);
+	glDeleteTextures(1, &colourTexture2);
 }
 
 void Fbo::bindFrameBuffer()
@@ -53,6 +53,11 @@ GLuint Fbo::getColourTexture()
 	return colourTexture;
 }
 
+GLuint Fbo::getColourTexture2()
+{
+	return colourTexture2;
+}
+
 void Fbo::resolveToFbo(int readBuffer, Fbo* outputFbo)
 {
 	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, outputFbo->frameBuffer);
@@ -69,7 +74,7 @@ void Fbo::initialiseFrameBuffer(int type)
 	if (multisampleAndMultiTarget)
 	{
 		colourBuffer = createMultisampleColourAttatchment(GL_COLOR_ATTACHMENT0);
-		colourBuffer2 = createMultisampleColourAttatchment(GL_COLOR_ATTACHMENT1);
+		colourTexture2 = createMultisampleTextureAttatchment(GL_COLOR_ATTACHMENT1);
 	}
 	else
 	{
@@ -140,6 +145,18 @@ GLuint Fbo::createMultisampleColourAttatchment(int attachment)
 	return colourBuffer;
 }
 
+GLuint Fbo::createMultisampleTextureAttatchment(int attachment)
+{
+	//Fixed sample locations have to be on when textures and renderbuffers are mixed
+	GLuint texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, texture);
+	glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, AA_SAMPLES, GL_RGBA8, width, height, GL_TRUE);
+	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D_MULTISAMPLE, texture, 0);
+	return texture;
+}
+
 void Fbo::createDepthBufferAttachment()
 {
 	glGenRenderbuffers(1, &depthBuffer);
@@ -1,19 +1,24 @@
 #include <glad/glad.h>
 #include <vector>
+#include <algorithm>
+#include <cstdio>
 
 #include "postprocessing.h"
 #include "../models/models.h"
+#include "../bloom/brightresolve.h"
 #include "../gaussianBlur/horizontalblur.h"
 #include "../gaussianBlur/verticalblur.h"
+#include "../bloom/upsamplefilter.h"
 #include "../bloom/combinefilter.h"
 #include "../renderEngine/renderEngine.h"
+#include "../engineTester/main.h"
 
 std::vector<float> PostProcessing::POSITIONS;
 RawModel        PostProcessing::quadModel;
-HorizontalBlur* PostProcessing::hBlur  = nullptr;
-VerticalBlur*   PostProcessing::vBlur  = nullptr;
-HorizontalBlur* PostProcessing::hBlur2 = nullptr;
-VerticalBlur*   PostProcessing::vBlur2 = nullptr;
+BrightResolve*  PostProcessing::brightResolve = nullptr;
+HorizontalBlur* PostProcessing::hBlurs[BLOOM_LEVELS];
+VerticalBlur*   PostProcessing::vBlurs[BLOOM_LEVELS];
+UpsampleFilter* PostProcessing::upsamples[BLOOM_LEVELS - 1];
 CombineFilter*  PostProcessing::combineFilter = nullptr;
 
 extern unsigned int SCR_WIDTH;
@@ -31,31 +36,79 @@ void PostProcessing::init()
 	PostProcessing::POSITIONS.push_back(-1);
 	
 	PostProcessing::quadModel = Loader::loadToVAO(&PostProcessing::POSITIONS, 2);
-	
-	PostProcessing::hBlur  = new HorizontalBlur(SCR_WIDTH/16, SCR_HEIGHT/16);
-	PostProcessing::vBlur  = new VerticalBlur  (SCR_WIDTH/16, SCR_HEIGHT/16);
-	PostProcessing::hBlur2 = new HorizontalBlur(SCR_WIDTH/6,  SCR_HEIGHT/6);
-	PostProcessing::vBlur2 = new VerticalBlur  (SCR_WIDTH/6,  SCR_HEIGHT/6);
-	PostProcessing::combineFilter = new CombineFilter;
+
+	int resolveWidth  = std::max(1, (int)SCR_WIDTH/2);
+	int resolveHeight = std::max(1, (int)SCR_HEIGHT/2);
+	PostProcessing::brightResolve = new BrightResolve(resolveWidth, resolveHeight); INCR_NEW
+
+	//The horizontal blur of each level reads the level above it, so it halves the size on the way
+	int widths[BLOOM_LEVELS];
+	int heights[BLOOM_LEVELS];
+	for (int i = 0; i < BLOOM_LEVELS; i++)
+	{
+		widths[i]  = std::max(1, (int)SCR_WIDTH  >> (i + 2));
+		heights[i] = std::max(1, (int)SCR_HEIGHT >> (i + 2));
+		PostProcessing::hBlurs[i] = new HorizontalBlur(widths[i], heights[i]); INCR_NEW
+		PostProcessing::vBlurs[i] = new VerticalBlur  (widths[i], heights[i]); INCR_NEW
+	}
+	for (int i = 0; i < BLOOM_LEVELS - 1; i++)
+	{
+		PostProcessing::upsamples[i] = new UpsampleFilter(widths[i], heights[i], widths[i + 1], heights[i + 1]); INCR_NEW
+	}
+
+	//Used to be half of a single blur, now it is spread over every level
+	PostProcessing::combineFilter = new CombineFilter(0.5f/BLOOM_LEVELS); INCR_NEW
+
+	#ifdef DEV_MODE
+	int pixels = resolveWidth*resolveHeight;
+	for (int i = 0; i < BLOOM_LEVELS; i++)
+	{
+		pixels += 2*widths[i]*heights[i];
+		if (i < BLOOM_LEVELS - 1)
+		{
+			pixels += widths[i]*heights[i];
+		}
+	}
+	std::fprintf(stdout, "Bloom: %d pixels drawn before the combine, %f of the screen\n",
+		pixels, (float)pixels/(SCR_WIDTH*SCR_HEIGHT));
+	#endif
 }
 
-void PostProcessing::doPostProcessing(int colourTexture, int brightTexture)
+void PostProcessing::doPostProcessing(int colourTexture, GLuint brightTexture)
 {
 	PostProcessing::start();
-	PostProcessing::hBlur2->render(brightTexture);
-	PostProcessing::vBlur2->render(PostProcessing::hBlur2->getOutputTexture());
-	PostProcessing::hBlur->render(PostProcessing::vBlur2->getOutputTexture());
-	PostProcessing::vBlur->render(PostProcessing::hBlur->getOutputTexture());
-	PostProcessing::combineFilter->render(colourTexture, PostProcessing::vBlur->getOutputTexture());
+	PostProcessing::brightResolve->render(brightTexture);
+
+	GLuint source = PostProcessing::brightResolve->getOutputTexture();
+	for (int i = 0; i < BLOOM_LEVELS; i++)
+	{
+		PostProcessing::hBlurs[i]->render(source);
+		PostProcessing::vBlurs[i]->render(PostProcessing::hBlurs[i]->getOutputTexture());
+		source = PostProcessing::vBlurs[i]->getOutputTexture();
+	}
+
+	for (int i = BLOOM_LEVELS - 2; i >= 0; i--)
+	{
+		PostProcessing::upsamples[i]->render(PostProcessing::vBlurs[i]->getOutputTexture(), source);
+		source = PostProcessing::upsamples[i]->getOutputTexture();
+	}
+
+	PostProcessing::combineFilter->render(colourTexture, source);
 	PostProcessing::end();
 }
 
 void PostProcessing::cleanUp()
 {
-	PostProcessing::hBlur->cleanUp();
-	PostProcessing::vBlur->cleanUp();
-	PostProcessing::hBlur2->cleanUp();
-	PostProcessing::vBlur2->cleanUp();
+	PostProcessing::brightResolve->cleanUp();
+	for (int i = 0; i < BLOOM_LEVELS; i++)
+	{
+		PostProcessing::hBlurs[i]->cleanUp();
+		PostProcessing::vBlurs[i]->cleanUp();
+	}
+	for (int i = 0; i < BLOOM_LEVELS - 1; i++)
+	{
+		PostProcessing::upsamples[i]->cleanUp();
+	}
 	PostProcessing::combineFilter->cleanUp();
 }
 
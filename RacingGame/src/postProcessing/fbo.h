@@ -14,12 +14,15 @@ private:
 
 	bool multisampleAndMultiTarget;
 	
-	GLuint colourTexture;
-	GLuint depthTexture;
+	GLuint colourTexture = 0;
+	GLuint depthTexture = 0;
 
-	GLuint depthBuffer;
-	GLuint colourBuffer;
-	GLuint colourBuffer2;
+	GLuint depthBuffer = 0;
+	GLuint colourBuffer = 0;
+
+	//The second target of the multisampled fbo is a texture, so bloom can read it
+	// straight away instead of resolving it first
+	GLuint colourTexture2 = 0;
 	
 public:
 	static int NONE;
@@ -39,6 +42,9 @@ public:
 	//void bindToRead();
 	
 	GLuint getColourTexture();
+
+	//Multisampled texture of GL_COLOR_ATTACHMENT1
+	GLuint getColourTexture2();
 	
 	//int getDepthTexture();
 	
@@ -58,6 +64,8 @@ private:
 	void createDepthTextureAttachment();
 	
 	GLuint createMultisampleColourAttatchment(int attachment);
+
+	GLuint createMultisampleTextureAttatchment(int attachment);
 	
 	void createDepthBufferAttachment();
 };
@@ -1,29 +1,39 @@
 #ifndef POSTPROCESSING_H
 #define POSTPROCESSING_H
 
+class BrightResolve;
 class HorizontalBlur;
 class VerticalBlur;
+class UpsampleFilter;
 class CombineFilter;
 
+#include <glad/glad.h>
 #include <vector>
 #include "../models/models.h"
 
+//Bloom is done as a chain of smaller and smaller blurred copies of the bright target,
+// which then get added back together on the way up. Everything but the final
+// combine runs at a quarter of the screen's pixels or less.
 class PostProcessing 
 {
 private:
+	//Level 0 is a quarter of the screen size in each direction, each level after is half of the last
+	static const int BLOOM_LEVELS = 4;
+
 	static std::vector<float> POSITIONS;
 	static RawModel quadModel;
-	static HorizontalBlur* hBlur;
-	static VerticalBlur*   vBlur;
-	static HorizontalBlur* hBlur2;
-	static VerticalBlur*   vBlur2;
+	static BrightResolve*  brightResolve;
+	static HorizontalBlur* hBlurs[BLOOM_LEVELS];
+	static VerticalBlur*   vBlurs[BLOOM_LEVELS];
+	static UpsampleFilter* upsamples[BLOOM_LEVELS - 1];
 	static CombineFilter* combineFilter;
 	
 public:
 
 	static void init();
 	
-	static void doPostProcessing(int colourTexture, int brightTexture);
+	//brightTexture is the multisampled texture of the scene's second colour target
+	static void doPostProcessing(int colourTexture, GLuint brightTexture);
 	
 	static void cleanUp();
 	
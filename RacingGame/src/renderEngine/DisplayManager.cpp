@@ -12,6 +12,7 @@
 #include "../toolbox/input.h"
 #include "../engineTester/main.h"
 #include "../toolbox/split.h"
+#include "../toolbox/resourcemanager.h"
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void window_close_callback(GLFWwindow* window);
@@ -349,6 +350,17 @@ void loadGraphicsSettings()
 						Global::renderBloom = false;
 					}
 				}
+				else if (strcmp(lineSplit[0], "Transparency_OIT") == 0)
+				{
+					if (strcmp(lineSplit[1], "on") == 0)
+					{
+						Global::renderTransparencyOIT = true;
+					}
+					else
+					{
+						Global::renderTransparencyOIT = false;
+					}
+				}
 				else if (strcmp(lineSplit[0], "Render_Shadows_Far") == 0)
 				{
 					if (strcmp(lineSplit[1], "on") == 0)
@@ -375,6 +387,14 @@ void loadGraphicsSettings()
 				{
 					Global::shadowsFarQuality = std::stoi(lineSplit[1], nullptr, 10);
 				}
+				else if (strcmp(lineSplit[0], "Shadow_Cascades") == 0)
+				{
+					Global::shadowCascades = std::stoi(lineSplit[1], nullptr, 10);
+				}
+				else if (strcmp(lineSplit[0], "Resource_Cache_MB") == 0)
+				{
+					ResourceManager::setMemoryBudget(std::stoll(lineSplit[1], nullptr, 10)*1024*1024);
+				}
 			}
 			free(lineSplit);
 		}
@@ -8,10 +8,17 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
 
 #include "renderEngine.h"
 
 #include "../models/models.h"
+#include "../toolbox/vector.h"
+#include "../engineTester/main.h"
+#include "../toolbox/backgroundloader.h"
+#include "../textures/cookedtexture.h"
 
 std::list<GLuint> Loader::vaos;
 std::list<GLuint> Loader::vbos;
@@ -21,63 +28,343 @@ int Loader::vaoNumber = 0;
 int Loader::vboNumber = 0;
 int Loader::texNumber = 0;
 
+long long Loader::packedVertexBytes = 0;
+long long Loader::floatVertexBytes = 0;
+
+long long Loader::bytesUploaded = 0;
+
+long long Loader::textureBytes = 0;
+long long Loader::rgbaTextureBytes = 0;
+
+int Loader::compressionSupported = -1;
+
 RawModel Loader::loadToVAO(std::vector<float>* positions, std::vector<float>* textureCoords, std::vector<float>* normals, std::vector<int>* indicies)
 {
-	GLuint vaoID = createVAO();
+	GLuint vaoID = 0;
 	std::list<GLuint> vboIDs;
+	BackgroundLoader::runOnMainThread([&]()
+	{
+		vaoID = createVAO();
 
-	vboIDs.push_back(bindIndiciesBuffer(indicies));
-	vboIDs.push_back(storeDataInAttributeList(0, 3, positions));
-	vboIDs.push_back(storeDataInAttributeList(1, 2, textureCoords));
-	vboIDs.push_back(storeDataInAttributeList(2, 3, normals));
+		vboIDs.push_back(bindIndiciesBuffer(indicies));
+		vboIDs.push_back(storeDataInAttributeList(0, 3, positions));
+		vboIDs.push_back(storeDataInAttributeList(1, 2, textureCoords));
+		vboIDs.push_back(storeDataInAttributeList(2, 3, normals));
 
-	unbindVAO();
+		unbindVAO();
+	});
 
-	return RawModel(vaoID, (int)indicies->size(), &vboIDs);
+	RawModel rawModel(vaoID, (int)indicies->size(), &vboIDs);
+
+	if (indicies->size() > 0)
+	{
+		calculateCenter(&rawModel, &(*positions)[0], 3, &(*indicies)[0], (int)indicies->size());
+	}
+
+	return rawModel;
 }
 
-//for text
-std::vector<int> Loader::loadToVAO(std::vector<float>* positions, std::vector<float>* textureCoords)
+std::vector<RawModel> Loader::loadToVAOBatch(std::vector<float>* vertices, std::vector<std::vector<int>>* indices, bool hasTextureLayers)
 {
-	std::vector<int> vertexObjects;
+	const int stride = hasTextureLayers ? 9 : 8;
 
-	vertexObjects.push_back(createVAO());
-	vertexObjects.push_back(storeDataInAttributeList(0, 2, positions));
-	vertexObjects.push_back(storeDataInAttributeList(1, 2, textureCoords));
-	unbindVAO();
+	std::vector<int> allIndices;
+	for (std::vector<int>& range : (*indices))
+	{
+		allIndices.insert(allIndices.end(), range.begin(), range.end());
+	}
+
+	//A model file with nothing in it gets no models at all
+	if (vertices->size() == 0 || allIndices.size() == 0)
+	{
+		return std::vector<RawModel>();
+	}
+
+	//Models with fewer than 65536 vertices only need half as much memory for the indices
+	GLenum indexType = GL_UNSIGNED_INT;
+	std::vector<GLushort> shortIndices;
+	if ((int)vertices->size()/stride < 65536)
+	{
+		indexType = GL_UNSIGNED_SHORT;
+		shortIndices.assign(allIndices.begin(), allIndices.end());
+	}
+
+	PackedVertexFormat format;
+	choosePackedFormat(vertices, stride, hasTextureLayers, &format);
+	std::vector<char> packed;
+	packVertices(vertices, stride, hasTextureLayers, &format, &packed);
+
+	//Everything up to here can be done on a loading thread, only this part needs the gl context
+	GLuint vaoID = 0;
+	std::list<GLuint> vboIDs;
+	BackgroundLoader::runOnMainThread([&]()
+	{
+		vaoID = createVAO();
+
+		if (indexType == GL_UNSIGNED_SHORT)
+		{
+			vboIDs.push_back(bindIndiciesBuffer(&shortIndices));
+		}
+		else
+		{
+			vboIDs.push_back(bindIndiciesBuffer(&allIndices));
+		}
+
+		GLuint vboID = 0;
+		glGenBuffers(1, &vboID);
+		vboNumber++;
+		vbos.push_back(vboID);
+		vboIDs.push_back(vboID);
+		glBindBuffer(GL_ARRAY_BUFFER, vboID);
+		glBufferData(GL_ARRAY_BUFFER, packed.size(), (GLvoid*)packed.data(), GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 3, format.positionType, GL_FALSE, format.stride, (GLvoid*)(size_t)format.positionOffset);
+		glVertexAttribPointer(1, 2, format.textureCoordType, format.textureCoordType != GL_FLOAT, format.stride, (GLvoid*)(size_t)format.textureCoordOffset);
+		glVertexAttribPointer(2, 4, GL_INT_2_10_10_10_REV, GL_TRUE, format.stride, (GLvoid*)(size_t)format.normalOffset);
+		if (hasTextureLayers)
+		{
+			//The renderers only enable attributes 0 to 2, so this one stays enabled in the VAO
+			glVertexAttribPointer(3, 1, GL_SHORT, GL_FALSE, format.stride, (GLvoid*)(size_t)format.textureLayerOffset);
+			glEnableVertexAttribArray(3);
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		bytesUploaded += packed.size();
+		packedVertexBytes += packed.size();
+		floatVertexBytes += vertices->size()*sizeof(float);
+		#ifdef DEV_MODE
+		std::fprintf(stdout, "Vertices: %d bytes each instead of %d, %lld KB packed so far instead of %lld KB\n",
+			format.stride, (int)(stride*sizeof(float)), packedVertexBytes/1024, floatVertexBytes/1024);
+		#endif
+
+		unbindVAO();
+	});
+
+	std::vector<RawModel> rawModels;
+	std::list<GLuint> noVBOs;
+	int firstIndex = 0;
+	for (std::vector<int>& range : (*indices))
+	{
+		//only the first model owns the buffers
+		RawModel rawModel(vaoID, (int)range.size(), (rawModels.size() == 0) ? &vboIDs : &noVBOs);
+		rawModel.setFirstIndex(firstIndex);
+		rawModel.setIndexType(indexType);
+
+		if (range.size() > 0)
+		{
+			calculateCenter(&rawModel, &(*vertices)[0], stride, &range[0], (int)range.size());
+		}
+
+		rawModels.push_back(rawModel);
+		firstIndex += (int)range.size();
+	}
+
+	return rawModels;
+}
+
+void Loader::choosePackedFormat(std::vector<float>* vertices, int floatStride, bool hasTextureLayers, PackedVertexFormat* format)
+{
+	bool smallPositions = true;
+	bool unitTextureCoords = true;
+	int vertexCount = (int)vertices->size()/floatStride;
+	for (int v = 0; v < vertexCount; v++)
+	{
+		float* vertex = &(*vertices)[v*floatStride];
+		for (int i = 0; i < 3; i++)
+		{
+			if (fabsf(vertex[i]) > HALF_POSITION_LIMIT)
+			{
+				smallPositions = false;
+			}
+		}
+		for (int i = 3; i < 5; i++)
+		{
+			if (vertex[i] < 0.0f || vertex[i] > 1.0f)
+			{
+				unitTextureCoords = false;
+			}
+		}
+	}
+
+	//Every attribute starts on 4 bytes
+	format->positionType = smallPositions ? GL_HALF_FLOAT : GL_FLOAT;
+	format->positionOffset = 0;
+	format->textureCoordType = unitTextureCoords ? GL_UNSIGNED_SHORT : GL_FLOAT;
+	format->textureCoordOffset = smallPositions ? 8 : 12;
+	format->normalOffset = format->textureCoordOffset + (unitTextureCoords ? 4 : 8);
+	format->textureLayerOffset = format->normalOffset + 4;
+	format->stride = format->textureLayerOffset + (hasTextureLayers ? 4 : 0);
+}
+
+void Loader::packVertices(std::vector<float>* vertices, int floatStride, bool hasTextureLayers, PackedVertexFormat* format, std::vector<char>* packed)
+{
+	int vertexCount = (int)vertices->size()/floatStride;
+	packed->assign(vertexCount*format->stride, 0);
+	for (int v = 0; v < vertexCount; v++)
+	{
+		float* vertex = &(*vertices)[v*floatStride];
+		char* out = &(*packed)[v*format->stride];
+
+		if (format->positionType == GL_HALF_FLOAT)
+		{
+			GLushort position[3] = {floatToHalf(vertex[0]), floatToHalf(vertex[1]), floatToHalf(vertex[2])};
+			memcpy(out + format->positionOffset, position, sizeof(position));
+		}
+		else
+		{
+			memcpy(out + format->positionOffset, vertex, 3*sizeof(float));
+		}
+
+		if (format->textureCoordType == GL_UNSIGNED_SHORT)
+		{
+			GLushort textureCoord[2] = {(GLushort)lroundf(vertex[3]*65535), (GLushort)lroundf(vertex[4]*65535)};
+			memcpy(out + format->textureCoordOffset, textureCoord, sizeof(textureCoord));
+		}
+		else
+		{
+			memcpy(out + format->textureCoordOffset, &vertex[3], 2*sizeof(float));
+		}
+
+		GLuint normal = packNormal(vertex[5], vertex[6], vertex[7]);
+		memcpy(out + format->normalOffset, &normal, sizeof(normal));
+
+		if (hasTextureLayers)
+		{
+			GLshort layer = (GLshort)lroundf(vertex[8]);
+			memcpy(out + format->textureLayerOffset, &layer, sizeof(layer));
+		}
+	}
+}
+
+GLushort Loader::floatToHalf(float value)
+{
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	unsigned int sign = (bits >> 16) & 0x8000;
+	int exponent = (int)((bits >> 23) & 0xFF) - 127 + 15;
+	unsigned int mantissa = bits & 0x7FFFFF;
 
-	return vertexObjects;
+	if (exponent <= 0)
+	{
+		//Too small for a normal half, so it turns into a denormal or 0
+		if (exponent < -10)
+		{
+			return (GLushort)sign;
+		}
+		mantissa |= 0x800000;
+		int shift = 14 - exponent;
+		unsigned int half = mantissa >> shift;
+		if ((mantissa >> (shift - 1)) & 1)
+		{
+			half++;
+		}
+		return (GLushort)(sign | half);
+	}
+
+	if (exponent >= 31)
+	{
+		return (GLushort)(sign | 0x7C00);
+	}
+
+	//Rounding up can carry into the exponent, which is still the right answer
+	unsigned int half = sign | (exponent << 10) | (mantissa >> 13);
+	if (mantissa & 0x1000)
+	{
+		half++;
+	}
+	return (GLushort)half;
+}
+
+GLuint Loader::packNormal(float x, float y, float z)
+{
+	int nx = (int)lroundf(fmaxf(-1.0f, fminf(1.0f, x))*511);
+	int ny = (int)lroundf(fmaxf(-1.0f, fminf(1.0f, y))*511);
+	int nz = (int)lroundf(fmaxf(-1.0f, fminf(1.0f, z))*511);
+	return (GLuint)(nx & 0x3FF) | ((GLuint)(ny & 0x3FF) << 10) | ((GLuint)(nz & 0x3FF) << 20);
+}
+
+void Loader::calculateCenter(RawModel* model, float* positions, int stride, int* indices, int indexCount)
+{
+	//The same vertex arrays can be shared between many models, so only look at what the indices use
+	int first = indices[0]*stride;
+	float minX = positions[first+0], maxX = minX;
+	float minY = positions[first+1], maxY = minY;
+	float minZ = positions[first+2], maxZ = minZ;
+	for (int i = 0; i < indexCount; i++)
+	{
+		float* p = &positions[indices[i]*stride];
+		minX = fminf(minX, p[0]); maxX = fmaxf(maxX, p[0]);
+		minY = fminf(minY, p[1]); maxY = fmaxf(maxY, p[1]);
+		minZ = fminf(minZ, p[2]); maxZ = fmaxf(maxZ, p[2]);
+	}
+	Vector3f center((minX+maxX)*0.5f, (minY+maxY)*0.5f, (minZ+maxZ)*0.5f);
+	model->setCenter(&center);
+
+	Vector3f halfSize((maxX-minX)*0.5f, (maxY-minY)*0.5f, (maxZ-minZ)*0.5f);
+	model->setRadius(halfSize.length());
 }
 
 //for water
 RawModel Loader::loadToVAO(std::vector<float>* positions, int dimensions)
 {
-	GLuint vaoID = createVAO();
+	GLuint vaoID = 0;
 	std::list<GLuint> vboIDs;
+	BackgroundLoader::runOnMainThread([&]()
+	{
+		vaoID = createVAO();
 
-	vboIDs.push_back(storeDataInAttributeList(0, dimensions, positions));
+		vboIDs.push_back(storeDataInAttributeList(0, dimensions, positions));
 
-	unbindVAO();
+		unbindVAO();
+	});
 
 	return RawModel(vaoID, (int)positions->size() / dimensions, &vboIDs);
 }
 
 GLuint Loader::loadTexture(const char* fileName)
 {
+	//These are mostly for the menus and fonts, which are small and need their exact colors
+	CookedTexture image;
+	if (!image.load(fileName, false))
+	{
+		return 0;
+	}
+
 	GLuint textureID = 0;
-	glGenTextures(1, &textureID);
-	texNumber++;
-	textures.push_back(textureID);
+	BackgroundLoader::runOnMainThread([&]()
+	{
+		textureID = uploadCookedTexture(&image);
+	});
 
-	int width, height, channels;
-	unsigned char* image = SOIL_load_image(fileName, &width, &height, &channels, SOIL_LOAD_RGBA);
+	return textureID;
+}
 
-	if (image == 0)
+void Loader::loadTextures(std::vector<std::string>* fileNames, std::vector<GLuint>* textureIDs)
+{
+	std::vector<CookedTexture> images;
+	CookedTexture::loadAll(fileNames, isTextureCompressionSupported(), &images);
+
+	textureIDs->assign(fileNames->size(), 0);
+	for (unsigned int i = 0; i < images.size(); i++)
 	{
-		const char* err = SOIL_last_result();
-		std::fprintf(stdout, "Error loading image '%s', because '%s'\n", fileName, err);
-		return 0;
+		if (images[i].width == 0)
+		{
+			continue;
+		}
+
+		BackgroundLoader::runOnMainThread([&]()
+		{
+			(*textureIDs)[i] = uploadCookedTexture(&images[i]);
+		});
 	}
+}
+
+GLuint Loader::uploadCookedTexture(CookedTexture* image)
+{
+	GLuint textureID = 0;
+	glGenTextures(1, &textureID);
+	texNumber++;
+	textures.push_back(textureID);
 
 	glBindTexture(GL_TEXTURE_2D, textureID);
 
@@ -85,17 +372,311 @@ GLuint Loader::loadTexture(const char* fileName)
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-	//Texel interpolation
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	//create, with the mipmaps that were already made
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)image->levels.size() - 1);
+	for (int level = 0; level < (int)image->levels.size(); level++)
+	{
+		int width  = std::max(1, image->width  >> level);
+		int height = std::max(1, image->height >> level);
+		std::vector<unsigned char>* data = &image->levels[level];
+		if (image->isCompressed())
+		{
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, image->format, width, height, 0, (GLsizei)data->size(), &(*data)[0]);
+		}
+		else
+		{
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, &(*data)[0]);
+		}
+	}
+
+	setFiltering(GL_TEXTURE_2D);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	bytesUploaded += image->getByteCount();
+	textureBytes += image->getByteCount();
+	rgbaTextureBytes += image->getRGBAByteCount();
+
+	return textureID;
+}
+
+bool Loader::isTextureCompressionSupported()
+{
+	if (compressionSupported == -1)
+	{
+		BackgroundLoader::runOnMainThread([&]()
+		{
+			compressionSupported = glfwExtensionSupported("GL_EXT_texture_compression_s3tc") ? 1 : 0;
+		});
+	}
+
+	return compressionSupported == 1;
+}
+
+void Loader::loadTexturesPacked(std::vector<std::string>* fileNames, std::vector<GLuint>* textureIDs, std::vector<int>* layers)
+{
+	//the same image can be used by more than one material, so it only gets loaded the first time
+	std::vector<int> firstWithSameName;
+	std::vector<std::string> uniqueFileNames;
+	std::vector<int> uniqueIndex;
+	for (unsigned int i = 0; i < fileNames->size(); i++)
+	{
+		int first = i;
+		for (unsigned int j = 0; j < i; j++)
+		{
+			if ((*fileNames)[j] == (*fileNames)[i])
+			{
+				first = j;
+				break;
+			}
+		}
+
+		firstWithSameName.push_back(first);
+		if (first == (int)i)
+		{
+			uniqueIndex.push_back(i);
+			uniqueFileNames.push_back((*fileNames)[i]);
+		}
+	}
+
+	std::vector<CookedTexture> images;
+	CookedTexture::loadAll(&uniqueFileNames, isTextureCompressionSupported(), &images);
+
+	textureIDs->assign(fileNames->size(), 0);
+	layers->assign(fileNames->size(), -1);
+
+	GLint maxLayers = 256;
+	BackgroundLoader::runOnMainThread([&]()
+	{
+		glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+	});
+
+	std::vector<int> group;
+	for (unsigned int i = 0; i < images.size(); i++)
+	{
+		CookedTexture* first = &images[i];
+		if (first->width == 0 || (*textureIDs)[uniqueIndex[i]] != 0)
+		{
+			continue;
+		}
+
+		//every image left that is the same size and format goes into the same array
+		group.clear();
+		for (unsigned int j = i; j < images.size() && (int)group.size() < maxLayers; j++)
+		{
+			CookedTexture* other = &images[j];
+			if (other->width != 0 && (*textureIDs)[uniqueIndex[j]] == 0 &&
+				other->width == first->width && other->height == first->height &&
+				other->format == first->format && other->levels.size() == first->levels.size())
+			{
+				group.push_back(j);
+			}
+		}
+
+		//Each texture gets uploaded on its own, so that a loading screen can keep going in between
+		GLuint textureID = 0;
+		BackgroundLoader::runOnMainThread([&]()
+		{
+			if (group.size() == 1)
+			{
+				textureID = uploadCookedTexture(first);
+				return;
+			}
+
+			glGenTextures(1, &textureID);
+			texNumber++;
+			textures.push_back(textureID);
+
+			GLsizei layerCount = (GLsizei)group.size();
+			glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, (GLint)first->levels.size() - 1);
+			for (int level = 0; level < (int)first->levels.size(); level++)
+			{
+				int width  = std::max(1, first->width  >> level);
+				int height = std::max(1, first->height >> level);
+				GLsizei levelSize = (GLsizei)first->levels[level].size();
+				if (first->isCompressed())
+				{
+					glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, first->format, width, height, layerCount, 0, levelSize*layerCount, nullptr);
+				}
+				else
+				{
+					glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA, width, height, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+				}
+
+				for (int layer = 0; layer < layerCount; layer++)
+				{
+					std::vector<unsigned char>* data = &images[group[layer]].levels[level];
+					if (first->isCompressed())
+					{
+						glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1, first->format, levelSize, &(*data)[0]);
+					}
+					else
+					{
+						glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, &(*data)[0]);
+					}
+				}
+			}
+			setFiltering(GL_TEXTURE_2D_ARRAY);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+			for (int layer = 0; layer < layerCount; layer++)
+			{
+				bytesUploaded += images[group[layer]].getByteCount();
+				textureBytes += images[group[layer]].getByteCount();
+				rgbaTextureBytes += images[group[layer]].getRGBAByteCount();
+			}
+		});
+
+		if (group.size() == 1)
+		{
+			(*textureIDs)[uniqueIndex[i]] = textureID;
+			continue;
+		}
+
+		for (unsigned int layer = 0; layer < group.size(); layer++)
+		{
+			int index = uniqueIndex[group[layer]];
+			(*textureIDs)[index] = textureID;
+			(*layers)[index] = layer;
+		}
+	}
+
+	for (unsigned int i = 0; i < fileNames->size(); i++)
+	{
+		(*textureIDs)[i] = (*textureIDs)[firstWithSameName[i]];
+		(*layers)[i]     = (*layers)[firstWithSameName[i]];
+	}
+}
+
+GLuint Loader::loadTextureAtlas(std::vector<std::string>* fileNames, int padding, int maxMipLevel, std::vector<Vector4f>* rects)
+{
+	struct Image
+	{
+		unsigned char* data;
+		int width;
+		int height;
+		int x;
+		int y;
+	};
+
+	rects->assign(fileNames->size(), Vector4f(0, 0, 0, 0));
+
+	std::vector<Image> images;
+	std::vector<int> order;
+	int widest = 0;
+	for (unsigned int i = 0; i < fileNames->size(); i++)
+	{
+		Image image;
+		image.x = 0;
+		image.y = 0;
+		int channels;
+		image.data = SOIL_load_image((*fileNames)[i].c_str(), &image.width, &image.height, &channels, SOIL_LOAD_RGBA);
+		if (image.data == 0)
+		{
+			const char* err = SOIL_last_result();
+			std::fprintf(stdout, "Error loading image '%s', because '%s'\n", (*fileNames)[i].c_str(), err);
+		}
+		else
+		{
+			order.push_back(i);
+			widest = std::max(widest, image.width + 2*padding);
+		}
+		images.push_back(image);
+	}
 
-	//create
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+	int atlasWidth = 2048;
+	while (atlasWidth < widest)
+	{
+		atlasWidth *= 2;
+	}
+
+	//Shelf packing, tallest images first
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return images[a].height > images[b].height; });
 
+	int x = 0;
+	int y = 0;
+	int shelfHeight = 0;
+	for (int index : order)
+	{
+		Image* image = &images[index];
+		int width  = image->width  + 2*padding;
+		int height = image->height + 2*padding;
+		if (x + width > atlasWidth)
+		{
+			x = 0;
+			y += shelfHeight;
+			shelfHeight = 0;
+		}
+		image->x = x + padding;
+		image->y = y + padding;
+		x += width;
+		shelfHeight = std::max(shelfHeight, height);
+	}
+
+	int atlasHeight = 1;
+	while (atlasHeight < y + shelfHeight)
+	{
+		atlasHeight *= 2;
+	}
+
+	std::vector<unsigned char> pixels(atlasWidth*atlasHeight*4, 0);
+	for (int index : order)
+	{
+		Image* image = &images[index];
+		for (int row = -padding; row < image->height + padding; row++)
+		{
+			int srcRow = std::min(std::max(row, 0), image->height - 1);
+			for (int col = -padding; col < image->width + padding; col++)
+			{
+				int srcCol = std::min(std::max(col, 0), image->width - 1);
+				unsigned char* src = &image->data[(srcRow*image->width + srcCol)*4];
+				unsigned char* dst = &pixels[((image->y + row)*atlasWidth + image->x + col)*4];
+				memcpy(dst, src, 4);
+			}
+		}
+
+		(*rects)[index].set((float)image->x/atlasWidth, (float)image->y/atlasHeight,
+			(float)image->width/atlasWidth, (float)image->height/atlasHeight);
+
+		SOIL_free_image_data(image->data);
+	}
+
+	GLuint textureID = 0;
+	BackgroundLoader::runOnMainThread([&]()
+	{
+		glGenTextures(1, &textureID);
+		texNumber++;
+		textures.push_back(textureID);
+
+		glBindTexture(GL_TEXTURE_2D, textureID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxMipLevel);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, atlasWidth, atlasHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+		bytesUploaded += (long long)atlasWidth*atlasHeight*4;
+		setMipmapFiltering(GL_TEXTURE_2D);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	});
+
+	return textureID;
+}
+
+void Loader::setMipmapFiltering(GLenum target)
+{
 	//create mipmap
-	glGenerateMipmap(GL_TEXTURE_2D);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, 0.0f); //set to 0 if using anisotropic, around -0.4f if not
+	glGenerateMipmap(target);
+	setFiltering(target);
+}
+
+void Loader::setFiltering(GLenum target)
+{
+	//Texel interpolation
+	glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameterf(target, GL_TEXTURE_LOD_BIAS, 0.0f); //set to 0 if using anisotropic, around -0.4f if not
 
 	if (glfwExtensionSupported("GL_EXT_texture_filter_anisotropic"))
 	{
@@ -106,24 +687,12 @@ GLuint Loader::loadTexture(const char* fileName)
 		float maxAnisotropyLevel;
 		glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropyLevel);
 		float amountToUse = fmin(4.0f, maxAnisotropyLevel);
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, amountToUse);
+		glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY_EXT, amountToUse);
 	}
-
-	SOIL_free_image_data(image);
-
-	glBindTexture(GL_TEXTURE_2D, 0);
-	
-
-	return textureID;
 }
 
 GLuint Loader::loadTextureNoInterpolation(const char* fileName)
 {
-	GLuint textureID = 0;
-	glGenTextures(1, &textureID);
-	texNumber++;
-	textures.push_back(textureID);
-
 	int width, height, channels;
 	unsigned char* image = SOIL_load_image(fileName, &width, &height, &channels, SOIL_LOAD_RGBA);
 
@@ -134,23 +703,31 @@ GLuint Loader::loadTextureNoInterpolation(const char* fileName)
 		return 0;
 	}
 
-	glBindTexture(GL_TEXTURE_2D, textureID);
+	GLuint textureID = 0;
+	BackgroundLoader::runOnMainThread([&]()
+	{
+		glGenTextures(1, &textureID);
+		texNumber++;
+		textures.push_back(textureID);
 
-	//Texture wrapping
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glBindTexture(GL_TEXTURE_2D, textureID);
 
-	//Texel interpolation
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		//Texture wrapping
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-	//create
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+		//Texel interpolation
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-	SOIL_free_image_data(image);
+		//create
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+		bytesUploaded += (long long)width*height*4;
 
-	glBindTexture(GL_TEXTURE_2D, 0);
-	
+		glBindTexture(GL_TEXTURE_2D, 0);
+	});
+
+	SOIL_free_image_data(image);
 
 	return textureID;
 }
@@ -174,12 +751,52 @@ GLuint Loader::storeDataInAttributeList(int attributeNumber, int coordinateSize,
 	glBindBuffer(GL_ARRAY_BUFFER, vboID);
 
 	glBufferData(GL_ARRAY_BUFFER, data->size()*sizeof(float), (GLvoid*)(&((*data)[0])), GL_STATIC_DRAW); 
+	bytesUploaded += data->size()*sizeof(float);
 	glVertexAttribPointer(attributeNumber, coordinateSize, GL_FLOAT, GL_FALSE, 0, 0); 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 	return vboID;
 }
 
+GLuint Loader::createStreamingVbo(int sizeInBytes)
+{
+	GLuint vboID = 0;
+	glGenBuffers(1, &vboID);
+	vboNumber++;
+	vbos.push_back(vboID);
+	glBindBuffer(GL_ARRAY_BUFFER, vboID);
+	glBufferData(GL_ARRAY_BUFFER, sizeInBytes, nullptr, GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return vboID;
+}
+
+GLuint Loader::createStreamingVao(std::vector<int>* attributeSizes, int sizeInBytes, GLuint* vbo)
+{
+	GLuint vaoID = createVAO();
+	(*vbo) = createStreamingVbo(sizeInBytes);
+	glBindBuffer(GL_ARRAY_BUFFER, (*vbo));
+
+	int stride = 0;
+	for (int size : (*attributeSizes))
+	{
+		stride += size;
+	}
+
+	int offset = 0;
+	for (int i = 0; i < (int)attributeSizes->size(); i++)
+	{
+		glVertexAttribPointer(i, (*attributeSizes)[i], GL_FLOAT, GL_FALSE, stride*sizeof(float), (void*)(offset*sizeof(float)));
+		glEnableVertexAttribArray(i);
+		offset += (*attributeSizes)[i];
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	unbindVAO();
+
+	return vaoID;
+}
+
 GLuint Loader::bindIndiciesBuffer(std::vector<int>* indicies)
 {
 	GLuint vboID = 0;
@@ -188,7 +805,22 @@ GLuint Loader::bindIndiciesBuffer(std::vector<int>* indicies)
 	vboNumber++;
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboID);
 
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicies->size() * sizeof(int), (GLvoid*)(&((*indicies)[0])), GL_STATIC_DRAW);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicies->size() * sizeof(int), (GLvoid*)indicies->data(), GL_STATIC_DRAW);
+	bytesUploaded += indicies->size() * sizeof(int);
+
+	return vboID;
+}
+
+GLuint Loader::bindIndiciesBuffer(std::vector<GLushort>* indicies)
+{
+	GLuint vboID = 0;
+	glGenBuffers(1, &vboID);
+	vbos.push_back(vboID);
+	vboNumber++;
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboID);
+
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicies->size() * sizeof(GLushort), (GLvoid*)indicies->data(), GL_STATIC_DRAW);
+	bytesUploaded += indicies->size() * sizeof(GLushort);
 
 	return vboID;
 }
@@ -224,31 +856,59 @@ void Loader::cleanUp()
 
 void Loader::deleteVAO(GLuint vaoID)
 {
-	vaoNumber--;
-	glDeleteVertexArrays(1, &vaoID);
-	vaos.remove(vaoID);
+	BackgroundLoader::runOnMainThread([&]()
+	{
+		vaoNumber--;
+		glDeleteVertexArrays(1, &vaoID);
+		vaos.remove(vaoID);
+	});
 }
 
 void Loader::deleteVBO(GLuint vboID)
 {
-	vboNumber--;
-	glDeleteBuffers(1, &vboID);
-	vbos.remove(vboID);
+	BackgroundLoader::runOnMainThread([&]()
+	{
+		vboNumber--;
+		glDeleteBuffers(1, &vboID);
+		vbos.remove(vboID);
+	});
 }
 
 void Loader::deleteTexture(GLuint texID)
 {
-	texNumber--;
-	glDeleteTextures(1, &texID);
-	textures.remove(texID);
+	BackgroundLoader::runOnMainThread([&]()
+	{
+		texNumber--;
+		glDeleteTextures(1, &texID);
+		textures.remove(texID);
+	});
 }
 
 void Loader::deleteTexturedModels(std::list<TexturedModel*>* tm)
 {
+	//Materials in the same texture array, or with the same texture file,
+	// all have the same texture id, which can only be deleted once
+	std::vector<GLuint> texIDs;
 	for (auto model : (*tm))
 	{
-		model->deleteMe();
+		model->getRawModel()->deleteMe();
+
+		GLuint texID = model->getTexture()->getID();
+		if (std::find(texIDs.begin(), texIDs.end(), texID) == texIDs.end())
+		{
+			texIDs.push_back(texID);
+		}
 	}
+
+	for (GLuint texID : texIDs)
+	{
+		deleteTexture(texID);
+	}
+}
+
+long long Loader::getBytesUploaded()
+{
+	return bytesUploaded;
 }
 
 void Loader::printInfo()
@@ -256,6 +916,7 @@ void Loader::printInfo()
 	std::fprintf(stdout, "VAO Count = %d = %d\n", vaoNumber, (int)vaos.size());
 	std::fprintf(stdout, "VBO Count = %d = %d\n", vboNumber, (int)vbos.size());
 	std::fprintf(stdout, "TEX Count = %d = %d\n", texNumber, (int)textures.size());
+	std::fprintf(stdout, "TEX Memory = %lld KB (%lld KB as RGBA)\n", textureBytes/1024, rgbaTextureBytes/1024);
 
 	if (textures.size() == 3)
 	{
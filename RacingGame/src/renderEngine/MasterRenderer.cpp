@@ -14,7 +14,8 @@
 #include "../water/waterrenderer.h"
 #include "../particles/particlemaster.h"
 #include "../shadows/shadowmapmasterrenderer.h"
-#include "../shadows2/shadowmapmasterrenderer2.h"
+#include "../oit/weightedblendedoit.h"
+#include "../toolbox/framestats.h"
 
 #include <iostream>
 #include <list>
@@ -24,12 +25,17 @@
 ShaderProgram* shader;
 EntityRenderer* renderer;
 ShadowMapMasterRenderer* shadowMapRenderer;
-ShadowMapMasterRenderer2* shadowMapRenderer2;
+
+//Only used when Global::renderTransparencyOIT is on
+ShaderProgram* shaderOIT = nullptr;
+EntityRenderer* rendererOIT = nullptr;
+WeightedBlendedOit* weightedBlendedOit = nullptr;
 
 std::unordered_map<TexturedModel*, std::list<Entity*>> entitiesMap;
 std::unordered_map<TexturedModel*, std::list<Entity*>> entitiesMapPass2;
 std::unordered_map<TexturedModel*, std::list<Entity*>> entitiesMapPass3;
 std::unordered_map<TexturedModel*, std::list<Entity*>> entitiesTransparentMap;
+std::unordered_map<TexturedModel*, std::list<Entity*>> entitiesTransparentOITMap;
 
 Matrix4f* projectionMatrix;
 
@@ -42,82 +48,59 @@ float RED = 0.9f;
 float GREEN = 0.95f;
 float BLUE = 1.0f;
 
+extern unsigned int SCR_WIDTH;
+extern unsigned int SCR_HEIGHT;
+
 void prepare();
 void prepareTransparentRender();
-void prepareTransparentRenderDepthOnly();
+void loadFrameUniforms(ShaderProgram* program, Camera* camera, float clipX, float clipY, float clipZ, float clipW);
+void renderTransparentOIT(Camera* camera, float clipX, float clipY, float clipZ, float clipW);
+
+#ifdef DEV_MODE
+//Benchmark for the transparent passes. Prints the average gpu time
+// every few hundred frames, labelled with the current level.
+GLuint transparentTimerQuery = GL_NONE;
+bool transparentTimerWaiting = false;
+FrameStats transparentTimeStats;
+
+void beginTransparentTimer();
+void endTransparentTimer();
+#endif
 
 GLuint randomMap = GL_NONE;
 
 void Master_init()
 {
-	if (Global::renderShadowsFar)
+	if (Global::renderShadowsFar || Global::renderShadowsClose)
 	{
-		if (Global::renderShadowsClose)
+		if (Global::renderBloom)
 		{
-			if (Global::renderBloom)
+			switch (Global::shadowsFarQuality)
 			{
-				switch (Global::shadowsFarQuality)
-				{
-				case 0:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowBoth.txt", "res/Shaders/entity/fragmentShaderShadow1BothBloom.txt");  break;
-				case 1:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowBoth.txt", "res/Shaders/entity/fragmentShaderShadow9BothBloom.txt");  break;
-				default: shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowBoth.txt", "res/Shaders/entity/fragmentShaderShadow25BothBloom.txt"); break;
-				}
-			}
-			else
-			{
-				switch (Global::shadowsFarQuality)
-				{
-				case 0:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowBoth.txt", "res/Shaders/entity/fragmentShaderShadow1Both.txt");  break;
-				case 1:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowBoth.txt", "res/Shaders/entity/fragmentShaderShadow9Both.txt");  break;
-				default: shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowBoth.txt", "res/Shaders/entity/fragmentShaderShadow25Both.txt"); break;
-				}
+			case 0:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadow.txt", "res/Shaders/entity/fragmentShaderShadow1Bloom.txt");  break;
+			case 1:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadow.txt", "res/Shaders/entity/fragmentShaderShadow9Bloom.txt");  break;
+			default: shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadow.txt", "res/Shaders/entity/fragmentShaderShadow25Bloom.txt"); break;
 			}
 		}
 		else
 		{
-			if (Global::renderBloom)
-			{
-				switch (Global::shadowsFarQuality)
-				{
-				case 0:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowFar.txt", "res/Shaders/entity/fragmentShaderShadow1FarBloom.txt");  break;
-				case 1:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowFar.txt", "res/Shaders/entity/fragmentShaderShadow9FarBloom.txt");  break;
-				default: shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowFar.txt", "res/Shaders/entity/fragmentShaderShadow25FarBloom.txt"); break;
-				}
-			}
-			else
+			switch (Global::shadowsFarQuality)
 			{
-				switch (Global::shadowsFarQuality)
-				{
-				case 0:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowFar.txt", "res/Shaders/entity/fragmentShaderShadow1Far.txt");  break;
-				case 1:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowFar.txt", "res/Shaders/entity/fragmentShaderShadow9Far.txt");  break;
-				default: shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowFar.txt", "res/Shaders/entity/fragmentShaderShadow25Far.txt"); break;
-				}
+			case 0:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadow.txt", "res/Shaders/entity/fragmentShaderShadow1.txt");  break;
+			case 1:  shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadow.txt", "res/Shaders/entity/fragmentShaderShadow9.txt");  break;
+			default: shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadow.txt", "res/Shaders/entity/fragmentShaderShadow25.txt"); break;
 			}
 		}
 	}
 	else
 	{
-		if (Global::renderShadowsClose)
+		if (Global::renderBloom)
 		{
-			if (Global::renderBloom)
-			{
-				shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowClose.txt", "res/Shaders/entity/fragmentShaderShadowCloseBloom.txt");
-			}
-			else
-			{
-				shader = new ShaderProgram("res/Shaders/entity/vertexShaderShadowClose.txt", "res/Shaders/entity/fragmentShaderShadowClose.txt");
-			}
+			shader = new ShaderProgram("res/Shaders/entity/vertexShader.txt", "res/Shaders/entity/fragmentShaderBloom.txt");
 		}
 		else
 		{
-			if (Global::renderBloom)
-			{
-				shader = new ShaderProgram("res/Shaders/entity/vertexShader.txt", "res/Shaders/entity/fragmentShaderBloom.txt");
-			}
-			else
-			{
-				shader = new ShaderProgram("res/Shaders/entity/vertexShader.txt", "res/Shaders/entity/fragmentShader.txt");
-			}
+			shader = new ShaderProgram("res/Shaders/entity/vertexShader.txt", "res/Shaders/entity/fragmentShader.txt");
 		}
 	}
 	INCR_NEW
@@ -129,10 +112,24 @@ void Master_init()
 
 
 	shadowMapRenderer = new ShadowMapMasterRenderer; INCR_NEW
-	shadowMapRenderer2 = new ShadowMapMasterRenderer2; INCR_NEW
 
 	randomMap = Loader::loadTextureNoInterpolation("res/Images/randomMap.png");
 
+	//OIT needs the depth of the opaque scene copied into its own depth buffer, which only
+	// works from the bloom fbo. The window's depth buffer has stencil bits in it too.
+	if (Global::renderTransparencyOIT && !Global::renderBloom)
+	{
+		std::fprintf(stdout, "Transparency_OIT needs Render_Bloom on, turning it off\n");
+		Global::renderTransparencyOIT = false;
+	}
+
+	if (Global::renderTransparencyOIT)
+	{
+		shaderOIT = new ShaderProgram("res/Shaders/entity/vertexShader.txt", "res/Shaders/oit/oitFragment.txt"); INCR_NEW
+		rendererOIT = new EntityRenderer(shaderOIT, projectionMatrix); INCR_NEW
+		weightedBlendedOit = new WeightedBlendedOit(SCR_WIDTH, SCR_HEIGHT); INCR_NEW
+	}
+
 	Master_disableCulling();
 }
 
@@ -140,29 +137,125 @@ void Master_render(Camera* camera, float clipX, float clipY, float clipZ, float
 {
 	prepare();
 	shader->start();
-	shader->loadClipPlane(clipX, clipY, clipZ, clipW);
 	RED = SkyManager::getFogRed();
 	GREEN = SkyManager::getFogGreen();
 	BLUE = SkyManager::getFogBlue();
-	shader->loadSkyColour(RED, GREEN, BLUE);
-	shader->loadLight(Global::gameLightSun);
-	shader->loadViewMatrix(camera);
-	shader->connectTextureUnits();
+	loadFrameUniforms(shader, camera, clipX, clipY, clipZ, clipW);
+
+	renderer->resetStateChangeCounts();
+
+	renderer->queueEntities(&entitiesMap,      0, false, &camera->eye);
+	renderer->queueEntities(&entitiesMapPass2, 1, false, &camera->eye);
+	renderer->queueEntities(&entitiesMapPass3, 2, false, &camera->eye);
+	renderer->sortQueue();
+	renderer->renderQueue();
+	renderer->clearQueue();
 
-	renderer->renderNEW(&entitiesMap, shadowMapRenderer->getToShadowMapSpaceMatrix(), shadowMapRenderer2->getToShadowMapSpaceMatrix());
-	renderer->renderNEW(&entitiesMapPass2, shadowMapRenderer->getToShadowMapSpaceMatrix(), shadowMapRenderer2->getToShadowMapSpaceMatrix());
-	renderer->renderNEW(&entitiesMapPass3, shadowMapRenderer->getToShadowMapSpaceMatrix(), shadowMapRenderer2->getToShadowMapSpaceMatrix());
+	#ifdef DEV_MODE
+	beginTransparentTimer();
+	#endif
 
+	if (entitiesTransparentOITMap.size() > 0)
+	{
+		shader->stop();
+		renderTransparentOIT(camera, clipX, clipY, clipZ, clipW);
+		shader->start();
+	}
+
+	//One pass, sorted back to front so that different entities blend in the right order.
+	//Depth isn't written, so pieces that overlap inside one model never hide each other.
+	//The stage's transparent layer has the most of those, so it goes through OIT above when it can.
+	renderer->queueEntities(&entitiesTransparentMap, 3, true, &camera->eye);
+	renderer->sortQueue();
 	prepareTransparentRender();
-	renderer->renderNEW(&entitiesTransparentMap, shadowMapRenderer->getToShadowMapSpaceMatrix(), shadowMapRenderer2->getToShadowMapSpaceMatrix());
-	prepareTransparentRenderDepthOnly();
-	renderer->renderNEW(&entitiesTransparentMap, shadowMapRenderer->getToShadowMapSpaceMatrix(), shadowMapRenderer2->getToShadowMapSpaceMatrix());
+	renderer->renderQueue();
+	renderer->clearQueue();
 
-	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glDepthMask(true);
+
+	#ifdef DEV_MODE
+	endTransparentTimer();
+	#endif
 
 	shader->stop();
 }
 
+void loadFrameUniforms(ShaderProgram* program, Camera* camera, float clipX, float clipY, float clipZ, float clipW)
+{
+	program->loadClipPlane(clipX, clipY, clipZ, clipW);
+	program->loadSkyColour(RED, GREEN, BLUE);
+	program->loadLight(Global::gameLightSun);
+	program->loadViewMatrix(camera);
+	program->connectTextureUnits();
+
+	if (Global::renderShadowsFar || Global::renderShadowsClose)
+	{
+		program->loadShadowCascades(shadowMapRenderer);
+	}
+}
+
+//The stage's transparent layer has lots of overlapping pieces that are all part of
+// one entity, so sorting can't get them in the right order. Draw them with
+// weighted blended OIT instead, which doesn't care about the order.
+void renderTransparentOIT(Camera* camera, float clipX, float clipY, float clipZ, float clipW)
+{
+	weightedBlendedOit->bindFrameBuffer();
+
+	shaderOIT->start();
+	loadFrameUniforms(shaderOIT, camera, clipX, clipY, clipZ, clipW);
+	rendererOIT->queueEntities(&entitiesTransparentOITMap, 3, true, &camera->eye);
+	rendererOIT->renderQueue();
+	rendererOIT->clearQueue();
+	shaderOIT->stop();
+
+	weightedBlendedOit->composite();
+}
+
+#ifdef DEV_MODE
+void beginTransparentTimer()
+{
+	if (transparentTimerQuery == GL_NONE)
+	{
+		glGenQueries(1, &transparentTimerQuery);
+	}
+
+	//Only one query in flight at a time, so skip frames until the last one is done
+	if (transparentTimerWaiting)
+	{
+		GLint available = 0;
+		glGetQueryObjectiv(transparentTimerQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+		{
+			return;
+		}
+
+		GLuint64 nanoseconds = 0;
+		glGetQueryObjectui64v(transparentTimerQuery, GL_QUERY_RESULT, &nanoseconds);
+		transparentTimerWaiting = false;
+		transparentTimeStats.add(0, nanoseconds/1000000.0);
+
+		if (transparentTimeStats.endFrame())
+		{
+			std::fprintf(stdout, "Transparent passes on '%s': %f ms avg (OIT %s)\n",
+				Global::levelName.c_str(), transparentTimeStats.getAverage(0), Global::renderTransparencyOIT ? "on" : "off");
+		}
+	}
+
+	glBeginQuery(GL_TIME_ELAPSED, transparentTimerQuery);
+	transparentTimerWaiting = true;
+}
+
+void endTransparentTimer()
+{
+	GLint current = 0;
+	glGetQueryiv(GL_TIME_ELAPSED, GL_CURRENT_QUERY, &current);
+	if (current != 0)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+	}
+}
+#endif
+
 void Master_processEntity(Entity* entity)
 {
 	if (entity->getVisible() == false)
@@ -215,10 +308,16 @@ void Master_processTransparentEntity(Entity* entity)
 		return;
 	}
 
+	std::unordered_map<TexturedModel*, std::list<Entity*>>* map = &entitiesTransparentMap;
+	if (Global::renderTransparencyOIT && entity->isStageTransparent())
+	{
+		map = &entitiesTransparentOITMap;
+	}
+
 	std::list<TexturedModel*>* modellist = entity->getModels();
 	for (TexturedModel* entityModel : (*modellist))
 	{
-		std::list<Entity*>* list = &entitiesTransparentMap[entityModel];
+		std::list<Entity*>* list = &(*map)[entityModel];
 		list->push_back(entity);
 	}
 }
@@ -241,6 +340,7 @@ void Master_clearEntitiesPass3()
 void Master_clearTransparentEntities()
 {
 	entitiesTransparentMap.clear();
+	entitiesTransparentOITMap.clear();
 }
 
 void prepare()
@@ -257,33 +357,19 @@ void prepare()
 	glClearColor(RED, GREEN, BLUE, 1);
 
 	glActiveTexture(GL_TEXTURE5);
-	glBindTexture(GL_TEXTURE_2D, Master_getShadowMapTexture());
-
-	glActiveTexture(GL_TEXTURE6);
-	glBindTexture(GL_TEXTURE_2D, Master_getShadowMapTexture2());
+	glBindTexture(GL_TEXTURE_2D_ARRAY, Master_getShadowMapTexture());
 
 	glActiveTexture(GL_TEXTURE7);
 	glBindTexture(GL_TEXTURE_2D, randomMap);
 }
 
 void prepareTransparentRender()
-{
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); //GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	glEnable(GL_DEPTH_TEST);
-	glDepthMask(false);
-}
-
-void prepareTransparentRenderDepthOnly()
 {
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
-
 	glEnable(GL_DEPTH_TEST);
-	glDepthMask(true);
+	glDepthMask(false);
 }
 
 void Master_cleanUp()
@@ -296,8 +382,14 @@ void Master_cleanUp()
 	shadowMapRenderer->cleanUp();
 	delete shadowMapRenderer; INCR_DEL
 
-	shadowMapRenderer2->cleanUp();
-	delete shadowMapRenderer2; INCR_DEL
+	if (shaderOIT != nullptr)
+	{
+		shaderOIT->cleanUp();
+		delete shaderOIT; INCR_DEL
+		delete rendererOIT; INCR_DEL
+		weightedBlendedOit->cleanUp();
+		delete weightedBlendedOit; INCR_DEL
+	}
 }
 
 void Master_enableCulling()
@@ -311,9 +403,6 @@ void Master_disableCulling()
 	glDisable(GL_CULL_FACE);
 }
 
-extern unsigned int SCR_WIDTH;
-extern unsigned int SCR_HEIGHT;
-
 void Master_makeProjectionMatrix()
 {
 	int displayWidth;
@@ -344,6 +433,11 @@ void Master_makeProjectionMatrix()
 
 	renderer->updateProjectionMatrix(projectionMatrix);
 
+	if (rendererOIT != nullptr)
+	{
+		rendererOIT->updateProjectionMatrix(projectionMatrix);
+	}
+
 	if (Global::renderParticles)
 	{
 		ParticleMaster::updateProjectionMatrix(projectionMatrix);
@@ -375,29 +469,30 @@ GLuint Master_getShadowMapTexture()
 	return shadowMapRenderer->getShadowMap();
 }
 
-GLuint Master_getShadowMapTexture2()
-{
-	return shadowMapRenderer2->getShadowMap();
-}
-
 ShadowMapMasterRenderer* Master_getShadowRenderer()
 {
 	return shadowMapRenderer;
 }
 
-ShadowMapMasterRenderer2* Master_getShadowRenderer2()
-{
-	return shadowMapRenderer2;
-}
-
 void Master_renderShadowMaps(Light* sun)
 {
-	if (Global::renderShadowsFar)
+	if (Global::renderShadowsFar || Global::renderShadowsClose)
 	{
 		shadowMapRenderer->render(&entitiesMap, sun);
 	}
-	if (Global::renderShadowsClose)
-	{
-		shadowMapRenderer2->render(&entitiesMap, sun);
-	}
+}
+
+int Master_getStateChangesUnsorted()
+{
+	return renderer->getStateChangesUnsorted();
+}
+
+int Master_getStateChangesSorted()
+{
+	return renderer->getStateChangesSorted();
+}
+
+int Master_getDrawCalls()
+{
+	return renderer->getDrawCalls();
 }
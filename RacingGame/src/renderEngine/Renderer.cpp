@@ -14,6 +14,8 @@
 #include <iostream>
 #include <unordered_map>
 #include <list>
+#include <vector>
+#include <cmath>
 
 EntityRenderer::EntityRenderer(ShaderProgram* shader, Matrix4f* projectionMatrix)
 {
@@ -21,39 +23,198 @@ EntityRenderer::EntityRenderer(ShaderProgram* shader, Matrix4f* projectionMatrix
 	shader->loadProjectionMatrix(projectionMatrix);
 	shader->stop();
 	this->shader = shader;
+	this->clockTime = 0;
+	this->stateChangesUnsorted = 0;
+	this->stateChangesSorted = 0;
+	this->drawCalls = 0;
 }
 
-void EntityRenderer::renderNEW(std::unordered_map<TexturedModel*, std::list<Entity*>>* entitiesMap, Matrix4f* toShadowSpaceFar, Matrix4f* toShadowSpaceClose)
+//Bit layout of the 64 bit sort keys.
+//Opaque:      pass(3) shader(3) texture(16) vao(16) unused(10) depth(16)
+//Transparent: pass(3) inverted depth(16) texture(16) vao(16) unused(13)
+#define KEY_PASS_SHIFT        61
+#define KEY_SHADER_SHIFT      58
+#define KEY_TEXTURE_SHIFT     42
+#define KEY_VAO_SHIFT         26
+#define KEY_TRANS_DEPTH_SHIFT 45
+#define KEY_TRANS_TEX_SHIFT   29
+#define KEY_TRANS_VAO_SHIFT   13
+
+void EntityRenderer::queueEntities(std::unordered_map<TexturedModel*, std::list<Entity*>>* entitiesMap, int pass, bool transparent, Vector3f* cameraPosition)
 {
-	if (Global::renderShadowsFar)
+	const float depthScale = 65535.0f/Master_getFarPlane();
+	const unsigned long long passBits = ((unsigned long long)(pass & 0x7)) << KEY_PASS_SHIFT;
+
+	//There is only one entity shader right now, but leave room in the key for more
+	const unsigned long long shaderBits = 0ULL << KEY_SHADER_SHIFT;
+
+	for (auto entry : (*entitiesMap))
 	{
-		shader->loadToShadowSpaceMatrixFar(toShadowSpaceFar);
+		TexturedModel* model = entry.first;
+		unsigned long long textureBits = model->getTexture()->getID() & 0xFFFF;
+		unsigned long long vaoBits     = model->getRawModel()->getVaoID() & 0xFFFF;
+
+		Vector3f* center = model->getRawModel()->getCenter();
+		Vector4f modelCenter(center->x, center->y, center->z, 1.0f);
+
+		for (Entity* entity : entry.second)
+		{
+			//Depth of the middle of this model, since a single entity
+			// like the stage can be spread out over the whole level
+			Vector4f worldCenter = entity->getTransformationMatrix()->transform(&modelCenter);
+			Vector3f diff(worldCenter.x - cameraPosition->x, worldCenter.y - cameraPosition->y, worldCenter.z - cameraPosition->z);
+			float depth = fminf(diff.length()*depthScale, 65535.0f);
+			unsigned long long depthBits = (unsigned long long)depth;
+
+			RadixSortItem item;
+			item.value = (unsigned int)drawCommands.size();
+			if (transparent)
+			{
+				item.key = passBits |
+					((0xFFFF - depthBits)  << KEY_TRANS_DEPTH_SHIFT) |
+					(textureBits << KEY_TRANS_TEX_SHIFT) |
+					(vaoBits     << KEY_TRANS_VAO_SHIFT);
+			}
+			else
+			{
+				item.key = passBits | shaderBits |
+					(textureBits << KEY_TEXTURE_SHIFT) |
+					(vaoBits     << KEY_VAO_SHIFT) |
+					depthBits;
+			}
+			drawKeys.push_back(item);
+
+			DrawCommand command;
+			command.model = model;
+			command.entity = entity;
+			drawCommands.push_back(command);
+		}
 	}
+}
+
+void EntityRenderer::sortQueue()
+{
+	stateChangesUnsorted += countStateChanges();
+	RadixSort::sort(&drawKeys, &drawKeysScratch);
+	stateChangesSorted += countStateChanges();
+}
 
-	if (Global::renderShadowsClose)
+int EntityRenderer::countStateChanges()
+{
+	int changes = 0;
+	GLuint prevVao = 0;
+	GLuint prevTex = 0;
+	for (RadixSortItem item : drawKeys)
 	{
-		shader->loadToShadowSpaceMatrixClose(toShadowSpaceClose);
+		TexturedModel* model = drawCommands[item.value].model;
+		GLuint vao = model->getRawModel()->getVaoID();
+		GLuint tex = model->getTexture()->getID();
+		if (vao != prevVao)
+		{
+			changes++;
+			prevVao = vao;
+		}
+		if (tex != prevTex)
+		{
+			changes++;
+			prevTex = tex;
+		}
 	}
+	return changes;
+}
 
+void EntityRenderer::renderQueue()
+{
 	clockTime = Global::gameClock / 60.0f;
 
 	shader->loadFogGradient(SkyManager::getFogGradient());
 	shader->loadFogDensity(SkyManager::getFogDensity());
 
-	for (auto entry : (*entitiesMap))
+	TexturedModel* prevModel = nullptr;
+	Entity* prevEntity = nullptr;
+	GLuint boundVao = 0;
+	GLuint boundTex = 0;
+	GLenum indexType = GL_UNSIGNED_INT;
+
+	for (RadixSortItem item : drawKeys)
 	{
-		prepareTexturedModel(entry.first);
-		std::list<Entity*>* entityList = &entry.second;
+		DrawCommand* command = &drawCommands[item.value];
+		TexturedModel* model = command->model;
+		RawModel* rawModel = model->getRawModel();
 
-		for (Entity* entity : (*entityList))
+		if (model != prevModel)
 		{
-			prepareInstance(entity);
-			glDrawElements(GL_TRIANGLES, (entry.first)->getRawModel()->getVertexCount(), GL_UNSIGNED_INT, 0);
+			//Ranges of the same batch that draw with the same state don't need anything bound again
+			ModelTexture* texture = model->getTexture();
+			if (prevModel == nullptr || 
+				rawModel->getVaoID() != boundVao || 
+				!texture->hasSameState(prevModel->getTexture()))
+			{
+				if (rawModel->getVaoID() != boundVao)
+				{
+					boundVao = rawModel->getVaoID();
+					indexType = rawModel->getIndexType();
+					glBindVertexArray(boundVao);
+					glEnableVertexAttribArray(0);
+					glEnableVertexAttribArray(1);
+					glEnableVertexAttribArray(2);
+				}
+
+				loadMaterial(texture);
+				if (texture->getID() != boundTex)
+				{
+					boundTex = texture->getID();
+					bindTexture(texture);
+				}
+			}
+
+			prevModel = model;
 		}
+
+		if (command->entity != prevEntity)
+		{
+			prepareInstance(command->entity);
+			prevEntity = command->entity;
+		}
+
+		glDrawElements(GL_TRIANGLES, rawModel->getVertexCount(), indexType, rawModel->getIndexOffset());
+		drawCalls++;
+	}
+
+	if (boundVao != 0)
+	{
 		unbindTexturedModel();
 	}
 }
 
+void EntityRenderer::clearQueue()
+{
+	drawCommands.clear();
+	drawKeys.clear();
+}
+
+void EntityRenderer::resetStateChangeCounts()
+{
+	stateChangesUnsorted = 0;
+	stateChangesSorted = 0;
+	drawCalls = 0;
+}
+
+int EntityRenderer::getStateChangesUnsorted()
+{
+	return stateChangesUnsorted;
+}
+
+int EntityRenderer::getStateChangesSorted()
+{
+	return stateChangesSorted;
+}
+
+int EntityRenderer::getDrawCalls()
+{
+	return drawCalls;
+}
+
 void EntityRenderer::prepareTexturedModel(TexturedModel* model)
 {
 	RawModel* rawModel = model->getRawModel();
@@ -63,21 +224,33 @@ void EntityRenderer::prepareTexturedModel(TexturedModel* model)
 	glEnableVertexAttribArray(2);
 
 	ModelTexture* texture = model->getTexture();
-	//if (texture->getHasTransparency() != 0)
+	loadMaterial(texture);
+	bindTexture(texture);
+}
+
+void EntityRenderer::bindTexture(ModelTexture* texture)
+{
+	//Texture arrays go on their own unit, so that they don't have to replace the regular texture
+	if (texture->getUsesTextureArray())
 	{
-		//Master_disableCulling();
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, texture->getID());
 	}
-	//else
+	else
 	{
-		//Master_enableCulling();
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, texture->getID());
 	}
+}
+
+void EntityRenderer::loadMaterial(ModelTexture* texture)
+{
 	shader->loadFakeLighting(texture->getUsesFakeLighting());
 	shader->loadShineVariables(texture->getShineDamper(), texture->getReflectivity());
 	shader->loadTransparency(texture->getHasTransparency());
+	shader->loadUseTextureArray(texture->getUsesTextureArray());
 	shader->loadGlowAmount(texture->getGlowAmount());
 	shader->loadTextureOffsets(clockTime*texture->getScrollX(), clockTime*texture->getScrollY());
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, texture->getID());
 }
 
 void EntityRenderer::unbindTexturedModel()
@@ -111,7 +284,7 @@ void EntityRenderer::render(Entity* entity)
 
 		prepareTexturedModel(texturedModel);
 
-		glDrawElements(GL_TRIANGLES, model->getVertexCount(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, model->getVertexCount(), model->getIndexType(), model->getIndexOffset());
 
 		unbindTexturedModel();
 	}
@@ -6,8 +6,10 @@ class Entity;
 class Matrix4f;
 class Light;
 class Camera;
+class Vector3f;
+class Vector4f;
 class ShadowMapMasterRenderer;
-class ShadowMapMasterRenderer2;
+class CookedTexture;
 
 #include <unordered_map>
 
@@ -15,8 +17,10 @@ class ShadowMapMasterRenderer2;
 #include <GLFW/glfw3.h>
 #include <list>
 #include <vector>
+#include <string>
 #include <unordered_map>
 #include "../models/models.h"
+#include "../toolbox/radixsort.h"
 
 
 //DisplayManager
@@ -27,10 +31,39 @@ int displayWantsToClose();
 GLFWwindow* getWindow();
 
 
+//How the vertices of a batched model are packed into its vbo. Each model gets
+// the smallest types that still hold its vertices without visible error.
+//All of the types are ones that the gpu converts back to floats when it reads
+// them, so the shaders don't need to know which format a model uses.
+struct PackedVertexFormat
+{
+	//GL_HALF_FLOAT if the model is small enough, otherwise GL_FLOAT
+	GLenum positionType;
+
+	//GL_UNSIGNED_SHORT (normalized) if every texture coord is between 0 and 1, otherwise GL_FLOAT
+	GLenum textureCoordType;
+
+	//Normals are always GL_INT_2_10_10_10_REV (normalized), and texture layers are GL_SHORT
+
+	//In bytes
+	int positionOffset;
+	int textureCoordOffset;
+	int normalOffset;
+	int textureLayerOffset;
+	int stride;
+};
+
 //Loader
+//The functions that load models and textures, and the ones that delete them, can also
+// be called from the BackgroundLoader's worker thread. The decoding and packing happens
+// on that thread, and only the gl calls get handed to the main thread.
 class Loader
 {
 private:
+	//Positions that are all closer to the origin than this get stored as half floats,
+	// which are then off by at most 1/256
+	static const int HALF_POSITION_LIMIT = 16;
+
 	static std::list<GLuint> vaos;
 	static std::list<GLuint> vbos;
 	static std::list<GLuint> textures;
@@ -47,20 +80,92 @@ private:
 
 	static GLuint bindIndiciesBuffer(std::vector<int>*);
 
+	static GLuint bindIndiciesBuffer(std::vector<GLushort>*);
+
+	//Bytes of every packed vbo so far, and what they would have been as floats
+	static long long packedVertexBytes;
+	static long long floatVertexBytes;
+
+	//vertices are floatStride floats each: position, texture coords, normal, and the texture layer if hasTextureLayers
+	static void choosePackedFormat(std::vector<float>* vertices, int floatStride, bool hasTextureLayers, PackedVertexFormat* format);
+
+	static void packVertices(std::vector<float>* vertices, int floatStride, bool hasTextureLayers, PackedVertexFormat* format, std::vector<char>* packed);
+
+	static GLushort floatToHalf(float value);
+
+	//x, y and z from -1 to 1 into GL_INT_2_10_10_10_REV
+	static GLuint packNormal(float x, float y, float z);
+
+	//Sets the center of the model to the center of the bounding box of the
+	// vertices used by the given indices, and the radius to half of the box's
+	// diagonal. stride is in floats.
+	static void calculateCenter(RawModel* model, float* positions, int stride, int* indices, int indexCount);
+
+	static long long bytesUploaded;
+
+	//Bytes of every cooked texture uploaded so far, and what they would have been as RGBA
+	static long long textureBytes;
+	static long long rgbaTextureBytes;
+
+	//-1 until it has been checked
+	static int compressionSupported;
+
+	//Generates mipmaps and sets the filtering for the texture bound to target
+	static void setMipmapFiltering(GLenum target);
+
+	//Sets the filtering for the texture bound to target, which already has all of its mipmaps
+	static void setFiltering(GLenum target);
+
+	//Makes a GL_TEXTURE_2D out of every level of image. Has to be called on the main thread.
+	static GLuint uploadCookedTexture(CookedTexture* image);
+
+	//If the gpu can take DXT1 and DXT5 textures
+	static bool isTextureCompressionSupported();
+
 public:
 	//For 3D Models
 	static RawModel loadToVAO(std::vector<float>* positions, std::vector<float>* textureCoords, std::vector<float>* normals, std::vector<int>* indices);
 
-	//for text
-	//returns a std::vector<int> where the first entry is the vao and the rest are vbos
-	static std::vector<int> loadToVAO(std::vector<float>* positions, std::vector<float>* textureCoords);
+	//For 3D Models that are split into many pieces that all share the same vertices.
+	//The vertices are interleaved (position, texture coords, normal) floats. They get packed
+	// into a single vbo using a PackedVertexFormat, and each list of indices becomes one
+	// range of a single shared index buffer.
+	//If hasTextureLayers, each vertex also has a texture array layer after the normal.
+	//Returns one RawModel per list of indices. They all share the same VAO.
+	//The index buffer is 16 bit if there are fewer than 65536 vertices.
+	static std::vector<RawModel> loadToVAOBatch(std::vector<float>* vertices, std::vector<std::vector<int>>* indices, bool hasTextureLayers);
 
 	//for water
 	static RawModel loadToVAO(std::vector<float>* positions, int dimensions);
 
+	//Creates a vbo with room for sizeInBytes that is meant to be refilled every frame
+	static GLuint createStreamingVbo(int sizeInBytes);
+
+	//Creates a vao that reads interleaved floats out of a new streaming vbo with room for sizeInBytes.
+	//attributeSizes has the number of floats in each attribute, starting at attribute 0.
+	//vbo gets the id of the streaming vbo.
+	static GLuint createStreamingVao(std::vector<int>* attributeSizes, int sizeInBytes, GLuint* vbo);
+
 	//Loads a texture into GPU memory, returns the GLuint id
 	static GLuint loadTexture(const char* filename);
 
+	//Loads many textures at once, decoding the images on as many threads as there are cores.
+	//They get block compressed if the gpu supports it. For each file name, textureIDs
+	// gets the GLuint id, or 0 if it couldn't be loaded.
+	static void loadTextures(std::vector<std::string>* fileNames, std::vector<GLuint>* textureIDs);
+
+	//Loads many textures at once. Images that are the same size as another image get
+	// packed into the layers of a GL_TEXTURE_2D_ARRAY, so that they can all be drawn
+	// with a single texture binding. For each file name, textureIDs gets the GLuint id,
+	// and layers gets the layer in the array, or -1 if it is a regular texture.
+	static void loadTexturesPacked(std::vector<std::string>* fileNames, std::vector<GLuint>* textureIDs, std::vector<int>* layers);
+
+	//Packs many images into a single texture, with padding pixels around each image that
+	// repeat its edge. Mipmaps stop at maxMipLevel, so that the padding keeps the images
+	// from bleeding into each other. For each file name, rects gets where the image is in
+	// the atlas (x, y, width, height in texture coordinates), or all 0 if it didn't load.
+	static GLuint loadTextureAtlas(std::vector<std::string>* fileNames, int padding, int maxMipLevel, std::vector<Vector4f>* rects);
+
 	//Loads a texture without any interpolation
 	static GLuint loadTextureNoInterpolation(const char* fileName);
 
@@ -72,10 +177,15 @@ public:
 
 	static void deleteTexture(GLuint texID);
 
+	//Deletes everything the models use, but not the models themselves
 	static void deleteTexturedModels(std::list<TexturedModel*>* tm);
 
 	static void printInfo();
 
+	//Bytes of every vbo and texture made so far, including the ones that have been deleted since.
+	//How much it goes up while loading something is how much gpu memory that thing takes up.
+	static long long getBytesUploaded();
+
 	static GLuint loadShader(const char* file, int shaderType);
 };
 
@@ -114,32 +224,78 @@ GLuint Master_getShadowMapTexture();
 
 ShadowMapMasterRenderer* Master_getShadowRenderer();
 
-GLuint Master_getShadowMapTexture2();
+void Master_renderShadowMaps(Light* sun);
 
-ShadowMapMasterRenderer2* Master_getShadowRenderer2();
+//Number of texture binds + VAO binds the last frame would have needed
+// in the order entities were processed, and how many it needed after sorting.
+int Master_getStateChangesUnsorted();
 
-void Master_renderShadowMaps(Light* sun);
+int Master_getStateChangesSorted();
+
+//Number of draw calls the last frame took to draw the opaque and transparent entities
+int Master_getDrawCalls();
 
 //Renderer
 class EntityRenderer
 {
 private:
+	//A single model of a single entity that is queued up to be drawn
+	struct DrawCommand
+	{
+		TexturedModel* model;
+		Entity* entity;
+	};
+
 	float clockTime;
 
 	ShaderProgram* shader;
 
+	std::vector<DrawCommand> drawCommands;
+	std::vector<RadixSortItem> drawKeys;
+	std::vector<RadixSortItem> drawKeysScratch;
+
+	int stateChangesUnsorted;
+	int stateChangesSorted;
+	int drawCalls;
+
 	void prepareTexturedModel(TexturedModel* model);
 
+	void loadMaterial(ModelTexture* texture);
+
+	void bindTexture(ModelTexture* texture);
+
 	void unbindTexturedModel();
 
 	void prepareInstance(Entity* entity);
 
+	int countStateChanges();
+
 public:
 	EntityRenderer(ShaderProgram* shader, Matrix4f* projectionMatrix);
 
 	void render(Entity*);
 
-	void renderNEW(std::unordered_map<TexturedModel*, std::list<Entity*>>* entities, Matrix4f* toShadowSpaceFar, Matrix4f* toShadowSpaceClose);
+	//Adds every model of every entity in the map to the draw queue.
+	//Opaque draws get sorted by pass, shader, texture, VAO and then front to back.
+	//Transparent draws get sorted by pass and then back to front, using the
+	// center of each model so that they only need a single pass to draw.
+	void queueEntities(std::unordered_map<TexturedModel*, std::list<Entity*>>* entities, int pass, bool transparent, Vector3f* cameraPosition);
+
+	void sortQueue();
+
+	//Draws everything in the queue. The queue is kept until clearQueue is called,
+	// so that the same draws can be rendered again with different gl state.
+	void renderQueue();
+
+	void clearQueue();
+
+	void resetStateChangeCounts();
+
+	int getStateChangesUnsorted();
+
+	int getStateChangesSorted();
+
+	int getDrawCalls();
 
 	void updateProjectionMatrix(Matrix4f* projectionMatrix);
 
@@ -12,6 +12,7 @@
 #include "../entities/light.h"
 #include "../renderEngine/renderEngine.h"
 #include "../engineTester/main.h"
+#include "../shadows/shadowmapmasterrenderer.h"
 #include "shaderprogram.h"
 
 float matrixBuffer[16];
@@ -88,6 +89,11 @@ void ShaderProgram::loadTransparency(int transparency)
 	loadFloat(location_hasTransparency, (float)transparency);
 }
 
+void ShaderProgram::loadUseTextureArray(int useTextureArray)
+{
+	loadFloat(location_useTextureArray, (float)useTextureArray);
+}
+
 void ShaderProgram::loadGlowAmount(float glowAmount)
 {
 	loadFloat(location_glowAmount, glowAmount);
@@ -132,6 +138,7 @@ void ShaderProgram::bindAttributes()
 	bindAttribute(0, "position");
 	bindAttribute(1, "textureCoords");
 	bindAttribute(2, "normal");
+	bindAttribute(3, "textureLayer");
 }
 
 void ShaderProgram::bindAttribute(int attribute, const char* variableName)
@@ -163,11 +170,19 @@ void ShaderProgram::getAllUniformLocations()
 	location_fogDensity            = getUniformLocation("fogDensity");
 	location_fogGradient           = getUniformLocation("fogGradient");
 	location_clipPlane             = getUniformLocation("clipPlane");
-	location_shadowMapFar          = getUniformLocation("shadowMapFar");
-	location_toShadowMapSpaceFar   = getUniformLocation("toShadowMapSpaceFar");
-	location_shadowMapClose        = getUniformLocation("shadowMapClose");
-	location_toShadowMapSpaceClose = getUniformLocation("toShadowMapSpaceClose");
+	location_shadowMap             = getUniformLocation("shadowMap");
+	location_cascadeCount          = getUniformLocation("cascadeCount");
 	location_randomMap             = getUniformLocation("randomMap");
+	location_useTextureArray       = getUniformLocation("useTextureArray");
+	location_textureArraySampler   = getUniformLocation("textureArraySampler");
+
+	for (int i = 0; i < ShadowMapMasterRenderer::MAX_CASCADES; i++)
+	{
+		std::string index = "[" + std::to_string(i) + "]";
+		location_toShadowMapSpace[i] = getUniformLocation(("toShadowMapSpace" + index).c_str());
+		location_cascadeFar[i]       = getUniformLocation(("cascadeFar"       + index).c_str());
+		location_cascadeBias[i]      = getUniformLocation(("cascadeBias"      + index).c_str());
+	}
 }
 
 int ShaderProgram::getUniformLocation(const char* uniformName)
@@ -208,27 +223,23 @@ void ShaderProgram::loadClipPlane(float clipX, float clipY, float clipZ, float c
 
 void ShaderProgram::connectTextureUnits()
 {
+	loadInt(location_textureArraySampler, 1);
+
 	if (Global::renderShadowsFar || Global::renderShadowsClose)
 	{
-		if (Global::renderShadowsFar)
-		{
-			loadInt(location_shadowMapFar, 5);
-		}
-		if (Global::renderShadowsClose)
-		{
-			loadInt(location_shadowMapClose, 6);
-		}
-
+		loadInt(location_shadowMap, 5);
 		loadInt(location_randomMap, 7);
 	}
 }
 
-void ShaderProgram::loadToShadowSpaceMatrixFar(Matrix4f* matrix)
-{
-	loadMatrix(location_toShadowMapSpaceFar, matrix);
-}
-
-void ShaderProgram::loadToShadowSpaceMatrixClose(Matrix4f* matrix)
+void ShaderProgram::loadShadowCascades(ShadowMapMasterRenderer* shadowRenderer)
 {
-	loadMatrix(location_toShadowMapSpaceClose, matrix);
+	int count = shadowRenderer->getCascadeCount();
+	loadInt(location_cascadeCount, count);
+	for (int i = 0; i < count; i++)
+	{
+		loadMatrix(location_toShadowMapSpace[i], shadowRenderer->getToShadowMapSpaceMatrix(i));
+		loadFloat(location_cascadeFar[i], shadowRenderer->getCascadeFar(i));
+		loadFloat(location_cascadeBias[i], shadowRenderer->getCascadeBias(i));
+	}
 }
@@ -8,6 +8,8 @@ class Vector3f;
 
 #include <glad/glad.h>
 
+#include "../shadows/shadowmapmasterrenderer.h"
+
 
 class ShaderProgram
 {
@@ -33,11 +35,14 @@ private:
 	int location_fogDensity;
 	int location_fogGradient;
 	int location_clipPlane;
-	int location_shadowMapFar;
-	int location_toShadowMapSpaceFar;
-	int location_shadowMapClose;
-	int location_toShadowMapSpaceClose;
+	int location_shadowMap;
+	int location_toShadowMapSpace[ShadowMapMasterRenderer::MAX_CASCADES];
+	int location_cascadeFar[ShadowMapMasterRenderer::MAX_CASCADES];
+	int location_cascadeBias[ShadowMapMasterRenderer::MAX_CASCADES];
+	int location_cascadeCount;
 	int location_randomMap;
+	int location_useTextureArray;
+	int location_textureArraySampler;
 
 public:
 	ShaderProgram(const char*, const char*);
@@ -62,6 +67,8 @@ public:
 
 	void loadTransparency(int transparency);
 
+	void loadUseTextureArray(int useTextureArray);
+
 	void loadGlowAmount(float glowAmount);
 
 	void loadBaseColour(Vector3f* baseColour);
@@ -76,9 +83,8 @@ public:
 
 	void loadClipPlane(float clipX, float clipY, float clipZ, float clipW);
 
-	void loadToShadowSpaceMatrixFar(Matrix4f* matrix);
-
-	void loadToShadowSpaceMatrixClose(Matrix4f* matrix);
+	//Loads the to-shadow-map-space matrix, far distance and bias of every cascade
+	void loadShadowCascades(ShadowMapMasterRenderer* shadowRenderer);
 
 	void connectTextureUnits();
 
@@ -8,35 +8,37 @@
 #include <GLFW/glfw3.h>
 #include <vector>
 
-ShadowBox::ShadowBox(Matrix4f* lightViewMatrix, Camera* camera)
+ShadowBox::ShadowBox(Matrix4f* lightViewMatrix, Camera* camera, float nearDistance, float farDistance, float offset)
 {
-	UP = Vector4f(0, 1, 0, 0);
-	FORWARD = Vector4f(0, 0, -1, 0);
-
 	this->lightViewMatrix = lightViewMatrix;
 	this->cam = camera;
+	this->nearDistance = nearDistance;
+	this->farDistance = farDistance;
+	this->offset = offset;
 	calculateWidthsAndHeights();
 }
 
 void ShadowBox::update()
 {
-	Matrix4f rotation = calculateCameraRotationMatrix();
-	Vector4f temp = rotation.transform(&FORWARD);
-	Vector3f forwardVector(temp.x, temp.y, temp.z);
+	Vector3f forwardVector = cam->target - cam->eye;
+	forwardVector.normalize();
 
-	Vector3f toFar(&forwardVector);
-	toFar.scale(SHADOW_DISTANCE);
+	//The camera's up vector isn't always at a right angle to where it's looking
+	Vector3f rightVector = forwardVector.cross(&cam->up);
+	rightVector.normalize();
+	Vector3f upVector = rightVector.cross(&forwardVector);
 
-	float NEAR_PLANE = Master_getNearPlane();
+	Vector3f toFar(&forwardVector);
+	toFar.scale(farDistance);
 
 	Vector3f toNear(&forwardVector);
-	toNear.scale(NEAR_PLANE);
+	toNear.scale(nearDistance);
 
 	Vector3f centerNear = toNear + cam->eye;
 	Vector3f centerFar  = toFar  + cam->eye;
 
 	std::vector<Vector4f> points = calculateFrustumVertices(
-		&rotation, &forwardVector, &centerNear, &centerFar);
+		&forwardVector, &upVector, &centerNear, &centerFar);
 
 	bool first = true;
 	for (Vector4f point : points) 
@@ -80,7 +82,7 @@ void ShadowBox::update()
 			minZ = point.z;
 		}
 	}
-	maxZ += OFFSET;
+	maxZ += offset;
 }
 
 Vector3f ShadowBox::getCenter()
@@ -111,26 +113,22 @@ float ShadowBox::getLength()
 }
 
 std::vector<Vector4f> ShadowBox::calculateFrustumVertices(
-	Matrix4f* rotation, Vector3f* forwardVector,
+	Vector3f* forwardVector, Vector3f* upVector,
 	Vector3f* centerNear, Vector3f* centerFar)
 {
-	Matrix4f rot(rotation);
-	Vector4f temp = rot.transform(&UP);
-	Vector3f upVector(temp.x, temp.y, temp.z);
-
-	Vector3f rightVector = forwardVector->cross(&upVector);
+	Vector3f rightVector = forwardVector->cross(upVector);
 
-	Vector3f downVector(-upVector.x, -upVector.y, -upVector.z);
+	Vector3f downVector(-upVector->x, -upVector->y, -upVector->z);
 	Vector3f leftVector(-rightVector.x, -rightVector.y, -rightVector.z);
 
 
-	Vector3f temp2(upVector.x * farHeight, upVector.y * farHeight, upVector.z * farHeight);
+	Vector3f temp2(upVector->x * farHeight, upVector->y * farHeight, upVector->z * farHeight);
 	Vector3f farTop = (*centerFar) + temp2;
 
 	temp2.set(downVector.x * farHeight, downVector.y * farHeight, downVector.z * farHeight);
 	Vector3f farBottom = (*centerFar) + temp2;
 
-	temp2.set(upVector.x * nearHeight, upVector.y * nearHeight, upVector.z * nearHeight);
+	temp2.set(upVector->x * nearHeight, upVector->y * nearHeight, upVector->z * nearHeight);
 	Vector3f nearTop = (*centerNear) + temp2;
 
 	temp2.set(downVector.x * nearHeight, downVector.y * nearHeight, downVector.z * nearHeight);
@@ -158,25 +156,14 @@ Vector4f ShadowBox::calculateLightSpaceFrustumCorner(Vector3f* startPoint, Vecto
 	return lightViewMatrix->transform(&point4f);
 }
 
-Matrix4f ShadowBox::calculateCameraRotationMatrix()
-{
-	Matrix4f rotation;
-	Vector3f temp(0, 1, 0);
-	//rotation.rotate(Maths::toRadians(-cam->getYaw()), &temp);
-	temp.set(1, 0, 0);
-	rotation.rotate(Maths::toRadians(-90), &temp);
-	return rotation;
-}
-
 void ShadowBox::calculateWidthsAndHeights()
 {
-	float NEAR_PLANE = Master_getNearPlane();
 	float VFOV = Master_getVFOV();
 
 	float aRatio = getAspectRatio();
 
-	farWidth = SHADOW_DISTANCE * tanf(Maths::toRadians(VFOV));
-	nearWidth = NEAR_PLANE * tanf(Maths::toRadians(VFOV));
+	farWidth = farDistance * tanf(Maths::toRadians(VFOV));
+	nearWidth = nearDistance * tanf(Maths::toRadians(VFOV));
 	farHeight = farWidth / aRatio;
 	nearHeight = nearWidth / aRatio;
 }
@@ -2,10 +2,11 @@
 #include "shadowframebuffer.h"
 #include "../renderEngine/renderEngine.h"
 
-ShadowFrameBuffer::ShadowFrameBuffer(int width, int height)
+ShadowFrameBuffer::ShadowFrameBuffer(int width, int height, int layers)
 {
 	this->WIDTH = width;
 	this->HEIGHT = height;
+	this->LAYERS = layers;
 	initialiseFrameBuffer();
 }
 
@@ -15,9 +16,10 @@ void ShadowFrameBuffer::cleanUp()
 	glDeleteTextures(1, &shadowMap);
 }
 
-void ShadowFrameBuffer::bindFrameBuffer()
+void ShadowFrameBuffer::bindFrameBuffer(int layer)
 {
 	bindFrameBuffer(fbo, WIDTH, HEIGHT);
+	glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, shadowMap, 0, layer);
 }
 
 extern unsigned int SCR_WIDTH;
@@ -37,13 +39,13 @@ GLuint ShadowFrameBuffer::getShadowMap()
 void ShadowFrameBuffer::initialiseFrameBuffer()
 {
 	fbo = ShadowFrameBuffer::createFrameBuffer();
-	shadowMap = ShadowFrameBuffer::createDepthBufferAttachment(WIDTH, HEIGHT);
+	shadowMap = ShadowFrameBuffer::createDepthBufferAttachment(WIDTH, HEIGHT, LAYERS);
 	unbindFrameBuffer();
 }
 
 void ShadowFrameBuffer::bindFrameBuffer(GLuint frameBuffer, int width, int height)
 {
-	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, frameBuffer);
 	glViewport(0, 0, width, height);
 }
@@ -57,20 +59,20 @@ int ShadowFrameBuffer::createFrameBuffer()
 	return frameBuffer;
 }
 
-int ShadowFrameBuffer::createDepthBufferAttachment(int width, int height)
+int ShadowFrameBuffer::createDepthBufferAttachment(int width, int height, int layers)
 {
 	GLuint texture;
 	glGenTextures(1, &texture);
-	glBindTexture(GL_TEXTURE_2D, texture);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
 
-	//Depth bits
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT16, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+	//Depth bits, one layer per cascade
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT16, width, height, layers, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, 0);
 	return texture;
 }
 
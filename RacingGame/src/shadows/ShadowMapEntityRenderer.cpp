@@ -1,43 +1,153 @@
 #include <glad/glad.h>
 #include <unordered_map>
 #include <list>
+#include <vector>
+#include <cmath>
 
 #include "shadowshader.h"
 #include "shadowmapentityrenderer.h"
 #include "../toolbox/matrix.h"
+#include "../toolbox/vector.h"
 #include "../entities/entity.h"
 #include "../models/models.h"
 #include "../toolbox/maths.h"
+#include "../toolbox/radixsort.h"
 
-ShadowMapEntityRenderer::ShadowMapEntityRenderer(ShadowShader* shader, Matrix4f* projectionViewMatrix)
+//Bit layout of the 64 bit sort keys: vao(16) texture(16) entity(32)
+#define KEY_VAO_SHIFT     48
+#define KEY_TEXTURE_SHIFT 32
+
+ShadowMapEntityRenderer::ShadowMapEntityRenderer(ShadowShader* shader)
 {
 	this->shader = shader;
-	this->projectionViewMatrix = projectionViewMatrix;
+	this->projectionViewMatrix = nullptr;
+	this->castersRendered = 0;
+	this->castersCulled = 0;
 }
 
-void ShadowMapEntityRenderer::render(std::unordered_map<TexturedModel*, std::list<Entity*>>* entities)
+void ShadowMapEntityRenderer::render(std::unordered_map<TexturedModel*, std::list<Entity*>>* entities, Matrix4f* projectionViewMatrix)
 {
-	for (auto entry : (*entities))
+	this->projectionViewMatrix = projectionViewMatrix;
+	castersRendered = 0;
+	castersCulled = 0;
+
+	for (auto& entry : (*entities))
 	{
 		TexturedModel* texturedModel = entry.first;
 		RawModel* rawModel = texturedModel->getRawModel();
-		bindModel(rawModel);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, texturedModel->getTexture()->getID());
 
-		std::list<Entity*>* entityList = &entry.second;
+		const unsigned long long vaoBits     = (unsigned long long)(rawModel->getVaoID() & 0xFFFF);
+		const unsigned long long textureBits = (unsigned long long)(texturedModel->getTexture()->getID() & 0xFFFF);
 
-		for (Entity* entity : (*entityList))
+		for (Entity* entity : entry.second)
 		{
-			prepareInstance(entity);
-			glDrawElements(GL_TRIANGLES, rawModel->getVertexCount(), GL_UNSIGNED_INT, 0);
+			if (!isCasterVisible(rawModel, entity))
+			{
+				castersCulled++;
+				continue;
+			}
+
+			DrawCommand command;
+			command.model = texturedModel;
+			command.entity = entity;
+
+			//Two different entities can end up with the same bits here, which only
+			// costs an extra matrix load, since the entity itself is compared when drawing
+			RadixSortItem item;
+			item.key = (vaoBits << KEY_VAO_SHIFT) | (textureBits << KEY_TEXTURE_SHIFT) |
+				(unsigned long long)(((size_t)entity) & 0xFFFFFFFF);
+			item.value = (unsigned int)drawCommands.size();
+
+			drawCommands.push_back(command);
+			drawKeys.push_back(item);
 		}
 	}
+
+	RadixSort::sort(&drawKeys, &drawKeysScratch);
+
+	GLuint boundVao = 0;
+	GLenum indexType = GL_UNSIGNED_INT;
+	TexturedModel* prevModel = nullptr;
+	Entity* prevEntity = nullptr;
+
+	for (RadixSortItem item : drawKeys)
+	{
+		DrawCommand* command = &drawCommands[item.value];
+		TexturedModel* model = command->model;
+		RawModel* rawModel = model->getRawModel();
+
+		if (model != prevModel)
+		{
+			ModelTexture* texture = model->getTexture();
+			if (prevModel == nullptr ||
+				rawModel->getVaoID() != boundVao ||
+				texture->getID() != prevModel->getTexture()->getID())
+			{
+				if (rawModel->getVaoID() != boundVao)
+				{
+					boundVao = rawModel->getVaoID();
+					indexType = rawModel->getIndexType();
+					bindModel(rawModel);
+				}
+				bindTexture(texture);
+			}
+
+			prevModel = model;
+		}
+
+		if (command->entity != prevEntity)
+		{
+			prepareInstance(command->entity);
+			prevEntity = command->entity;
+		}
+
+		glDrawElements(GL_TRIANGLES, rawModel->getVertexCount(), indexType, rawModel->getIndexOffset());
+		castersRendered++;
+	}
+
+	drawCommands.clear();
+	drawKeys.clear();
+
 	glDisableVertexAttribArray(0);
 	glDisableVertexAttribArray(1);
 	glBindVertexArray(0);
 }
 
+int ShadowMapEntityRenderer::getCastersRendered()
+{
+	return castersRendered;
+}
+
+int ShadowMapEntityRenderer::getCastersCulled()
+{
+	return castersCulled;
+}
+
+bool ShadowMapEntityRenderer::isCasterVisible(RawModel* model, Entity* entity)
+{
+	//Bounds were never calculated, so it can't be culled
+	if (model->getRadius() <= 0)
+	{
+		return true;
+	}
+
+	Vector3f* center = model->getCenter();
+	Vector4f modelCenter(center->x, center->y, center->z, 1.0f);
+	Vector4f worldCenter = entity->getTransformationMatrix()->transform(&modelCenter);
+	Vector4f boxCenter = projectionViewMatrix->transform(&worldCenter);
+
+	//The projection is orthographic, so the radius only needs to be scaled on each axis
+	Matrix4f* m = projectionViewMatrix;
+	float radius = model->getRadius()*fabsf(entity->getScale());
+	float radiusX = radius*sqrtf(m->m00*m->m00 + m->m10*m->m10 + m->m20*m->m20);
+	float radiusY = radius*sqrtf(m->m01*m->m01 + m->m11*m->m11 + m->m21*m->m21);
+	float radiusZ = radius*sqrtf(m->m02*m->m02 + m->m12*m->m12 + m->m22*m->m22);
+
+	return (fabsf(boxCenter.x) <= 1 + radiusX &&
+	        fabsf(boxCenter.y) <= 1 + radiusY &&
+	        boxCenter.z <= 1 + radiusZ);
+}
+
 void ShadowMapEntityRenderer::bindModel(RawModel* rawModel)
 {
 	glBindVertexArray(rawModel->getVaoID());
@@ -45,15 +155,24 @@ void ShadowMapEntityRenderer::bindModel(RawModel* rawModel)
 	glEnableVertexAttribArray(1);
 }
 
-void ShadowMapEntityRenderer::prepareInstance(Entity* entity)
+void ShadowMapEntityRenderer::bindTexture(ModelTexture* texture)
 {
-	Matrix4f modelMatrix;
-	Maths::createTransformationMatrix(
-		&modelMatrix,         entity->getPosition(), 
-		entity->getRotX(),    entity->getRotY(),     entity->getRotZ(),
-		entity->getRotSpin(), entity->getScale());
+	shader->loadUseTextureArray(texture->getUsesTextureArray());
+	if (texture->getUsesTextureArray())
+	{
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, texture->getID());
+	}
+	else
+	{
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, texture->getID());
+	}
+}
 
+void ShadowMapEntityRenderer::prepareInstance(Entity* entity)
+{
 	Matrix4f mvpMatrix;
-	projectionViewMatrix->multiply(&modelMatrix, &mvpMatrix);
+	projectionViewMatrix->multiply(entity->getTransformationMatrix(), &mvpMatrix);
 	shader->loadMvpMatrix(&mvpMatrix);
 }
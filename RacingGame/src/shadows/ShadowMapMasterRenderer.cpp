@@ -9,36 +9,168 @@
 #include "../entities/light.h"
 #include "../entities/entity.h"
 #include "../engineTester/main.h"
+#include "../renderEngine/renderEngine.h"
+#include "../renderEngine/skymanager.h"
+
+#include <cmath>
+#include <cstdio>
+
+#define STAT_CASCADES_RENDERED 0
+#define STAT_CASTERS_RENDERED  1
+#define STAT_CASTERS_CULLED    2
 
 ShadowMapMasterRenderer::ShadowMapMasterRenderer()
 {
-	projectionMatrix       = new Matrix4f; INCR_NEW
-	lightViewMatrix        = new Matrix4f; INCR_NEW
-	projectionViewMatrix   = new Matrix4f; INCR_NEW
-	toShadowMapSpaceMatrix = new Matrix4f; INCR_NEW
+	projectionMatrix = new Matrix4f; INCR_NEW
 	createOffset();
 
 	shader = new ShadowShader("res/Shaders/shadows/shadowVertexShader.txt", "res/Shaders/shadows/shadowFragmentShader.txt"); INCR_NEW
-	shadowBox = new ShadowBox(lightViewMatrix, Global::gameCamera); INCR_NEW
-	shadowFbo = new ShadowFrameBuffer(SHADOW_MAP_SIZE, SHADOW_MAP_SIZE); INCR_NEW
-	entityRenderer = new ShadowMapEntityRenderer(shader, projectionViewMatrix); INCR_NEW
+	shader->start();
+	shader->connectTextureUnits();
+	shader->stop();
+
+	cascadeCount = Global::shadowCascades;
+	if (cascadeCount < 1)
+	{
+		cascadeCount = 1;
+	}
+	else if (cascadeCount > MAX_CASCADES)
+	{
+		cascadeCount = MAX_CASCADES;
+	}
+	frameCount = 0;
+
+	createCascades(Global::renderShadowsFar ? SHADOW_DISTANCE_FAR : SHADOW_DISTANCE_CLOSE);
+
+	shadowFbo = new ShadowFrameBuffer(SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, cascadeCount); INCR_NEW
+	entityRenderer = new ShadowMapEntityRenderer(shader); INCR_NEW
+}
+
+void ShadowMapMasterRenderer::createCascades(float shadowDistance)
+{
+	float nearPlane = Master_getNearPlane();
+	float sliceNear = nearPlane;
+
+	for (int i = 0; i < cascadeCount; i++)
+	{
+		//Mix of logarithmic and even splits, so that the close cascades get
+		// most of the resolution without the far ones getting too big
+		float part = (float)(i + 1)/cascadeCount;
+		float logSplit  = nearPlane*powf(shadowDistance/nearPlane, part);
+		float evenSplit = nearPlane + (shadowDistance - nearPlane)*part;
+		float sliceFar  = SPLIT_LAMBDA*logSplit + (1 - SPLIT_LAMBDA)*evenSplit;
+		if (i == cascadeCount - 1)
+		{
+			sliceFar = shadowDistance;
+		}
+
+		ShadowCascade* cascade = &cascades[i];
+		cascade->lightViewMatrix        = new Matrix4f; INCR_NEW
+		cascade->projectionViewMatrix   = new Matrix4f; INCR_NEW
+		cascade->toShadowMapSpaceMatrix = new Matrix4f; INCR_NEW
+		cascade->shadowBox = new ShadowBox(cascade->lightViewMatrix, Global::gameCamera, sliceNear, sliceFar, fmaxf(OFFSET_MIN, sliceFar*OFFSET_SCALE)); INCR_NEW
+		cascade->farDistance = sliceFar;
+		cascade->bias = BIAS_NEAR;
+		if (cascadeCount > 1)
+		{
+			cascade->bias = BIAS_NEAR + (BIAS_FAR - BIAS_NEAR)*((float)i/(cascadeCount - 1));
+		}
+		cascade->needsUpdate = true;
+		cascade->timeOfDayAtUpdate = 0;
+
+		sliceNear = sliceFar;
+	}
 }
 
 void ShadowMapMasterRenderer::render(std::unordered_map<TexturedModel*, std::list<Entity*>>* entities, Light* sun)
 {
-	shadowBox->update();
 	Vector3f* sunPosition = sun->getPosition();
 	Vector3f lightDirection(-sunPosition->x, -sunPosition->y, -sunPosition->z);
-	prepare(&lightDirection, shadowBox);
-	entityRenderer->render(entities);
+	float timeOfDay = SkyManager::getTimeOfDay();
+
+	//Things between the sun and the cuboid get squashed onto the near plane instead of clipped
+	glEnable(GL_DEPTH_CLAMP);
+
+	for (int i = 0; i < cascadeCount; i++)
+	{
+		if (!shouldUpdateCascade(i, timeOfDay))
+		{
+			continue;
+		}
+
+		ShadowCascade* cascade = &cascades[i];
+		cascade->needsUpdate = false;
+		cascade->timeOfDayAtUpdate = timeOfDay;
+
+		cascade->shadowBox->update();
+		prepare(&lightDirection, i);
+		entityRenderer->render(entities, cascade->projectionViewMatrix);
+		offset->multiply(cascade->projectionViewMatrix, cascade->toShadowMapSpaceMatrix);
+
+		#ifdef DEV_MODE
+		stats.add(STAT_CASCADES_RENDERED, 1);
+		stats.add(STAT_CASTERS_RENDERED, entityRenderer->getCastersRendered());
+		stats.add(STAT_CASTERS_CULLED,   entityRenderer->getCastersCulled());
+		#endif
+	}
 	finish();
+
+	glDisable(GL_DEPTH_CLAMP);
+
+	frameCount++;
+
+	#ifdef DEV_MODE
+	if (stats.endFrame())
+	{
+		//Casters per cascade, out of the per frame averages
+		double cascadesRendered = stats.getAverage(STAT_CASCADES_RENDERED);
+		double perCascade = (cascadesRendered > 0) ? 1.0/cascadesRendered : 0.0;
+		std::fprintf(stdout, "Shadows on '%s': %d cascades, %f cascades rendered per frame, %f casters drawn and %f culled per cascade\n",
+			Global::levelName.c_str(), cascadeCount, cascadesRendered,
+			stats.getAverage(STAT_CASTERS_RENDERED)*perCascade,
+			stats.getAverage(STAT_CASTERS_CULLED)*perCascade);
+	}
+	#endif
 }
 
-Matrix4f* ShadowMapMasterRenderer::getToShadowMapSpaceMatrix()
+bool ShadowMapMasterRenderer::shouldUpdateCascade(int index, float timeOfDay)
 {
-	offset->multiply(projectionViewMatrix, toShadowMapSpaceMatrix);
+	ShadowCascade* cascade = &cascades[index];
+	if (index == 0 || cascade->needsUpdate)
+	{
+		return true;
+	}
+
+	//Time of day wraps around at 360
+	float sunMoved = fabsf(timeOfDay - cascade->timeOfDayAtUpdate);
+	sunMoved = fminf(sunMoved, 360 - sunMoved);
+	if (sunMoved > SUN_MOVE_THRESHOLD)
+	{
+		return true;
+	}
+
+	//Spread the far cascades out over different frames
+	return (frameCount % FAR_CASCADE_INTERVAL) == (index % FAR_CASCADE_INTERVAL);
+}
 
-	return toShadowMapSpaceMatrix;
+Matrix4f* ShadowMapMasterRenderer::getToShadowMapSpaceMatrix(int index)
+{
+	return cascades[index].toShadowMapSpaceMatrix;
+}
+
+int ShadowMapMasterRenderer::getCascadeCount()
+{
+	return cascadeCount;
+}
+
+float ShadowMapMasterRenderer::getCascadeFar(int index)
+{
+	return cascades[index].farDistance;
+}
+
+float ShadowMapMasterRenderer::getCascadeBias(int index)
+{
+	return cascades[index].bias;
 }
 
 void ShadowMapMasterRenderer::cleanUp()
@@ -52,18 +184,15 @@ GLuint ShadowMapMasterRenderer::getShadowMap()
 	return shadowFbo->getShadowMap();
 }
 
-Matrix4f* ShadowMapMasterRenderer::getLightSpaceTransform()
-{
-	return lightViewMatrix;
-}
-
-void ShadowMapMasterRenderer::prepare(Vector3f* lightDirection, ShadowBox* box)
+void ShadowMapMasterRenderer::prepare(Vector3f* lightDirection, int index)
 {
+	ShadowCascade* cascade = &cascades[index];
+	ShadowBox* box = cascade->shadowBox;
 	updateOrthoProjectionMatrix(box->getWidth(), box->getHeight(), box->getLength());
 	Vector3f cent = box->getCenter();
-	updateLightViewMatrix(lightDirection, &cent);
-	projectionMatrix->multiply(lightViewMatrix, projectionViewMatrix);
-	shadowFbo->bindFrameBuffer();
+	updateLightViewMatrix(cascade->lightViewMatrix, lightDirection, &cent);
+	projectionMatrix->multiply(cascade->lightViewMatrix, cascade->projectionViewMatrix);
+	shadowFbo->bindFrameBuffer(index);
 	glEnable(GL_DEPTH_TEST);
 	glClear(GL_DEPTH_BUFFER_BIT);
 	shader->start();
@@ -75,7 +204,7 @@ void ShadowMapMasterRenderer::finish()
 	shadowFbo->unbindFrameBuffer();
 }
 
-void ShadowMapMasterRenderer::updateLightViewMatrix(Vector3f* direction, Vector3f* center)
+void ShadowMapMasterRenderer::updateLightViewMatrix(Matrix4f* lightViewMatrix, Vector3f* direction, Vector3f* center)
 {
 	Vector3f dir(direction);
 	Vector3f cent(center);
@@ -51,10 +51,22 @@ void ShadowShader::loadMvpMatrix(Matrix4f* matrix)
 	loadMatrix(location_mvpMatrix, matrix);
 }
 
+void ShadowShader::loadUseTextureArray(int useTextureArray)
+{
+	loadFloat(location_useTextureArray, (float)useTextureArray);
+}
+
+void ShadowShader::connectTextureUnits()
+{
+	loadInt(location_modelTexture, 0);
+	loadInt(location_modelTextureArray, 1);
+}
+
 void ShadowShader::bindAttributes()
 {
 	bindAttribute(0, "in_position");
 	bindAttribute(1, "in_textureCoords");
+	bindAttribute(3, "in_textureLayer");
 }
 
 void ShadowShader::bindAttribute(int attribute, const char* variableName)
@@ -64,7 +76,10 @@ void ShadowShader::bindAttribute(int attribute, const char* variableName)
 
 void ShadowShader::getAllUniformLocations()
 {
-	location_mvpMatrix = getUniformLocation("mvpMatrix");
+	location_mvpMatrix          = getUniformLocation("mvpMatrix");
+	location_modelTexture       = getUniformLocation("modelTexture");
+	location_modelTextureArray  = getUniformLocation("modelTextureArray");
+	location_useTextureArray    = getUniformLocation("useTextureArray");
 }
 
 int ShadowShader::getUniformLocation(const char* uniformName)
@@ -79,3 +94,13 @@ void ShadowShader::loadMatrix(int location, Matrix4f* matrix)
 	matrix->store(shadowMatrixBuffer);
 	glUniformMatrix4fv(location, 1, GL_FALSE, shadowMatrixBuffer);
 }
+
+void ShadowShader::loadFloat(int location, float value)
+{
+	glUniform1f(location, value);
+}
+
+void ShadowShader::loadInt(int location, int value)
+{
+	glUniform1i(location, value);
+}
@@ -15,7 +15,8 @@
 * being too small to avoid objects not having shadows when they should.
 * Everything inside the cuboidal area represented by this object will be
 * rendered to the shadow map in the shadow render pass. Everything outside the
-* area won't be.
+* area won't be. Each shadow cascade has its own box that covers one slice
+* of the camera's view frustum.
 *
 * @author Karl
 *
@@ -23,10 +24,13 @@
 class ShadowBox
 {
 private:
-	const float OFFSET = 800;
-	Vector4f UP;
-	Vector4f FORWARD;
-	const float SHADOW_DISTANCE = 2000;
+	//How far the box reaches past the slice towards the sun, so that things
+	// outside of the view can still cast shadows into it
+	float offset;
+
+	//The slice of the camera's view frustum that this box covers
+	float nearDistance;
+	float farDistance;
 
 	float minX;
 	float maxX;
@@ -45,22 +49,21 @@ private:
 	
 	/**
 	* Calculates the position of the vertex at each corner of the view frustum
-	* in light space (8 vertices in total, so this returns 8 positions).
+	* slice in light space (8 vertices in total, so this returns 8 positions).
 	*
-	* @param rotation
-	*            - camera's rotation.
 	* @param forwardVector
 	*            - the direction that the camera is aiming, and thus the
 	*            direction of the frustum.
+	* @param upVector
+	*            - the camera's up direction, at a right angle to forwardVector.
 	* @param centerNear
-	*            - the center point of the frustum's near plane.
+	*            - the center point of the slice's near plane.
 	* @param centerFar
-	*            - the center point of the frustum's (possibly adjusted) far
-	*            plane.
-	* @return The positions of the vertices of the frustum in light space.
+	*            - the center point of the slice's far plane.
+	* @return The positions of the vertices of the frustum slice in light space.
 	*/
 	std::vector<Vector4f> calculateFrustumVertices(
-		Matrix4f* rotation, Vector3f* forwardVector,
+		Vector3f* forwardVector, Vector3f* upVector,
 		Vector3f* centerNear, Vector3f* centerFar);
 	
 	/**
@@ -77,17 +80,11 @@ private:
 	*/
 	Vector4f calculateLightSpaceFrustumCorner(Vector3f* startPoint, Vector3f* direction, float width);
 	
-	/**
-	* @return The rotation of the camera represented as a matrix.
-	*/
-	Matrix4f calculateCameraRotationMatrix();
-	
 	/**
 	* Calculates the width and height of the near and far planes of the
-	* camera's view frustum. However, this doesn't have to use the "actual" far
-	* plane of the view frustum. It can use a shortened view frustum if desired
-	* by bringing the far-plane closer, which would increase shadow resolution
-	* but means that distant objects wouldn't cast shadows.
+	* slice of the camera's view frustum that this box covers. The full
+	* vertical fov is used as the half angle, which leaves room for the
+	* extra fov that the camera gets when the car is going fast.
 	*/
 	void calculateWidthsAndHeights();
 	
@@ -99,8 +96,8 @@ private:
 public:
 	/**
 	* Creates a new shadow box and calculates some initial values relating to
-	* the camera's view frustum, namely the width and height of the near plane
-	* and (possibly adjusted) far plane.
+	* the camera's view frustum, namely the width and height of the near and
+	* far planes of the slice that it covers.
 	*
 	* @param lightViewMatrix
 	*            - basically the "view matrix" of the light. Can be used to
@@ -109,14 +106,20 @@ public:
 	*            world's axis to being in terms of the light's local axis).
 	* @param camera
 	*            - the in-game camera.
+	* @param nearDistance
+	*            - distance from the camera where the slice starts.
+	* @param farDistance
+	*            - distance from the camera where the slice ends.
+	* @param offset
+	*            - how far the box reaches past the slice towards the sun.
 	*/
-	ShadowBox(Matrix4f* lightViewMatrix, Camera* camera);
+	ShadowBox(Matrix4f* lightViewMatrix, Camera* camera, float nearDistance, float farDistance, float offset);
 
 	/**
 	* Updates the bounds of the shadow box based on the light direction and the
 	* camera's view frustum, to make sure that the box covers the smallest area
 	* possible while still ensuring that everything inside the camera's view
-	* (within a certain range) will cast shadows.
+	* (within the slice) will cast shadows.
 	*/
 	void update();
 
@@ -5,8 +5,8 @@
 
 /**
 * The frame buffer for the shadow pass. This class sets up the depth texture
-* which can be rendered to during the shadow render pass, producing a shadow
-* map.
+* array which can be rendered to during the shadow render pass, producing a
+* shadow map with one layer for each cascade.
 *
 * @author Karl
 *
@@ -16,6 +16,7 @@ class ShadowFrameBuffer
 private:
 	int WIDTH;
 	int HEIGHT;
+	int LAYERS;
 	GLuint fbo;
 	GLuint shadowMap;
 	
@@ -46,15 +47,17 @@ private:
 	static int createFrameBuffer();
 
 	/**
-	* Creates a depth buffer texture attachment.
+	* Creates a depth buffer texture array attachment.
 	*
 	* @param width
 	*            - the width of the texture.
 	* @param height
 	*            - the height of the texture.
-	* @return The ID of the depth texture.
+	* @param layers
+	*            - the number of layers in the texture.
+	* @return The ID of the depth texture array.
 	*/
-	static int createDepthBufferAttachment(int width, int height);
+	static int createDepthBufferAttachment(int width, int height, int layers);
 
 public:
 	/**
@@ -64,8 +67,10 @@ public:
 	*            - the width of the shadow map in pixels.
 	* @param height
 	*            - the height of the shadow map in pixels.
+	* @param layers
+	*            - the number of layers in the shadow map.
 	*/
-	ShadowFrameBuffer(int width, int height);
+	ShadowFrameBuffer(int width, int height, int layers);
 
 	/**
 	* Deletes the frame buffer and shadow map texture when the game closes.
@@ -73,9 +78,13 @@ public:
 	void cleanUp();
 
 	/**
-	* Binds the frame buffer, setting it as the current render target.
+	* Binds the frame buffer, setting one layer of the shadow map as the
+	* current render target.
+	*
+	* @param layer
+	*            - the layer of the shadow map to render to.
 	*/
-	void bindFrameBuffer();
+	void bindFrameBuffer(int layer);
 
 	/**
 	* Unbinds the frame buffer, setting the default frame buffer as the current
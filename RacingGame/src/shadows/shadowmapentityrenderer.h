@@ -6,17 +6,35 @@ class Matrix4f;
 class Entity;
 class RawModel;
 class TexturedModel;
+class ModelTexture;
 
 #include <glad/glad.h>
 #include <unordered_map>
 #include <list>
+#include <vector>
+
+#include "../toolbox/radixsort.h"
 
 class ShadowMapEntityRenderer
 {
 private:
+	//A single model of a single entity that casts a shadow into the current cascade
+	struct DrawCommand
+	{
+		TexturedModel* model;
+		Entity* entity;
+	};
+
 	Matrix4f* projectionViewMatrix;
 	ShadowShader* shader;
 
+	std::vector<DrawCommand> drawCommands;
+	std::vector<RadixSortItem> drawKeys;
+	std::vector<RadixSortItem> drawKeysScratch;
+
+	int castersRendered;
+	int castersCulled;
+
 	/**
 	* Binds a raw model before rendering. Only the attribute 0 is enabled here
 	* because that is where the positions are stored in the VAO, and only the
@@ -27,6 +45,15 @@ private:
 	*/
 	void bindModel(RawModel* rawModel);
 
+	/**
+	* Binds the texture of a model, so that its transparent parts don't cast
+	* shadows. Textures packed into a texture array use a different unit.
+	*
+	* @param texture
+	*            - the texture to be bound.
+	*/
+	void bindTexture(ModelTexture* texture);
+
 	/**
 	* Prepares an entity to be rendered. The model matrix is created in the
 	* usual way and then multiplied with the projection and view matrix (often
@@ -38,24 +65,50 @@ private:
 	*/
 	void prepareInstance(Entity* entity);
 
+	/**
+	* Checks if the bounding sphere of a model of an entity is inside of the
+	* "view cuboid". The cuboid is only tested on the sides and the end that
+	* is away from the sun, because things between the sun and the cuboid
+	* still cast shadows into it (they get clamped to the near plane).
+	*
+	* @param model
+	*            - the model being tested.
+	* @param entity
+	*            - the entity that the model belongs to.
+	* @return Whether the model could cast a shadow into the cuboid.
+	*/
+	bool isCasterVisible(RawModel* model, Entity* entity);
+
 public:
 	/**
 	* @param shader
 	*            - the simple shader program being used for the shadow render
 	*            pass.
-	* @param projectionViewMatrix
-	*            - the orthographic projection matrix multiplied by the light's
-	*            "view" matrix.
 	*/
-	ShadowMapEntityRenderer(ShadowShader* shader, Matrix4f* projectionViewMatrix);
+	ShadowMapEntityRenderer(ShadowShader* shader);
 
 	/**
-	* Renders entieis to the shadow map. Each model is first bound and then all
-	* of the entities using that model are rendered to the shadow map.
+	* Renders entities to one cascade of the shadow map. Models that are
+	* outside of the cascade's "view cuboid" are culled, and the rest are
+	* sorted by VAO, texture and entity so that the ranges of a batched model
+	* can be drawn together.
 	*
 	* @param entities
 	*            - the entities to be rendered to the shadow map.
+	* @param projectionViewMatrix
+	*            - the orthographic projection matrix multiplied by the light's
+	*            "view" matrix, for the cascade being rendered.
+	*/
+	void render(std::unordered_map<TexturedModel*, std::list<Entity*>>* entities, Matrix4f* projectionViewMatrix);
+
+	/**
+	* @return The number of models that were drawn by the last render.
+	*/
+	int getCastersRendered();
+
+	/**
+	* @return The number of models that were culled by the last render.
 	*/
-	void render(std::unordered_map<TexturedModel*, std::list<Entity*>>* entities);
+	int getCastersCulled();
 };
 #endif
\ No newline at end of file
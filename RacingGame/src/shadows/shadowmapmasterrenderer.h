@@ -16,31 +16,100 @@ class Entity;
 #include <unordered_map>
 #include <list>
 
+#include "../toolbox/framestats.h"
+
 /**
 * This class is in charge of using all of the classes in the shadows package to
 * carry out the shadow render pass, i.e. rendering the scene to the shadow map
 * texture. This is the only class in the shadows package which needs to be
 * referenced from outside the shadows package.
 *
+* The camera's view frustum is split into a number of cascades, and each one
+* gets its own layer of the shadow map. The first cascade is rendered every
+* frame, and the farther ones take turns, unless the sun has moved.
+*
 * @author Karl
 *
 */
 class ShadowMapMasterRenderer
 {
+public:
+	//Must be kept in sync with the size of the arrays in the entity shaders
+	static const int MAX_CASCADES = 4;
+
 private:
-	static const int SHADOW_MAP_SIZE = 2048 * 4;
+	//Must be kept in sync with mapSize in the entity shaders
+	static const int SHADOW_MAP_SIZE = 4096;
+
+	//How often the cascades past the first one are rendered, in frames
+	static const int FAR_CASCADE_INTERVAL = 4;
+
+	//How far the shadows reach with Render_Shadows_Far on, and with only Render_Shadows_Close on
+	const float SHADOW_DISTANCE_FAR = 2000;
+	const float SHADOW_DISTANCE_CLOSE = 180;
+
+	//Blend between logarithmic (1) and even (0) splits of the view frustum
+	const float SPLIT_LAMBDA = 0.9f;
+
+	//How far each shadow box reaches past its slice towards the sun,
+	// as a fraction of how far the slice reaches from the camera
+	const float OFFSET_SCALE = 0.4f;
+	const float OFFSET_MIN = 35;
+
+	//Depth bias for the first and last cascades. Cascades in between are interpolated.
+	const float BIAS_NEAR = 0.0025f;
+	const float BIAS_FAR = 0.00125f;
+
+	//How far the sun can move (in degrees of time of day) before all of the cascades are rendered again
+	const float SUN_MOVE_THRESHOLD = 0.25f;
+
+	//One slice of the camera's view frustum, with its own layer of the shadow map
+	struct ShadowCascade
+	{
+		ShadowBox* shadowBox;
+		Matrix4f* lightViewMatrix;
+		Matrix4f* projectionViewMatrix;
+		Matrix4f* toShadowMapSpaceMatrix;
+		float farDistance;
+		float bias;
+		bool needsUpdate;
+		float timeOfDayAtUpdate;
+	};
+
+	ShadowCascade cascades[MAX_CASCADES];
+	int cascadeCount;
+	int frameCount;
 
 	ShadowFrameBuffer* shadowFbo;
 	ShadowShader* shader;
-	ShadowBox* shadowBox;
 	Matrix4f* projectionMatrix;
-	Matrix4f* lightViewMatrix ;
-	Matrix4f* projectionViewMatrix;
 	Matrix4f* offset;
-	Matrix4f* toShadowMapSpaceMatrix;
 
 	ShadowMapEntityRenderer* entityRenderer;
 
+	//Shadow pass stats, printed every few hundred frames in DEV_MODE
+	FrameStats stats;
+
+	/**
+	* Works out how far from the camera each cascade ends, and creates the
+	* shadow box and matrices for each one.
+	*
+	* @param shadowDistance
+	*            - how far from the camera the last cascade ends.
+	*/
+	void createCascades(float shadowDistance);
+
+	/**
+	* Decides if a cascade needs to be rendered this frame.
+	*
+	* @param index
+	*            - which cascade.
+	* @param timeOfDay
+	*            - the current time of day.
+	* @return Whether the cascade should be rendered.
+	*/
+	bool shouldUpdateCascade(int index, float timeOfDay);
+
 	/**
 	* Prepare for the shadow render pass. This first updates the dimensions of
 	* the orthographic "view cuboid" based on the information that was
@@ -57,11 +126,11 @@ private:
 	*
 	* @param lightDirection
 	*            - the direction of the light rays coming from the sun.
-	* @param box
-	*            - the shadow box, which contains all the info about the
-	*            "view cuboid".
+	* @param index
+	*            - which cascade is being rendered. Its shadow box contains
+	*            all the info about the "view cuboid".
 	*/
-	void prepare(Vector3f* lightDirection, ShadowBox* box);
+	void prepare(Vector3f* lightDirection, int index);
 
 	/**
 	* Finish the shadow render pass. Stops the shader and unbinds the shadow
@@ -78,13 +147,15 @@ private:
 	* where and how the "view cuboid" is positioned in the world. The size of
 	* the view cuboid, however, is determined by the projection matrix.
 	*
+	* @param lightViewMatrix
+	*            - the "view" matrix to update.
 	* @param direction
 	*            - the light direction, and therefore the direction that the
 	*            "view cuboid" should be pointing.
 	* @param center
 	*            - the center of the "view cuboid" in world space.
 	*/
-	void updateLightViewMatrix(Vector3f* direction, Vector3f* center);
+	void updateLightViewMatrix(Matrix4f* lightViewMatrix, Vector3f* direction, Vector3f* center);
 
 	/**
 	* Creates the orthographic projection matrix. This projection matrix
@@ -125,11 +196,12 @@ public:
 
 	/**
 	* Carries out the shadow render pass. This renders the entities to the
-	* shadow map. First the shadow box is updated to calculate the size and
-	* position of the "view cuboid". The light direction is assumed to be
-	* "-lightPosition" which will be fairly accurate assuming that the light is
-	* very far from the scene. It then prepares to render, renders the entities
-	* to the shadow map, and finishes rendering.
+	* shadow map, once for each cascade that needs it this frame. First the
+	* cascade's shadow box is updated to calculate the size and position of
+	* the "view cuboid". The light direction is assumed to be "-lightPosition"
+	* which will be fairly accurate assuming that the light is very far from
+	* the scene. It then prepares to render, renders the entities that are in
+	* the cuboid to the shadow map, and finishes rendering.
 	*
 	* @param entities
 	*            - the map of entities to be rendered. Each list is
@@ -144,11 +216,33 @@ public:
 	* This biased projection-view matrix is used to convert fragments into
 	* "shadow map space" when rendering the main render pass. It converts a
 	* world space position into a 2D coordinate on the shadow map. This is
-	* needed for the second part of shadow mapping.
+	* needed for the second part of shadow mapping. Cascades that weren't
+	* rendered this frame keep the matrix from when they were last rendered.
 	*
+	* @param index
+	*            - which cascade.
 	* @return The to-shadow-map-space matrix.
 	*/
-	Matrix4f* getToShadowMapSpaceMatrix();
+	Matrix4f* getToShadowMapSpaceMatrix(int index);
+
+	/**
+	* @return The number of cascades the shadow map is split into.
+	*/
+	int getCascadeCount();
+
+	/**
+	* @param index
+	*            - which cascade.
+	* @return How far from the camera the cascade ends.
+	*/
+	float getCascadeFar(int index);
+
+	/**
+	* @param index
+	*            - which cascade.
+	* @return The depth bias to use when sampling the cascade.
+	*/
+	float getCascadeBias(int index);
 
 	/**
 	* Clean up the shader and FBO on closing.
@@ -156,15 +250,10 @@ public:
 	void cleanUp();
 
 	/**
-	* @return The ID of the shadow map texture. The ID will always stay the
-	*         same, even when the contents of the shadow map texture change
+	* @return The ID of the shadow map texture array. The ID will always stay
+	*         the same, even when the contents of the shadow map texture change
 	*         each frame.
 	*/
 	GLuint getShadowMap();
-
-	/**
-	* @return The light's "view" matrix.
-	*/
-	Matrix4f* getLightSpaceTransform();
 };
 #endif
\ No newline at end of file
@@ -15,6 +15,9 @@ private:
 	GLuint fragmentShaderID;
 
 	int location_mvpMatrix;
+	int location_modelTexture;
+	int location_modelTextureArray;
+	int location_useTextureArray;
 
 public:
 	ShadowShader(const char* vertFile, const char* fragFile);
@@ -27,6 +30,10 @@ public:
 
 	void loadMvpMatrix(Matrix4f* mvpMatrix);
 
+	void loadUseTextureArray(int useTextureArray);
+
+	void connectTextureUnits();
+
 
 protected:
 	void bindAttributes();
@@ -38,6 +45,10 @@ protected:
 	int getUniformLocation(const char* uniName);
 
 	void loadMatrix(int, Matrix4f* mat);
+
+	void loadFloat(int, float);
+
+	void loadInt(int, int);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,321 @@
+#include <glad/glad.h>
+#include <SOIL/SOIL.h>
+#include <SOIL/image_helper.h>
+extern "C"
+{
+	#include <SOIL/image_DXT.h>
+}
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <functional>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include "cookedtexture.h"
+#include "../toolbox/mappedfile.h"
+#include "../engineTester/main.h"
+
+std::mutex CookedTexture::decodeMutex;
+
+CookedTexture::CookedTexture()
+{
+	width = 0;
+	height = 0;
+	format = GL_RGBA;
+}
+
+bool CookedTexture::load(std::string fileName, bool compress)
+{
+	MappedFile file;
+	if (!file.open(fileName))
+	{
+		std::fprintf(stdout, "Error loading image '%s', because the file can't be opened\n", fileName.c_str());
+		return false;
+	}
+
+	const unsigned char* bytes = (const unsigned char*)file.getData();
+	int size = (int)file.getSize();
+
+	unsigned long long hash = hashBytes(bytes, size);
+	std::string cacheName = cacheFileName(hash, compress);
+	if (readCache(cacheName, hash))
+	{
+		return true;
+	}
+
+	int channels;
+	unsigned char* pixels;
+	{
+		std::lock_guard<std::mutex> lock(decodeMutex);
+		pixels = SOIL_load_image_from_memory(bytes, size, &width, &height, &channels, SOIL_LOAD_RGBA);
+		if (pixels == 0)
+		{
+			const char* err = SOIL_last_result();
+			std::fprintf(stdout, "Error loading image '%s', because '%s'\n", fileName.c_str(), err);
+			width = 0;
+			height = 0;
+			return false;
+		}
+	}
+
+	cook(pixels, compress);
+	SOIL_free_image_data(pixels);
+
+	writeCache(cacheName, hash);
+
+	return true;
+}
+
+void CookedTexture::loadAll(std::vector<std::string>* fileNames, bool compress, std::vector<CookedTexture>* textures)
+{
+	#ifdef DEV_MODE
+	auto timeStart = std::chrono::high_resolution_clock::now();
+	#endif
+
+	textures->assign(fileNames->size(), CookedTexture());
+
+	//Each thread takes the next image that nobody has started yet
+	std::atomic<int> next(0);
+	auto loadImages = [&]()
+	{
+		for (int i = next++; i < (int)fileNames->size(); i = next++)
+		{
+			(*textures)[i].load((*fileNames)[i], compress);
+		}
+	};
+
+	int threadCount = std::min((int)fileNames->size(), (int)std::thread::hardware_concurrency());
+
+	//This thread loads images too
+	std::vector<std::thread> threads;
+	for (int i = 1; i < threadCount; i++)
+	{
+		threads.push_back(std::thread(loadImages));
+	}
+	loadImages();
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	#ifdef DEV_MODE
+	auto timeEnd = std::chrono::high_resolution_clock::now();
+	std::fprintf(stdout, "Textures: %d images loaded on %d threads in %f ms\n",
+		(int)fileNames->size(), std::max(threadCount, 1),
+		std::chrono::duration<double, std::milli>(timeEnd - timeStart).count());
+	#endif
+}
+
+bool CookedTexture::isCompressed()
+{
+	return format != GL_RGBA;
+}
+
+long long CookedTexture::getByteCount()
+{
+	long long bytes = 0;
+	for (std::vector<unsigned char>& level : levels)
+	{
+		bytes += level.size();
+	}
+	return bytes;
+}
+
+long long CookedTexture::getRGBAByteCount()
+{
+	long long bytes = 0;
+	for (int level = 0; level < (int)levels.size(); level++)
+	{
+		bytes += (long long)std::max(1, width >> level)*std::max(1, height >> level)*4;
+	}
+	return bytes;
+}
+
+void CookedTexture::cook(unsigned char* pixels, bool compress)
+{
+	bool opaque = true;
+	for (int i = 0; i < width*height; i++)
+	{
+		if (pixels[i*4 + 3] != 255)
+		{
+			opaque = false;
+			break;
+		}
+	}
+
+	format = GL_RGBA;
+	if (compress)
+	{
+		format = opaque ? COMPRESSED_RGB_S3TC_DXT1 : COMPRESSED_RGBA_S3TC_DXT5;
+	}
+
+	levels.clear();
+
+	//Each level is the one before it shrunk by half, the same way glGenerateMipmap does it
+	std::vector<unsigned char> current(pixels, pixels + width*height*4);
+	std::vector<unsigned char> smaller;
+	int levelWidth = width;
+	int levelHeight = height;
+	while (true)
+	{
+		if (format == GL_RGBA)
+		{
+			levels.push_back(current);
+		}
+		else
+		{
+			int compressedSize = 0;
+			unsigned char* compressed = (format == COMPRESSED_RGB_S3TC_DXT1) ?
+				convert_image_to_DXT1(&current[0], levelWidth, levelHeight, 4, &compressedSize) :
+				convert_image_to_DXT5(&current[0], levelWidth, levelHeight, 4, &compressedSize);
+			levels.push_back(std::vector<unsigned char>(compressed, compressed + compressedSize));
+			free(compressed);
+		}
+
+		if (levelWidth == 1 && levelHeight == 1)
+		{
+			break;
+		}
+
+		int smallerWidth  = std::max(1, levelWidth/2);
+		int smallerHeight = std::max(1, levelHeight/2);
+		smaller.resize(smallerWidth*smallerHeight*4);
+		mipmap_image(&current[0], levelWidth, levelHeight, 4, &smaller[0], 2, 2);
+		current.swap(smaller);
+		levelWidth = smallerWidth;
+		levelHeight = smallerHeight;
+	}
+}
+
+unsigned long long CookedTexture::hashBytes(const unsigned char* bytes, size_t size)
+{
+	//FNV-1a
+	unsigned long long hash = 14695981039346656037ull;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+std::string CookedTexture::cacheFileName(unsigned long long hash, bool compress)
+{
+	char name[64];
+	snprintf(name, sizeof(name), "res/TextureCache/%016llx%s.ctex", hash, compress ? "bc" : "");
+	return name;
+}
+
+bool CookedTexture::readCache(std::string fileName, unsigned long long hash)
+{
+	FILE* file = nullptr;
+	int err = fopen_s(&file, fileName.c_str(), "rb");
+	if (file == nullptr || err != 0)
+	{
+		return false;
+	}
+
+	char fileType[4];
+	int version = 0;
+	unsigned long long sourceHash = 0;
+	int levelCount = 0;
+	bool valid =
+		fread(fileType, sizeof(char), 4, file) == 4 &&
+		memcmp(fileType, "ctx", 4) == 0 &&
+		fread(&version, sizeof(int), 1, file) == 1 &&
+		version == CACHE_VERSION &&
+		fread(&sourceHash, sizeof(unsigned long long), 1, file) == 1 &&
+		sourceHash == hash &&
+		fread(&width,  sizeof(int), 1, file) == 1 &&
+		fread(&height, sizeof(int), 1, file) == 1 &&
+		fread(&format, sizeof(GLenum), 1, file) == 1 &&
+		fread(&levelCount, sizeof(int), 1, file) == 1 &&
+		levelCount > 0 && levelCount <= 32;
+
+	levels.assign(valid ? levelCount : 0, std::vector<unsigned char>());
+	for (int i = 0; valid && i < levelCount; i++)
+	{
+		int size = 0;
+		valid = fread(&size, sizeof(int), 1, file) == 1 && size > 0;
+		if (valid)
+		{
+			levels[i].resize(size);
+			valid = fread(&levels[i][0], sizeof(unsigned char), size, file) == (size_t)size;
+		}
+	}
+
+	fclose(file);
+
+	if (!valid)
+	{
+		//It gets cooked again and written over
+		width = 0;
+		height = 0;
+		format = GL_RGBA;
+		levels.clear();
+	}
+
+	return valid;
+}
+
+void CookedTexture::writeCache(std::string fileName, unsigned long long hash)
+{
+	#ifdef _WIN32
+	_mkdir("res/TextureCache");
+	#else
+	mkdir("res/TextureCache", 0777);
+	#endif
+
+	//Written under a name of its own and then renamed, so that two threads loading the
+	// same image never write into one file, and one that has it mapped never sees it cut short
+	std::string tempName = fileName + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+	FILE* file = nullptr;
+	int err = fopen_s(&file, tempName.c_str(), "wb");
+	if (file == nullptr || err != 0)
+	{
+		return;
+	}
+
+	int version = CACHE_VERSION;
+	int levelCount = (int)levels.size();
+	fwrite("ctx", sizeof(char), 4, file);
+	fwrite(&version, sizeof(int), 1, file);
+	fwrite(&hash, sizeof(unsigned long long), 1, file);
+	fwrite(&width,  sizeof(int), 1, file);
+	fwrite(&height, sizeof(int), 1, file);
+	fwrite(&format, sizeof(GLenum), 1, file);
+	fwrite(&levelCount, sizeof(int), 1, file);
+	for (std::vector<unsigned char>& level : levels)
+	{
+		int size = (int)level.size();
+		fwrite(&size, sizeof(int), 1, file);
+		fwrite(&level[0], sizeof(unsigned char), size, file);
+	}
+	fclose(file);
+
+	//rename can't replace an existing file on Windows. A .ctex that can't be removed is
+	// mapped by a thread that loaded the same png, so it is already up to date.
+	if (std::rename(tempName.c_str(), fileName.c_str()) != 0)
+	{
+		std::remove(fileName.c_str());
+		if (std::rename(tempName.c_str(), fileName.c_str()) != 0)
+		{
+			std::remove(tempName.c_str());
+		}
+	}
+}
\ No newline at end of file
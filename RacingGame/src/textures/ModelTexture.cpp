@@ -11,6 +11,10 @@ ModelTexture::ModelTexture()
 	this->hasTransparency = 0;
 	this->useFakeLighting = 0;
 	this->glowAmount = 0;
+	this->scrollX = 0;
+	this->scrollY = 0;
+	this->useTextureArray = 0;
+	this->textureLayer = 0;
 }
 
 ModelTexture::ModelTexture(GLuint texID)
@@ -21,6 +25,10 @@ ModelTexture::ModelTexture(GLuint texID)
 	this->hasTransparency = 0;
 	this->useFakeLighting = 0;
 	this->glowAmount = 0;
+	this->scrollX = 0;
+	this->scrollY = 0;
+	this->useTextureArray = 0;
+	this->textureLayer = 0;
 }
 
 GLuint ModelTexture::getID()
@@ -99,6 +107,39 @@ float ModelTexture::getScrollY()
 	return scrollY;
 }
 
+int ModelTexture::getUsesTextureArray()
+{
+	return useTextureArray;
+}
+
+void ModelTexture::setUsesTextureArray(int newUsesTextureArray)
+{
+	useTextureArray = newUsesTextureArray;
+}
+
+int ModelTexture::getTextureLayer()
+{
+	return textureLayer;
+}
+
+void ModelTexture::setTextureLayer(int newTextureLayer)
+{
+	textureLayer = newTextureLayer;
+}
+
+bool ModelTexture::hasSameState(ModelTexture* other)
+{
+	return (texID           == other->texID           &&
+			shineDamper     == other->shineDamper     &&
+			reflectivity    == other->reflectivity    &&
+			scrollX         == other->scrollX         &&
+			scrollY         == other->scrollY         &&
+			glowAmount      == other->glowAmount      &&
+			hasTransparency == other->hasTransparency &&
+			useFakeLighting == other->useFakeLighting &&
+			useTextureArray == other->useTextureArray);
+}
+
 void ModelTexture::deleteMe()
 {
 	Loader::deleteTexture(texID);
@@ -0,0 +1,67 @@
+#ifndef COOKEDTEXTURE_H
+#define COOKEDTEXTURE_H
+
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+#include <mutex>
+
+//An image that is ready to go straight to the gpu. All of its mipmap levels
+// are already made, and they can be block compressed on the cpu as well.
+//Decoding a png is slow, so the result is kept in the texture cache as a .ctex
+// file named after a hash of the png's bytes. When the same png gets loaded
+// again, even from somewhere else, it only gets hashed and never decoded.
+class CookedTexture
+{
+private:
+	static const int CACHE_VERSION = 1;
+
+	//SOIL's png decoder keeps one of its huffman tables in a static variable,
+	// so only one image can be decoded at a time. Everything else runs in parallel.
+	static std::mutex decodeMutex;
+
+	static unsigned long long hashBytes(const unsigned char* bytes, size_t size);
+
+	static std::string cacheFileName(unsigned long long hash, bool compress);
+
+	//Returns false if there is no cached copy, or it is out of date
+	bool readCache(std::string fileName, unsigned long long hash);
+
+	void writeCache(std::string fileName, unsigned long long hash);
+
+	//Makes every mipmap level from the decoded RGBA pixels, compressing them if compress
+	void cook(unsigned char* pixels, bool compress);
+
+public:
+	//glad only has core gl 4.0, which doesn't have the s3tc formats
+	static const GLenum COMPRESSED_RGB_S3TC_DXT1  = 0x83F0;
+	static const GLenum COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+
+	int width;
+	int height;
+
+	//GL_RGBA for plain pixels, or one of the compressed formats
+	GLenum format;
+
+	//Level 0 is the full size image, and the last one is 1x1
+	std::vector<std::vector<unsigned char>> levels;
+
+	CookedTexture();
+
+	//Returns false if the image couldn't be loaded.
+	//With compress, opaque images become DXT1 (BC1), and ones with any alpha become DXT5 (BC3).
+	bool load(std::string fileName, bool compress);
+
+	//Loads all of the images at the same time on as many threads as there are cores.
+	//Images that couldn't be loaded are left with a width of 0.
+	static void loadAll(std::vector<std::string>* fileNames, bool compress, std::vector<CookedTexture>* textures);
+
+	bool isCompressed();
+
+	//Bytes that all of the levels take up on the gpu
+	long long getByteCount();
+
+	//Bytes that all of the levels would take up as RGBA
+	long long getRGBAByteCount();
+};
+#endif
\ No newline at end of file
@@ -16,6 +16,8 @@ private:
 	float glowAmount;
 	int hasTransparency;
 	int useFakeLighting;
+	int useTextureArray;
+	int textureLayer;
 
 public:
 	ModelTexture();
@@ -46,6 +48,18 @@ public:
 	float getScrollX();
 	float getScrollY();
 
+	//If the texture is a GL_TEXTURE_2D_ARRAY, the id is of the whole array, and
+	// this material uses only one layer of it
+	int getUsesTextureArray();
+	void setUsesTextureArray(int newUsesTextureArray);
+
+	int getTextureLayer();
+	void setTextureLayer(int newTextureLayer);
+
+	//Returns true if drawing with either texture needs exactly the same gl state.
+	//The layer isn't part of the gl state, since it is stored in the vertices.
+	bool hasSameState(ModelTexture* other);
+
 	void deleteMe();
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <functional>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "backgroundloader.h"
+
+std::thread::id BackgroundLoader::mainThreadID;
+std::thread BackgroundLoader::worker;
+bool BackgroundLoader::workerRunning = false;
+
+std::mutex BackgroundLoader::mutex;
+std::condition_variable BackgroundLoader::jobChanged;
+
+std::deque<BackgroundLoader::PendingJob*> BackgroundLoader::pendingJobs;
+
+void BackgroundLoader::init()
+{
+	BackgroundLoader::mainThreadID = std::this_thread::get_id();
+}
+
+bool BackgroundLoader::isMainThread()
+{
+	return std::this_thread::get_id() == BackgroundLoader::mainThreadID;
+}
+
+void BackgroundLoader::start(std::function<void()> work)
+{
+	//Finish off whatever was running before
+	while (!BackgroundLoader::update(1000.0))
+	{
+
+	}
+
+	BackgroundLoader::workerRunning = true;
+	BackgroundLoader::worker = std::thread([work]()
+	{
+		work();
+
+		std::lock_guard<std::mutex> lock(BackgroundLoader::mutex);
+		BackgroundLoader::workerRunning = false;
+		BackgroundLoader::jobChanged.notify_all();
+	});
+}
+
+void BackgroundLoader::runOnMainThread(std::function<void()> job)
+{
+	if (BackgroundLoader::isMainThread())
+	{
+		job();
+		return;
+	}
+
+	PendingJob pending;
+	pending.job = &job;
+	pending.done = false;
+
+	std::unique_lock<std::mutex> lock(BackgroundLoader::mutex);
+	BackgroundLoader::pendingJobs.push_back(&pending);
+	BackgroundLoader::jobChanged.notify_all();
+	BackgroundLoader::jobChanged.wait(lock, [&pending]() { return pending.done; });
+}
+
+bool BackgroundLoader::update(double milliseconds)
+{
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds((long long)(milliseconds*1000));
+
+	std::unique_lock<std::mutex> lock(BackgroundLoader::mutex);
+	while (BackgroundLoader::workerRunning || BackgroundLoader::pendingJobs.size() > 0)
+	{
+		if (BackgroundLoader::pendingJobs.size() == 0)
+		{
+			//The worker is still busy with its own part, so give it
+			// the rest of the time to get to its next gl call
+			if (BackgroundLoader::jobChanged.wait_until(lock, deadline) == std::cv_status::timeout)
+			{
+				break;
+			}
+			continue;
+		}
+
+		PendingJob* pending = BackgroundLoader::pendingJobs.front();
+		BackgroundLoader::pendingJobs.pop_front();
+		lock.unlock();
+		(*pending->job)();
+		lock.lock();
+
+		pending->done = true;
+		BackgroundLoader::jobChanged.notify_all();
+
+		if (std::chrono::steady_clock::now() >= deadline)
+		{
+			break;
+		}
+	}
+
+	if (BackgroundLoader::workerRunning || BackgroundLoader::pendingJobs.size() > 0)
+	{
+		return false;
+	}
+
+	lock.unlock();
+	if (BackgroundLoader::worker.joinable())
+	{
+		BackgroundLoader::worker.join();
+	}
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,595 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <functional>
+
+#include "compiledlevel.h"
+#include "mappedfile.h"
+#include "split.h"
+#include "../engineTester/main.h"
+
+//Splits line on spaces
+static std::vector<std::string> splitLine(std::string line)
+{
+	std::vector<char> lineBuf(line.begin(), line.end());
+	lineBuf.push_back(0);
+
+	int splitLength = 0;
+	char** lineSplit = split(&lineBuf[0], ' ', &splitLength);
+
+	std::vector<std::string> tokens;
+	for (int i = 0; i < splitLength; i++)
+	{
+		tokens.push_back(lineSplit[i]);
+	}
+	free(lineSplit);
+
+	return tokens;
+}
+
+static float toFloat(std::string token)
+{
+	return strtof(token.c_str(), nullptr);
+}
+
+static int toInt(std::string token)
+{
+	return (int)strtol(token.c_str(), nullptr, 10);
+}
+
+template <typename T>
+static void writeSection(std::vector<T>* items, LevelSection* section, std::vector<char>* bytes)
+{
+	section->offset = (int)bytes->size();
+	section->count = (int)items->size();
+	if (items->size() > 0)
+	{
+		const char* start = (const char*)&(*items)[0];
+		bytes->insert(bytes->end(), start, start + items->size()*sizeof(T));
+	}
+}
+
+CompiledLevel::CompiledLevel()
+{
+	data = nullptr;
+	size = 0;
+}
+
+bool CompiledLevel::open(std::string lvlFileName)
+{
+	close();
+
+	#ifdef DEV_MODE
+	auto timeStart = std::chrono::high_resolution_clock::now();
+	#endif
+
+	std::string compiledFileName = CompiledLevel::getCompiledFileName(lvlFileName);
+
+	//A .clvl without its .lvl next to it is used as it is
+	unsigned int sourceHash = 0;
+	bool hasSource = CompiledLevel::hashFile(lvlFileName, &sourceHash);
+
+	if (file.open(compiledFileName))
+	{
+		data = file.getData();
+		size = (int)file.getSize();
+		if (isValid() && (!hasSource || getHeader()->sourceHash == sourceHash))
+		{
+			#ifdef DEV_MODE
+			auto timeEnd = std::chrono::high_resolution_clock::now();
+			std::fprintf(stdout, "Level: '%s' loaded in %f ms\n", compiledFileName.c_str(),
+				std::chrono::duration<double, std::milli>(timeEnd - timeStart).count());
+			#endif
+			return true;
+		}
+
+		std::fprintf(stdout, "Error: File '%s' is out of date or corrupt, loading the .lvl instead\n", compiledFileName.c_str());
+		close();
+	}
+
+	if (!CompiledLevel::compile(lvlFileName, &compiled))
+	{
+		close();
+		return false;
+	}
+
+	data = &compiled[0];
+	size = (int)compiled.size();
+
+	#ifdef DEV_MODE
+	auto timeEnd = std::chrono::high_resolution_clock::now();
+	std::fprintf(stdout, "Level: '%s' compiled in %f ms\n", lvlFileName.c_str(),
+		std::chrono::duration<double, std::milli>(timeEnd - timeStart).count());
+	#endif
+
+	if (!isValid())
+	{
+		return false;
+	}
+
+	//So that the next time this level loads, it only has to be mapped
+	CompiledLevel::writeToFile(compiledFileName, &compiled);
+
+	return true;
+}
+
+void CompiledLevel::close()
+{
+	file.close();
+	compiled.clear();
+	compiled.shrink_to_fit();
+	data = nullptr;
+	size = 0;
+}
+
+const LevelHeader* CompiledLevel::getHeader()
+{
+	return (const LevelHeader*)data;
+}
+
+const char* CompiledLevel::getString(int offset)
+{
+	return data + getHeader()->strings.offset + offset;
+}
+
+unsigned int CompiledLevel::checksum(const char* bytes, int byteCount)
+{
+	//FNV-1a
+	unsigned int hash = 2166136261u;
+	for (int i = 0; i < byteCount; i++)
+	{
+		hash ^= (unsigned char)bytes[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+std::string CompiledLevel::getCompiledFileName(std::string lvlFileName)
+{
+	std::string compiledFileName = lvlFileName;
+	if (compiledFileName.size() >= 4 && compiledFileName.substr(compiledFileName.size() - 4) == ".lvl")
+	{
+		compiledFileName = compiledFileName.substr(0, compiledFileName.size() - 4);
+	}
+	return compiledFileName + ".clvl";
+}
+
+bool CompiledLevel::writeToFile(std::string compiledFileName, std::vector<char>* bytes)
+{
+	//Written under a name of its own and then renamed, so that a .clvl that another
+	// CompiledLevel has mapped never gets cut short
+	std::string tempName = compiledFileName + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+	FILE* file = nullptr;
+	int err = fopen_s(&file, tempName.c_str(), "wb");
+	if (file == nullptr || err != 0)
+	{
+		std::fprintf(stdout, "Error: Cannot write file '%s'\n", compiledFileName.c_str());
+		return false;
+	}
+
+	bool wrote = fwrite(&(*bytes)[0], sizeof(char), bytes->size(), file) == bytes->size();
+	wrote = fclose(file) == 0 && wrote;
+	if (!wrote)
+	{
+		std::fprintf(stdout, "Error: Cannot write file '%s'\n", compiledFileName.c_str());
+		std::remove(tempName.c_str());
+		return false;
+	}
+
+	//Windows won't rename over a file, so an old one has to go first
+	if (std::rename(tempName.c_str(), compiledFileName.c_str()) != 0)
+	{
+		std::remove(compiledFileName.c_str());
+		if (std::rename(tempName.c_str(), compiledFileName.c_str()) != 0)
+		{
+			std::remove(tempName.c_str());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool CompiledLevel::hashFile(std::string fileName, unsigned int* hash)
+{
+	MappedFile source;
+	if (!source.open(fileName))
+	{
+		return false;
+	}
+
+	*hash = CompiledLevel::checksum(source.getData(), (int)source.getSize());
+	return true;
+}
+
+bool CompiledLevel::isValid()
+{
+	if (data == nullptr || size < (int)sizeof(LevelHeader))
+	{
+		return false;
+	}
+
+	const LevelHeader* header = getHeader();
+	const int checkedStart = (int)offsetof(LevelHeader, checksum) + sizeof(unsigned int);
+	if (memcmp(header->fileType, "clv", 4) != 0 ||
+		header->version != CompiledLevel::VERSION ||
+		header->byteCount != size ||
+		header->checksum != CompiledLevel::checksum(data + checkedStart, size - checkedStart))
+	{
+		return false;
+	}
+
+	struct SectionSize
+	{
+		const LevelSection* section;
+		int itemSize;
+	};
+
+	SectionSize sections[] =
+	{
+		{&header->collisionChunks, (int)sizeof(LevelCollisionChunk)},
+		{&header->bgm,             (int)sizeof(LevelBGM)},
+		{&header->stagePasses,     (int)sizeof(LevelStagePass)},
+		{&header->skySpheres,      (int)sizeof(LevelSkySphere)},
+		{&header->cars,            (int)sizeof(LevelCar)},
+		{&header->boostpads,       (int)sizeof(LevelBoostpad)},
+		{&header->checkpoints,     (int)sizeof(LevelCheckpoint)},
+		{&header->jumpRamps,       (int)sizeof(LevelJumpRamp)},
+		{&header->strings,         1},
+	};
+
+	for (SectionSize& s : sections)
+	{
+		if (s.section->offset < (int)sizeof(LevelHeader) ||
+			s.section->offset % 4 != 0 ||
+			s.section->count < 0 ||
+			(long long)s.section->offset + (long long)s.section->count*s.itemSize > size)
+		{
+			return false;
+		}
+	}
+
+	//Every string has to end before the string table does
+	int stringsSize = header->strings.count;
+	if (stringsSize > 0 && data[header->strings.offset + stringsSize - 1] != 0)
+	{
+		return false;
+	}
+
+	std::vector<int> stringOffsets;
+	stringOffsets.push_back(header->modelFolder);
+	stringOffsets.push_back(header->modelFileName);
+	stringOffsets.push_back(header->collisionFolder);
+	const LevelCollisionChunk* chunks = getSection<LevelCollisionChunk>(&header->collisionChunks);
+	for (int i = 0; i < header->collisionChunks.count; i++)
+	{
+		stringOffsets.push_back(chunks[i].fileName);
+	}
+	const LevelBGM* bgm = getSection<LevelBGM>(&header->bgm);
+	for (int i = 0; i < header->bgm.count; i++)
+	{
+		stringOffsets.push_back(bgm[i].fileName);
+	}
+	const LevelStagePass* passes = getSection<LevelStagePass>(&header->stagePasses);
+	for (int i = 0; i < header->stagePasses.count; i++)
+	{
+		stringOffsets.push_back(passes[i].folder);
+		stringOffsets.push_back(passes[i].fileName);
+	}
+	const LevelSkySphere* skySpheres = getSection<LevelSkySphere>(&header->skySpheres);
+	for (int i = 0; i < header->skySpheres.count; i++)
+	{
+		stringOffsets.push_back(skySpheres[i].folder);
+		stringOffsets.push_back(skySpheres[i].objFileName);
+		stringOffsets.push_back(skySpheres[i].mtlFileName);
+	}
+
+	for (int offset : stringOffsets)
+	{
+		if (offset < 0 || offset >= stringsSize)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool CompiledLevel::compile(std::string lvlFileName, std::vector<char>* bytes)
+{
+	std::ifstream file(lvlFileName);
+	if (!file.is_open())
+	{
+		std::fprintf(stdout, "Error: Cannot load file '%s'\n", lvlFileName.c_str());
+		return false;
+	}
+
+	LevelHeader header;
+	memset(&header, 0, sizeof(LevelHeader));
+
+	std::vector<LevelCollisionChunk> collisionChunks;
+	std::vector<LevelBGM>            bgm;
+	std::vector<LevelStagePass>      stagePasses;
+	std::vector<LevelSkySphere>      skySpheres;
+	std::vector<LevelCar>            cars;
+	std::vector<LevelBoostpad>       boostpads;
+	std::vector<LevelCheckpoint>     checkpoints;
+	std::vector<LevelJumpRamp>       jumpRamps;
+	std::string strings;
+
+	auto addString = [&](std::string string) -> int
+	{
+		int offset = (int)strings.size();
+		strings += string;
+		strings += '\0';
+		return offset;
+	};
+
+	int lineNumber = 0;
+	std::string line;
+	auto readLine = [&]() -> bool
+	{
+		if (!getline(file, line))
+		{
+			line = "";
+			return false;
+		}
+		lineNumber++;
+		if (line.size() > 0 && line[line.size() - 1] == '\r')
+		{
+			line.pop_back();
+		}
+		return true;
+	};
+
+	//Reads the next line as count numbers
+	auto readNumbers = [&](float* numbers, int count) -> bool
+	{
+		if (!readLine())
+		{
+			return false;
+		}
+		std::vector<std::string> tokens = splitLine(line);
+		if ((int)tokens.size() < count)
+		{
+			return false;
+		}
+		for (int i = 0; i < count; i++)
+		{
+			numbers[i] = toFloat(tokens[i]);
+		}
+		return true;
+	};
+
+	//Run through the header content
+	bool valid = readLine();
+	header.modelFolder = addString(line);
+	valid = valid && readLine();
+	header.modelFileName = addString(line);
+	valid = valid && readLine();
+	header.collisionFolder = addString(line);
+
+	valid = valid && readLine();
+	int numChunks = toInt(line);
+	for (int i = 0; valid && i < numChunks; i++)
+	{
+		valid = readLine();
+		std::vector<std::string> tokens = splitLine(line);
+		valid = valid && tokens.size() >= 2;
+		if (valid)
+		{
+			LevelCollisionChunk chunk;
+			chunk.fileName = addString(tokens[0]);
+			chunk.quadTreeDepth = toInt(tokens[1]);
+			collisionChunks.push_back(chunk);
+		}
+	}
+
+	float camOrientation[2] = {0, 0};
+	valid = valid &&
+		readNumbers(header.sunColorDay,    3) &&
+		readNumbers(header.sunColorNight,  3) &&
+		readNumbers(header.moonColorDay,   3) &&
+		readNumbers(header.moonColorNight, 3) &&
+		readNumbers(header.fogColorDay,    3) &&
+		readNumbers(header.fogColorNight,  3) &&
+		readNumbers(&header.fogDensity,    2) &&
+		readNumbers(&header.timeOfDay,     1) &&
+		readNumbers(camOrientation,        2);
+	header.cameraYaw   = camOrientation[0];
+	header.cameraPitch = camOrientation[1];
+
+	//BGM
+	valid = valid && readLine();
+	header.bgmHasLoop = toInt(line);
+
+	valid = valid && readLine();
+	int numBGM = toInt(line);
+	for (int i = 0; valid && i < numBGM; i++)
+	{
+		valid = readLine();
+		LevelBGM track;
+		track.fileName = addString(line);
+		bgm.push_back(track);
+	}
+
+	//Finish the level positions and cam settings
+	float finishCamVars[2] = {0, 0};
+	valid = valid &&
+		readNumbers(header.finishPosition, 3) &&
+		readNumbers(finishCamVars, 2) &&
+		readNumbers(&header.deathHeight, 1);
+	header.finishRotY        = finishCamVars[0];
+	header.finishCameraPitch = finishCamVars[1];
+
+	if (!valid)
+	{
+		std::fprintf(stdout, "Error: Line %d of '%s' is missing or incomplete\n", lineNumber + 1, lvlFileName.c_str());
+		return false;
+	}
+
+	//Now read through all the objects defined in the file
+	while (readLine())
+	{
+		std::vector<std::string> dat = splitLine(line);
+		if (dat.size() == 0 || dat[0][0] == '#')
+		{
+			continue;
+		}
+
+		int id = toInt(dat[0]);
+		int needed = 1;
+		switch (id)
+		{
+			case 2:  needed = 3;  break; //Stage Pass 2
+			case 3:  needed = 3;  break; //Stage Pass 3
+			case 4:  needed = 3;  break; //Stage Transparent
+			case 6:  needed = 4;  break; //Car
+			case 7:  needed = 6;  break; //Sky Sphere
+			case 8:  needed = 10; break; //Boostpad
+			case 9:  needed = 1;  break; //RR_BackgroundStars
+			case 10: needed = 9;  break; //Checkpoint
+			case 11: needed = 5;  break; //JumpPad
+			default: continue;
+		}
+
+		if ((int)dat.size() < needed)
+		{
+			std::fprintf(stdout, "Error: Line %d of '%s' needs %d values\n", lineNumber, lvlFileName.c_str(), needed);
+			return false;
+		}
+
+		switch (id)
+		{
+			case 2:
+			case 3:
+			case 4:
+			{
+				LevelStagePass pass;
+				pass.pass = id;
+				pass.folder = addString(dat[1]);
+				pass.fileName = addString(dat[2]);
+				stagePasses.push_back(pass);
+				break;
+			}
+
+			case 6:
+			{
+				LevelCar car;
+				car.x = toFloat(dat[1]);
+				car.y = toFloat(dat[2]);
+				car.z = toFloat(dat[3]);
+				cars.push_back(car);
+				break;
+			}
+
+			case 7:
+			{
+				LevelSkySphere sky;
+				sky.folder = addString(dat[1]);
+				sky.objFileName = addString(dat[2]);
+				sky.mtlFileName = addString(dat[3]);
+				sky.scale = toFloat(dat[4]);
+				sky.followsY = toInt(dat[5]);
+				skySpheres.push_back(sky);
+				break;
+			}
+
+			case 8:
+			{
+				float f[9];
+				for (int i = 0; i < 9; i++)
+				{
+					f[i] = toFloat(dat[i + 1]);
+				}
+				LevelBoostpad pad = {f[0], f[1], f[2], f[3], f[4], f[5], f[6], f[7], f[8]};
+				boostpads.push_back(pad);
+				break;
+			}
+
+			case 9:
+			{
+				header.backgroundStarsCount++;
+				break;
+			}
+
+			case 10:
+			{
+				LevelCheckpoint checkpoint;
+				checkpoint.rotationY = toFloat(dat[1]);
+				checkpoint.x         = toFloat(dat[2]);
+				checkpoint.y         = toFloat(dat[3]);
+				checkpoint.z         = toFloat(dat[4]);
+				checkpoint.scaleX    = toFloat(dat[5]);
+				checkpoint.scaleY    = toFloat(dat[6]);
+				checkpoint.scaleZ    = toFloat(dat[7]);
+				checkpoint.number    = toInt(dat[8]);
+				checkpoints.push_back(checkpoint);
+				break;
+			}
+
+			case 11:
+			{
+				LevelJumpRamp ramp;
+				ramp.x    = toFloat(dat[1]);
+				ramp.y    = toFloat(dat[2]);
+				ramp.z    = toFloat(dat[3]);
+				ramp.yRot = toFloat(dat[4]);
+				jumpRamps.push_back(ramp);
+				break;
+			}
+
+			default:
+				break;
+		}
+	}
+
+	//The string table goes last, since it is the only section that isn't a multiple of 4 bytes
+	bytes->assign(sizeof(LevelHeader), 0);
+	writeSection(&collisionChunks, &header.collisionChunks, bytes);
+	writeSection(&bgm,             &header.bgm,             bytes);
+	writeSection(&stagePasses,     &header.stagePasses,     bytes);
+	writeSection(&skySpheres,      &header.skySpheres,      bytes);
+	writeSection(&cars,            &header.cars,            bytes);
+	writeSection(&boostpads,       &header.boostpads,       bytes);
+	writeSection(&checkpoints,     &header.checkpoints,     bytes);
+	writeSection(&jumpRamps,       &header.jumpRamps,       bytes);
+	header.strings.offset = (int)bytes->size();
+	header.strings.count = (int)strings.size();
+	bytes->insert(bytes->end(), strings.begin(), strings.end());
+
+	memcpy(header.fileType, "clv", 4);
+	header.version = CompiledLevel::VERSION;
+	header.byteCount = (int)bytes->size();
+	CompiledLevel::hashFile(lvlFileName, &header.sourceHash);
+	memcpy(&(*bytes)[0], &header, sizeof(LevelHeader));
+
+	const int checkedStart = (int)offsetof(LevelHeader, checksum) + sizeof(unsigned int);
+	header.checksum = CompiledLevel::checksum(&(*bytes)[checkedStart], header.byteCount - checkedStart);
+	memcpy(&(*bytes)[0], &header, sizeof(LevelHeader));
+
+	return true;
+}
+
+int CompiledLevel::compileToFile(std::string lvlFileName)
+{
+	std::vector<char> bytes;
+	if (!CompiledLevel::compile(lvlFileName, &bytes))
+	{
+		return -1;
+	}
+
+	if (!CompiledLevel::writeToFile(CompiledLevel::getCompiledFileName(lvlFileName), &bytes))
+	{
+		return -1;
+	}
+
+	return 0;
+}
\ No newline at end of file
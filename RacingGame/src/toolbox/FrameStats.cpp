@@ -0,0 +1,50 @@
+#include <vector>
+
+#include "framestats.h"
+
+FrameStats::FrameStats()
+{
+	frames = 0;
+}
+
+void FrameStats::add(int index, double value)
+{
+	if (index >= (int)totals.size())
+	{
+		totals.resize(index + 1, 0.0);
+	}
+	totals[index] += value;
+}
+
+bool FrameStats::endFrame()
+{
+	frames++;
+	if (frames < FRAME_COUNT)
+	{
+		return false;
+	}
+
+	averages.resize(totals.size());
+	for (int i = 0; i < (int)totals.size(); i++)
+	{
+		averages[i] = totals[i]/frames;
+		totals[i] = 0.0;
+	}
+	frames = 0;
+	return true;
+}
+
+double FrameStats::getAverage(int index)
+{
+	if (index >= (int)averages.size())
+	{
+		return 0.0;
+	}
+	return averages[index];
+}
+
+void FrameStats::reset()
+{
+	frames = 0;
+	totals.assign(totals.size(), 0.0);
+}
\ No newline at end of file
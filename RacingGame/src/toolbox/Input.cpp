@@ -13,6 +13,8 @@
 #include "../engineTester/main.h"
 #include "../entities/camera.h"
 #include "../entities/car.h"
+#include "../particles/particlemaster.h"
+#include "../fontRendering/textmaster.h"
 #include "maths.h"
 #include "../toolbox/split.h"
 #include <random>
@@ -233,6 +235,22 @@ void Input::pollInputs()
 			//Global::gamePlayer->goUp();
 		}
 	}
+
+	static bool previousStressTestKey = false;
+	bool stressTestKey = (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS);
+	if (stressTestKey && !previousStressTestKey)
+	{
+		ParticleMaster::toggleStressTest();
+	}
+	previousStressTestKey = stressTestKey;
+
+	static bool previousLayoutBenchmarkKey = false;
+	bool layoutBenchmarkKey = (glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS);
+	if (layoutBenchmarkKey && !previousLayoutBenchmarkKey)
+	{
+		TextMaster::benchmarkLayout();
+	}
+	previousLayoutBenchmarkKey = layoutBenchmarkKey;
 	#endif
 
 
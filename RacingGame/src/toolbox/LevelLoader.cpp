@@ -11,6 +11,7 @@
 #include <GLFW/glfw3.h>
 
 #include "levelloader.h"
+#include "backgroundloader.h"
 #include "../engineTester/main.h"
 #include "../entities/stage.h"
 #include "../entities/stagepass2.h"
@@ -25,7 +26,6 @@
 #include "../renderEngine/skymanager.h"
 #include "../toolbox/mainmenu.h"
 #include "split.h"
-#include "input.h"
 #include "../entities/car.h"
 #include "../entities/boostpad.h"
 #include "../entities/camera.h"
@@ -33,6 +33,9 @@
 #include "../entities/checkpoint.h"
 #include "../entities/jumpramp.h"
 
+CompiledLevel LevelLoader::level;
+int LevelLoader::bgmHasLoop = 0;
+
 void LevelLoader::loadTitle()
 {
 	Stage::deleteModels();
@@ -61,7 +64,7 @@ void LevelLoader::loadTitle()
 	Global::gameCheckpointList.clear();
 
 	AudioPlayer::stopBGM();
-	AudioPlayer::deleteBuffersBGM();
+	AudioPlayer::clearBGM();
 
 	//Global::gameSkySphere->setVisible(false);
 
@@ -166,11 +169,9 @@ void LevelLoader::loadLevel(std::string levelFilename)
 		StageTransparent::deleteStaticModels();
 	}
 
-	std::ifstream file("res/Levels/" + fname);
-	if (!file.is_open())
+	if (!LevelLoader::level.open("res/Levels/" + fname))
 	{
 		std::fprintf(stdout, "Error: Cannot load file '%s'\n", ("res/Levels/" + fname).c_str());
-		file.close();
 		return;
 	}
 
@@ -178,257 +179,201 @@ void LevelLoader::loadLevel(std::string levelFilename)
 	//Delete existing bgm if loading a new stage
 	if (stageFault == 1)
 	{
-		AudioPlayer::deleteBuffersBGM();
+		AudioPlayer::clearBGM();
+		CollisionChecker::deleteAllCollideModels();
+	}
+	else //Keep the same quad tree collision
+	{
+		CollisionChecker::deleteAllCollideModelsExceptQuadTrees();
 	}
 
 	Global::stageUsesWater = false;
 
-	//Run through the header content
-
-	std::string modelFLoc;
-	getline(file, modelFLoc);
-
-	std::string modelFName;
-	getline(file, modelFName);
-
-	std::string colFLoc;
-	getline(file, colFLoc);
+	//The rest happens on a worker thread while the title card stays up
+	Global::gameState = STATE_LOADING;
+	BackgroundLoader::start([stageFault]()
+	{
+		LevelLoader::loadLevelFiles(stageFault);
+	});
+}
 
-	std::string numChunksLine;
-	getline(file, numChunksLine);
+void LevelLoader::updateLoading()
+{
+	if (BackgroundLoader::update(LevelLoader::UPLOAD_MILLISECONDS_PER_FRAME))
+	{
+		LevelLoader::finishLoading();
+	}
+}
 
-	int numChunks = stoi(numChunksLine);
+void LevelLoader::loadLevelFiles(int stageFault)
+{
+	CompiledLevel* level = &LevelLoader::level;
+	const LevelHeader* header = level->getHeader();
 
 	if (stageFault == 1) //We need to load in new collision
 	{
-		CollisionChecker::deleteAllCollideModels();
-
-		while (numChunks > 0)
+		std::string colFLoc = level->getString(header->collisionFolder);
+		const LevelCollisionChunk* chunks = level->getSection<LevelCollisionChunk>(&header->collisionChunks);
+		for (int i = 0; i < header->collisionChunks.count; i++)
 		{
-			std::string line;
-			getline(file, line);
+			CollisionModel* colModel = loadBinaryCollisionModel("Models/" + colFLoc + "/", level->getString(chunks[i].fileName));
+			colModel->generateQuadTree(chunks[i].quadTreeDepth);
+			CollisionChecker::addCollideModel(colModel);
+		}
+	}
 
-			char lineBuf[128];
-			memcpy(lineBuf, line.c_str(), line.size()+1);
+	Vector3f newSunColourDay(header->sunColorDay[0], header->sunColorDay[1], header->sunColorDay[2]);
+	SkyManager::setSunColorDay(&newSunColourDay);
 
-			int splitLength = 0;
-			char** lineSplit = split(lineBuf, ' ', &splitLength);
+	Vector3f newSunColourNight(header->sunColorNight[0], header->sunColorNight[1], header->sunColorNight[2]);
+	SkyManager::setSunColorNight(&newSunColourNight);
 
+	Vector3f newMoonColourDay(header->moonColorDay[0], header->moonColorDay[1], header->moonColorDay[2]);
+	SkyManager::setMoonColorDay(&newMoonColourDay);
 
+	Vector3f newMoonColourNight(header->moonColorNight[0], header->moonColorNight[1], header->moonColorNight[2]);
+	SkyManager::setMoonColorNight(&newMoonColourNight);
 
-			CollisionModel* colModel = loadBinaryCollisionModel("Models/" + colFLoc + "/", lineSplit[0]);
-			colModel->generateQuadTree(std::stoi(lineSplit[1]));
-			CollisionChecker::addCollideModel(colModel);
+	Vector3f fogDay(header->fogColorDay[0], header->fogColorDay[1], header->fogColorDay[2]);
+	Vector3f fogNight(header->fogColorNight[0], header->fogColorNight[1], header->fogColorNight[2]);
+	SkyManager::setFogColours(&fogDay, &fogNight);
 
-			numChunks--;
+	SkyManager::setFogVars(header->fogDensity, header->fogGradient);
 
-			free(lineSplit);
-		}
-	}
-	else //Keep the same quad tree collision
+	if (stageFault == 1)
 	{
-		CollisionChecker::deleteAllCollideModelsExceptQuadTrees();
-
-		while (numChunks > 0)
-		{
-			std::string line;
-			getline(file, line);
-
-			numChunks--;
-		}
+		SkyManager::setTimeOfDay(header->timeOfDay);
 	}
 
-	std::string sunColorDay;
-	getline(file, sunColorDay);
-	{
-		char lineBuf[128];
-		memcpy(lineBuf, sunColorDay.c_str(), sunColorDay.size()+1);
-		int splitLength = 0;
-		char** dat = split(lineBuf, ' ', &splitLength);
+	//Global::gameSkySphere->setVisible(false);
 
-		Vector3f newSunColour(toFloat(dat[0]), toFloat(dat[1]), toFloat(dat[2]));
-		SkyManager::setSunColorDay(&newSunColour);
+	//Global::gameCamera->setYaw(header->cameraYaw);
+	//Global::gameCamera->setPitch(header->cameraPitch);
 
-		free(dat);
-	}
+	//Read in BGM
+	LevelLoader::bgmHasLoop = header->bgmHasLoop;
 
-	std::string sunColorNight;
-	getline(file, sunColorNight);
+	if (stageFault == 1)
 	{
-		char lineBuf[128];
-		memcpy(lineBuf, sunColorNight.c_str(), sunColorNight.size()+1);
-		int splitLength = 0;
-		char** dat = split(lineBuf, ' ', &splitLength);
+		const LevelBGM* bgm = level->getSection<LevelBGM>(&header->bgm);
+		for (int i = 0; i < header->bgm.count; i++)
+		{
+			AudioPlayer::loadBGM((char*)level->getString(bgm[i].fileName));
+		}
+	}
 
-		Vector3f newSunColour(toFloat(dat[0]), toFloat(dat[1]), toFloat(dat[2]));
-		SkyManager::setSunColorNight(&newSunColour);
+	//Finish the level positions and cam settings
+	Global::gameStage->finishPlayerPosition.x = header->finishPosition[0];
+	Global::gameStage->finishPlayerPosition.y = header->finishPosition[1];
+	Global::gameStage->finishPlayerPosition.z = header->finishPosition[2];
+	Global::gameStage->finishPlayerRotY  = header->finishRotY;
+	Global::gameStage->finishCameraPitch = header->finishCameraPitch;
 
-		free(dat);
-	}
+	//Global death height
+	Global::deathHeight = header->deathHeight;
 
-	std::string moonColorDay;
-	getline(file, moonColorDay);
+	//Now create all the objects defined in the file
+	const LevelStagePass* passes = level->getSection<LevelStagePass>(&header->stagePasses);
+	for (int i = 0; i < header->stagePasses.count; i++)
 	{
-		char lineBuf[128];
-		memcpy(lineBuf, moonColorDay.c_str(), moonColorDay.size()+1);
-		int splitLength = 0;
-		char** dat = split(lineBuf, ' ', &splitLength);
+		const char* folder = level->getString(passes[i].folder);
+		const char* fileName = level->getString(passes[i].fileName);
+		switch (passes[i].pass)
+		{
+			case 2:
+			{
+				StagePass2* pass2 = new StagePass2(folder, fileName); INCR_NEW
+				Main_addEntityPass2(pass2);
+				break;
+			}
 
-		Vector3f newMoonColour(toFloat(dat[0]), toFloat(dat[1]), toFloat(dat[2]));
-		SkyManager::setMoonColorDay(&newMoonColour);
+			case 3:
+			{
+				StagePass3* pass3 = new StagePass3(folder, fileName); INCR_NEW
+				Main_addEntityPass3(pass3);
+				break;
+			}
 
-		free(dat);
+			default:
+			{
+				StageTransparent* trans = new StageTransparent(folder, fileName); INCR_NEW
+				Main_addTransparentEntity(trans);
+				break;
+			}
+		}
 	}
 
-	std::string moonColorNight;
-	getline(file, moonColorNight);
+	const LevelSkySphere* skySpheres = level->getSection<LevelSkySphere>(&header->skySpheres);
+	for (int i = 0; i < header->skySpheres.count; i++)
 	{
-		char lineBuf[128];
-		memcpy(lineBuf, moonColorNight.c_str(), moonColorNight.size()+1);
-		int splitLength = 0;
-		char** dat = split(lineBuf, ' ', &splitLength);
-
-		Vector3f newMoonColour(toFloat(dat[0]), toFloat(dat[1]), toFloat(dat[2]));
-		SkyManager::setMoonColorNight(&newMoonColour);
-
-		free(dat);
+		SkySphere::loadModels(
+			(char*)level->getString(skySpheres[i].folder),
+			(char*)level->getString(skySpheres[i].objFileName),
+			(char*)level->getString(skySpheres[i].mtlFileName));
+		Global::gameSkySphere->setScale(skySpheres[i].scale);
+		Global::gameSkySphere->setFollowsY(skySpheres[i].followsY != 0);
+		Global::gameSkySphere->setVisible(true);
 	}
 
-
-	Vector3f fogDay;
-	Vector3f fogNight;
-
-	std::string fogColorDay;
-	getline(file, fogColorDay);
+	const LevelCar* cars = level->getSection<LevelCar>(&header->cars);
+	for (int i = 0; i < header->cars.count; i++)
 	{
-		char lineBuf[128];
-		memcpy(lineBuf, fogColorDay.c_str(), fogColorDay.size()+1);
-		int splitLength = 0;
-		char** dat = split(lineBuf, ' ', &splitLength);
-
-		fogDay.set(toFloat(dat[0]), toFloat(dat[1]), toFloat(dat[2]));
-
-		free(dat);
+		Car* car = new Car(MainMenu::characterSelectIndex, cars[i].x, cars[i].y, cars[i].z, 0, 0, -1); INCR_NEW
+		Global::gameMainVehicle = car;
+		Main_addEntity(car);
 	}
 
-	std::string fogColorNight;
-	getline(file, fogColorNight);
+	const LevelBoostpad* boostpads = level->getSection<LevelBoostpad>(&header->boostpads);
+	for (int i = 0; i < header->boostpads.count; i++)
 	{
-		char lineBuf[128];
-		memcpy(lineBuf, fogColorNight.c_str(), fogColorNight.size()+1);
-		int splitLength = 0;
-		char** dat = split(lineBuf, ' ', &splitLength);
-
-		fogNight.set(toFloat(dat[0]), toFloat(dat[1]), toFloat(dat[2]));
-
-		free(dat);
+		const LevelBoostpad* p = &boostpads[i];
+		Boostpad::loadStaticModels();
+		Boostpad* pad = new Boostpad(
+			p->x,     p->y,     p->z,
+			p->normX, p->normY, p->normZ,
+			p->atX,   p->atY,   p->atZ); INCR_NEW
+		Main_addTransparentEntity(pad);
 	}
 
-	SkyManager::setFogColours(&fogDay, &fogNight);
-
-	std::string fogVars;
-	getline(file, fogVars);
+	for (int i = 0; i < header->backgroundStarsCount; i++)
 	{
-		char lineBuf[128];
-		memcpy(lineBuf, fogVars.c_str(), fogVars.size()+1);
-		int splitLength = 0;
-		char** dat = split(lineBuf, ' ', &splitLength);
-
-		SkyManager::setFogVars(toFloat(dat[0]), toFloat(dat[1]));
-
-		free(dat);
+		RR_BackgroundStars::loadModels();
+		RR_BackgroundStars* stars = new RR_BackgroundStars; INCR_NEW
+		Main_addEntity(stars);
 	}
 
-	std::string timeOfDay;
-	getline(file, timeOfDay);
-	if (stageFault == 1)
+	const LevelCheckpoint* checkpoints = level->getSection<LevelCheckpoint>(&header->checkpoints);
+	for (int i = 0; i < header->checkpoints.count; i++)
 	{
-		char lineBuf[128];
-		memcpy(lineBuf, timeOfDay.c_str(), timeOfDay.size()+1);
-		int splitLength = 0;
-		char** dat = split(lineBuf, ' ', &splitLength);
-
-		SkyManager::setTimeOfDay(toFloat(dat[0]));
-
-		free(dat);
+		const LevelCheckpoint* c = &checkpoints[i];
+		Checkpoint::loadStaticModels();
+		Checkpoint* checkpoint = new Checkpoint(
+			c->rotationY,
+			c->x, c->y, c->z,
+			c->scaleX, c->scaleY, c->scaleZ,
+			c->number); INCR_NEW
+		Global::gameCheckpointList.push_back(checkpoint);
 	}
 
-	//Global::gameSkySphere->setVisible(false);
-
-
-	std::string camOrientation;
-	getline(file, camOrientation);
+	const LevelJumpRamp* jumpRamps = level->getSection<LevelJumpRamp>(&header->jumpRamps);
+	for (int i = 0; i < header->jumpRamps.count; i++)
 	{
-		char lineBuf[128];
-		memcpy(lineBuf, camOrientation.c_str(), camOrientation.size()+1);
-		int splitLength = 0;
-		char** dat = split(lineBuf, ' ', &splitLength);
-
-		//Global::gameCamera->setYaw(toFloat(dat[0]));
-		//Global::gameCamera->setPitch(toFloat(dat[1]));
-
-		free(dat);
+		const LevelJumpRamp* r = &jumpRamps[i];
+		JumpRamp::loadStaticModels();
+		JumpRamp* ramp = new JumpRamp(r->x, r->y, r->z, r->yRot); INCR_NEW
+		Main_addTransparentEntity(ramp);
 	}
 
-
-
-
-	//Read in BGM
-
-	std::string bgmHasLoopLine;
-	getline(file, bgmHasLoopLine);
-
-	int bgmHasLoop = stoi(bgmHasLoopLine);
-
-
-	std::string numBGMLine;
-	getline(file, numBGMLine);
-
-	int numBGM = stoi(numBGMLine);
-
-	while (numBGM > 0)
+	if (stageFault == 1)
 	{
-		std::string line;
-		getline(file, line);
-
-		char* bgmFileName = (char*)line.c_str();
-
-		if (stageFault == 1)
-		{
-			AudioPlayer::loadBGM(bgmFileName);
-		}
-
-		numBGM--;
+		Stage::loadModels((char*)level->getString(header->modelFolder), (char*)level->getString(header->modelFileName));
 	}
 
+	level->close();
+}
 
-	//Finish the level positions and cam settings
-	char finishBuf[512];
-
-	std::string finishPosition;
-	getline(file, finishPosition);
-	memcpy(finishBuf, finishPosition.c_str(), finishPosition.size()+1);
-	int finishLength = 0;
-	char** finishSplit = split(finishBuf, ' ', &finishLength);
-	Global::gameStage->finishPlayerPosition.x = toFloat(finishSplit[0]);
-	Global::gameStage->finishPlayerPosition.y = toFloat(finishSplit[1]);
-	Global::gameStage->finishPlayerPosition.z = toFloat(finishSplit[2]);
-	free(finishSplit);
-
-	std::string finishCamVars;
-	getline(file, finishCamVars);
-	memcpy(finishBuf, finishCamVars.c_str(), finishCamVars.size()+1);
-	finishSplit = split(finishBuf, ' ', &finishLength);
-	Global::gameStage->finishPlayerRotY  = toFloat(finishSplit[0]);
-	Global::gameStage->finishCameraPitch = toFloat(finishSplit[1]);
-	free(finishSplit);
-
-	//Global death height
-	std::string deathHeightLine;
-	getline(file, deathHeightLine);
-
-	Global::deathHeight = stof(deathHeightLine);
-
+void LevelLoader::finishLoading()
+{
 	GuiManager::clearGuisToRender();
 
 	Global::gameIsNormalMode = false;
@@ -449,35 +394,6 @@ void LevelLoader::loadLevel(std::string levelFilename)
 		Global::gameRingTarget = std::stoi((currentLevel->missionData[Global::gameMissionNumber])[2]);
 	}
 
-	//Now read through all the objects defined in the file
-
-	std::string line;
-
-	while (!file.eof())
-	{
-		getline(file, line);
-
-		char lineBuf[512]; //Buffer to copy line into
-		memcpy(lineBuf, line.c_str(), line.size()+1);
-
-		int splitLength = 0;
-		char** lineSplit = split(lineBuf, ' ', &splitLength);
-
-		if (splitLength > 0)
-		{
-			Input::pollInputs();
-
-			processLine(lineSplit, splitLength);
-		}
-		free(lineSplit);
-	}
-	file.close();
-
-	if (stageFault == 1)
-	{
-		Stage::loadModels((char*)modelFLoc.c_str(), (char*)modelFName.c_str());
-	}
-
 	if (Global::gameMainVehicle != nullptr)
 	{
 		//Global::gamePlayer->setCanMoveTimer(60);
@@ -519,7 +435,7 @@ void LevelLoader::loadLevel(std::string levelFilename)
 	}
 	else
 	{
-		if (bgmHasLoop != 0)
+		if (LevelLoader::bgmHasLoop != 0)
 		{
 			//By default, first 2 buffers are the intro and loop, respectively
 			//AudioPlayer::playBGMWithIntro(0, 1);
@@ -536,7 +452,7 @@ void LevelLoader::loadLevel(std::string levelFilename)
 	Global::finishStageTimer = -1;
 
 	Vector3f partVel(0, 0, 0);
-	//new Particle(ParticleResources::textureBlackFade, Global::gameCamera->getFadePosition1(), &partVel, 0, 60, 0, 400, 0, true);
+	//ParticleMaster::createParticle(ParticleResources::textureBlackFade, Global::gameCamera->getFadePosition1(), &partVel, 0, 60, 0, 400, 0, true);
 
 	Global::gameState = STATE_RUNNING;
 
@@ -546,102 +462,6 @@ void LevelLoader::loadLevel(std::string levelFilename)
 }
 
 
-void LevelLoader::processLine(char** dat, int /*datLength*/)
-{
-	if (dat[0][0] == '#')
-	{
-		return;
-	}
-
-	int id = std::stoi(dat[0]);
-
-	switch (id)
-	{
-		case 2: //Stage Pass 2
-		{
-			StagePass2* pass2 = new StagePass2(dat[1], dat[2]); INCR_NEW
-			Main_addEntityPass2(pass2);
-			return;
-		}
-
-		case 3: //Stage Pass 3
-		{
-			StagePass3* pass3 = new StagePass3(dat[1], dat[2]); INCR_NEW
-			Main_addEntityPass3(pass3);
-			return;
-		}
-
-		case 4: //Stage Transparent
-		{
-			StageTransparent* trans = new StageTransparent(dat[1], dat[2]); INCR_NEW
-			Main_addTransparentEntity(trans);
-			return;
-		}
-
-		case 6: //Car
-		{
-			Car* car = new Car(MainMenu::characterSelectIndex, toFloat(dat[1]), toFloat(dat[2]), toFloat(dat[3]), 0, 0, -1); INCR_NEW
-			Global::gameMainVehicle = car;
-			Main_addEntity(car);
-			return;
-		}
-
-		case 7: //Sky Sphere
-		{
-			SkySphere::loadModels(dat[1], dat[2], dat[3]);
-			Global::gameSkySphere->setScale(toFloat(dat[4]));
-			Global::gameSkySphere->setFollowsY((bool)toInt(dat[5]));
-			Global::gameSkySphere->setVisible(true);
-			return;
-		}
-
-		case 8: //Boostpad
-		{
-			Boostpad::loadStaticModels();
-			Boostpad* pad = new Boostpad(
-				toFloat(dat[1]), toFloat(dat[2]), toFloat(dat[3]),
-				toFloat(dat[4]), toFloat(dat[5]), toFloat(dat[6]),
-				toFloat(dat[7]), toFloat(dat[8]), toFloat(dat[9])); INCR_NEW
-			Main_addTransparentEntity(pad);
-			return;
-		}
-
-		case 9: //RR_BackgroundStars
-		{
-			RR_BackgroundStars::loadModels();
-			RR_BackgroundStars* stars = new RR_BackgroundStars; INCR_NEW
-			Main_addEntity(stars);
-			return;
-		}
-
-		case 10: //Checkpoint
-		{
-			Checkpoint::loadStaticModels();
-			Checkpoint* checkpoint = new Checkpoint(
-				toFloat(dat[1]), toFloat(dat[2]), toFloat(dat[3]),
-				toFloat(dat[4]), toFloat(dat[5]), toFloat(dat[6]),
-				toFloat(dat[7]), toInt(dat[8])); INCR_NEW
-			Global::gameCheckpointList.push_back(checkpoint);
-			return;
-		}
-
-		case 11: //JumpPad
-		{
-			JumpRamp::loadStaticModels();
-			JumpRamp* ramp = new JumpRamp(
-				toFloat(dat[1]), toFloat(dat[2]), toFloat(dat[3]),
-				toFloat(dat[4])); INCR_NEW
-			Main_addTransparentEntity(ramp);
-			return;
-		}
-
-		default:
-		{
-			return;
-		}
-	}
-}
-
 void LevelLoader::loadLevelData()
 {
 	Global::gameLevelData.clear();
@@ -709,16 +529,6 @@ void LevelLoader::loadLevelData()
 	}
 }
 
-float LevelLoader::toFloat(char* input)
-{
-	return std::stof(input);
-}
-
-int LevelLoader::toInt(char* input)
-{
-	return std::stoi(input);
-}
-
 void LevelLoader::freeAllStaticModels()
 {
 	SkySphere::deleteModels();
@@ -12,7 +12,6 @@
 #include "../fontMeshCreator/guitext.h"
 #include "../audio/audioplayer.h"
 #include "../audio/source.h"
-#include "../particles/particle.h"
 #include "../particles/particleresources.h"
 #include "../particles/particletexture.h"
 #include "../entities/camera.h"
@@ -20,6 +19,7 @@
 #include "../guis/guitextureresources.h"
 #include "../guis/guimanager.h"
 #include "../guis/guitexture.h"
+#include "resourcemanager.h"
 
 int MainMenu::menuSelectionID = 0;
 
@@ -127,7 +127,7 @@ FontType* MainMenu::font = nullptr;
 
 void MainMenu::init()
 {
-	font = new FontType(Loader::loadTexture("res/Fonts/vipnagorgialla.png"), "res/Fonts/vipnagorgialla.fnt"); INCR_NEW
+	font = new FontType(ResourceManager::loadTexture("res/Fonts/vipnagorgialla.png"), "res/Fonts/vipnagorgialla.fnt"); INCR_NEW
 
 	MainMenu::titleCardTextTimer = 0;
 
@@ -1119,7 +1119,7 @@ void MainMenu::createTitleCard()
 	ParticleMaster::deleteAllParticles();
 
 	Vector3f vel(0,0,0);
-	new Particle(ParticleResources::textureBlackFade, Global::gameCamera->getFadePosition1(), &vel, 0, 1.0f, 0.0f,  50.0f, 0, true, false);
+	ParticleMaster::createParticle(ParticleResources::textureBlackFade, Global::gameCamera->getFadePosition1(), &vel, 0, 1.0f, 0.0f,  50.0f, 0, true, false);
 	GuiManager::addGuiToRender(GuiTextureResources::textureBlueLine);
 
 
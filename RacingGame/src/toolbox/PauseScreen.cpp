@@ -12,13 +12,13 @@
 #include "../fontMeshCreator/guitext.h"
 #include "../audio/audioplayer.h"
 #include "../audio/source.h"
-#include "../particles/particle.h"
 #include "../particles/particleresources.h"
 #include "../particles/particletexture.h"
 #include "../entities/camera.h"
 #include "../particles/particlemaster.h"
 #include "../guis/guitextureresources.h"
 #include "../guis/guimanager.h"
+#include "resourcemanager.h"
 
 int PauseScreen::menuSelection = 0;
 int PauseScreen::menuSelectionMAX = 3;
@@ -42,7 +42,7 @@ bool PauseScreen::pausedSounds[14];
 
 void PauseScreen::init()
 {
-	font = new FontType(Loader::loadTexture("res/Fonts/vipnagorgialla.png"), "res/Fonts/vipnagorgialla.fnt"); INCR_NEW
+	font = new FontType(ResourceManager::loadTexture("res/Fonts/vipnagorgialla.png"), "res/Fonts/vipnagorgialla.fnt"); INCR_NEW
 	textCursor = new GUIText(">", 2.5f, font, 0.47f, 0.25f, 1.0f, false, false, false); INCR_NEW
 	isPaused = false;
 }
@@ -98,7 +98,7 @@ void PauseScreen::step()
 					{
 						Global::shouldLoadLevel = true;
 						Vector3f vel(0,0,0);
-						new Particle(ParticleResources::textureBlackFade, Global::gameCamera->getFadePosition1(), &vel, 0, 1.0f, 0.0f, 50.0f, 0, 1.0f, 0, true, false);
+						ParticleMaster::createParticle(ParticleResources::textureBlackFade, Global::gameCamera->getFadePosition1(), &vel, 0, 1.0f, 0.0f, 50.0f, 0, 1.0f, 0, true, false);
 						unpause(false);
 						Global::gameState = STATE_CUTSCENE;
 					}
@@ -128,7 +128,7 @@ void PauseScreen::step()
 				case 3:
 				{
 					Vector3f vel(0,0,0);
-					new Particle(ParticleResources::textureBlackFade, Global::gameCamera->getFadePosition1(), &vel, 0, 1.0f, 0.0f, 50.0f, 0, 1.0f, 0, true, false);
+					ParticleMaster::createParticle(ParticleResources::textureBlackFade, Global::gameCamera->getFadePosition1(), &vel, 0, 1.0f, 0.0f, 50.0f, 0, 1.0f, 0, true, false);
 					unpause(false);
 					LevelLoader::loadTitle();
 					break;
@@ -0,0 +1,71 @@
+#include <vector>
+#include <cstring>
+
+#include "radixsort.h"
+
+//LSD radix sort, 8 bits at a time. All 8 histograms are built in one pass
+// over the keys, and any byte that is the same for every key is skipped,
+// so small keys (like a 16 bit depth) only cost as many passes as they need.
+void RadixSort::sort(std::vector<RadixSortItem>* items, std::vector<RadixSortItem>* scratch)
+{
+	const size_t count = items->size();
+	if (count < 2)
+	{
+		return;
+	}
+
+	if (scratch->size() < count)
+	{
+		scratch->resize(count);
+	}
+
+	unsigned int histograms[8][256];
+	memset(histograms, 0, sizeof(histograms));
+
+	RadixSortItem* src = &(*items)[0];
+	RadixSortItem* dst = &(*scratch)[0];
+
+	for (size_t i = 0; i < count; i++)
+	{
+		unsigned long long key = src[i].key;
+		for (int b = 0; b < 8; b++)
+		{
+			histograms[b][(key >> (b*8)) & 0xFF]++;
+		}
+	}
+
+	for (int b = 0; b < 8; b++)
+	{
+		unsigned int* histogram = histograms[b];
+
+		//every key has the same value in this byte, nothing to do
+		if (histogram[(src[0].key >> (b*8)) & 0xFF] == count)
+		{
+			continue;
+		}
+
+		unsigned int offset = 0;
+		for (int d = 0; d < 256; d++)
+		{
+			unsigned int amount = histogram[d];
+			histogram[d] = offset;
+			offset += amount;
+		}
+
+		const int shift = b*8;
+		for (size_t i = 0; i < count; i++)
+		{
+			dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+		}
+
+		RadixSortItem* temp = src;
+		src = dst;
+		dst = temp;
+	}
+
+	//odd number of passes leaves the result in the scratch buffer
+	if (src != &(*items)[0])
+	{
+		memcpy(&(*items)[0], src, count*sizeof(RadixSortItem));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include <glad/glad.h>
+
+#include <list>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cctype>
+#include <cstdio>
+
+#include "resourcemanager.h"
+#include "../engineTester/main.h"
+#include "../models/models.h"
+#include "../objLoader/objLoader.h"
+#include "../renderEngine/renderEngine.h"
+
+std::unordered_map<std::string, ResourceManager::Resource*> ResourceManager::resources;
+std::list<ResourceManager::Resource*> ResourceManager::unusedResources;
+
+long long ResourceManager::totalBytes = 0;
+long long ResourceManager::memoryBudget = 512LL*1024*1024;
+
+int ResourceManager::loadModel(std::list<TexturedModel*>* models, std::string filePath, std::string fileName)
+{
+	std::string path = canonicalPath(filePath + fileName);
+	Resource* resource = ResourceManager::acquire(path);
+	if (resource == nullptr)
+	{
+		std::list<TexturedModel*> loaded;
+		long long bytesBefore = Loader::getBytesUploaded();
+		if (::loadModel(&loaded, filePath, fileName) == -1)
+		{
+			return -1;
+		}
+
+		resource = new Resource; INCR_NEW
+		resource->path = path;
+		resource->type = RESOURCE_MODEL;
+		resource->bytes = Loader::getBytesUploaded() - bytesBefore;
+		resource->models = loaded;
+		resource->textureID = 0;
+		ResourceManager::addResource(resource);
+	}
+
+	models->insert(models->end(), resource->models.begin(), resource->models.end());
+	return 0;
+}
+
+int ResourceManager::loadModelWithMTL(std::list<TexturedModel*>* models, std::string filePath, std::string fileNameOBJ, std::string fileNameMTL)
+{
+	std::string path = canonicalPath(filePath + fileNameOBJ) + "|" + canonicalPath(filePath + fileNameMTL);
+	Resource* resource = ResourceManager::acquire(path);
+	if (resource == nullptr)
+	{
+		std::list<TexturedModel*> loaded;
+		long long bytesBefore = Loader::getBytesUploaded();
+		if (loadBinaryModelWithMTL(&loaded, filePath, fileNameOBJ, fileNameMTL) != 0 &&
+			loadObjModelWithMTL(&loaded, filePath, fileNameOBJ, fileNameMTL) != 0)
+		{
+			return -1;
+		}
+
+		resource = new Resource; INCR_NEW
+		resource->path = path;
+		resource->type = RESOURCE_MODEL;
+		resource->bytes = Loader::getBytesUploaded() - bytesBefore;
+		resource->models = loaded;
+		resource->textureID = 0;
+		ResourceManager::addResource(resource);
+	}
+
+	models->insert(models->end(), resource->models.begin(), resource->models.end());
+	return 0;
+}
+
+void ResourceManager::releaseModels(std::list<TexturedModel*>* models)
+{
+	if (models->size() == 0)
+	{
+		return;
+	}
+
+	for (auto& entry : ResourceManager::resources)
+	{
+		Resource* resource = entry.second;
+		if (resource->type == RESOURCE_MODEL && resource->models.size() > 0 && resource->models.front() == models->front())
+		{
+			models->clear();
+			ResourceManager::release(resource);
+			return;
+		}
+	}
+
+	Loader::deleteTexturedModels(models);
+	for (TexturedModel* model : (*models))
+	{
+		delete model; INCR_DEL
+	}
+	models->clear();
+}
+
+GLuint ResourceManager::loadTexture(std::string fileName)
+{
+	std::string path = canonicalPath(fileName);
+	Resource* resource = ResourceManager::acquire(path);
+	if (resource == nullptr)
+	{
+		long long bytesBefore = Loader::getBytesUploaded();
+		GLuint textureID = Loader::loadTexture(fileName.c_str());
+		if (textureID == 0)
+		{
+			return 0;
+		}
+
+		resource = new Resource; INCR_NEW
+		resource->path = path;
+		resource->type = RESOURCE_TEXTURE;
+		resource->bytes = Loader::getBytesUploaded() - bytesBefore;
+		resource->textureID = textureID;
+		ResourceManager::addResource(resource);
+	}
+
+	return resource->textureID;
+}
+
+void ResourceManager::releaseTexture(GLuint textureID)
+{
+	for (auto& entry : ResourceManager::resources)
+	{
+		Resource* resource = entry.second;
+		if (resource->type == RESOURCE_TEXTURE && resource->textureID == textureID)
+		{
+			ResourceManager::release(resource);
+			return;
+		}
+	}
+
+	Loader::deleteTexture(textureID);
+}
+
+void ResourceManager::setMemoryBudget(long long bytes)
+{
+	ResourceManager::memoryBudget = bytes;
+	ResourceManager::trim(bytes);
+}
+
+void ResourceManager::cleanUp()
+{
+	ResourceManager::trim(0);
+}
+
+std::string ResourceManager::canonicalPath(std::string path)
+{
+	//Both kinds of slashes, doubled up slashes, "." and ".." all end up the same
+	std::vector<std::string> folders;
+	std::string folder = "";
+	for (unsigned int i = 0; i <= path.size(); i++)
+	{
+		char c = (i < path.size()) ? path[i] : '/';
+		if (c != '/' && c != '\\')
+		{
+			#ifdef _WIN32
+			c = (char)tolower(c); //windows doesn't care about the case of file names
+			#endif
+			folder += c;
+			continue;
+		}
+
+		if (folder == "..")
+		{
+			if (folders.size() > 0 && folders.back() != "..")
+			{
+				folders.pop_back();
+			}
+			else
+			{
+				folders.push_back(folder);
+			}
+		}
+		else if (folder != "" && folder != ".")
+		{
+			folders.push_back(folder);
+		}
+		folder = "";
+	}
+
+	std::string canonical = "";
+	for (unsigned int i = 0; i < folders.size(); i++)
+	{
+		if (i > 0)
+		{
+			canonical += '/';
+		}
+		canonical += folders[i];
+	}
+	return canonical;
+}
+
+ResourceManager::Resource* ResourceManager::acquire(std::string path)
+{
+	auto found = ResourceManager::resources.find(path);
+	if (found == ResourceManager::resources.end())
+	{
+		return nullptr;
+	}
+
+	Resource* resource = found->second;
+	if (resource->refCount == 0)
+	{
+		ResourceManager::unusedResources.remove(resource);
+	}
+	resource->refCount++;
+
+	#ifdef DEV_MODE
+	std::fprintf(stdout, "Resources: reusing '%s' (%lld KB)\n", path.c_str(), resource->bytes/1024);
+	#endif
+
+	return resource;
+}
+
+void ResourceManager::addResource(Resource* resource)
+{
+	resource->refCount = 1;
+	ResourceManager::resources[resource->path] = resource;
+	ResourceManager::totalBytes += resource->bytes;
+
+	#ifdef DEV_MODE
+	std::fprintf(stdout, "Resources: loaded '%s' (%lld KB), %lld KB in total\n",
+		resource->path.c_str(), resource->bytes/1024, ResourceManager::totalBytes/1024);
+	#endif
+
+	ResourceManager::trim(ResourceManager::memoryBudget);
+}
+
+void ResourceManager::release(Resource* resource)
+{
+	resource->refCount--;
+	if (resource->refCount > 0)
+	{
+		return;
+	}
+
+	ResourceManager::unusedResources.push_back(resource);
+	ResourceManager::trim(ResourceManager::memoryBudget);
+}
+
+void ResourceManager::trim(long long budget)
+{
+	while (ResourceManager::totalBytes > budget && ResourceManager::unusedResources.size() > 0)
+	{
+		Resource* oldest = ResourceManager::unusedResources.front();
+		ResourceManager::unusedResources.pop_front();
+		ResourceManager::deleteResource(oldest);
+	}
+}
+
+void ResourceManager::deleteResource(Resource* resource)
+{
+	#ifdef DEV_MODE
+	std::fprintf(stdout, "Resources: deleting '%s' (%lld KB)\n", resource->path.c_str(), resource->bytes/1024);
+	#endif
+
+	ResourceManager::resources.erase(resource->path);
+	ResourceManager::totalBytes -= resource->bytes;
+
+	switch (resource->type)
+	{
+		case RESOURCE_MODEL:
+			Loader::deleteTexturedModels(&resource->models);
+			for (TexturedModel* model : resource->models)
+			{
+				delete model; INCR_DEL
+			}
+			break;
+
+		case RESOURCE_TEXTURE:
+			Loader::deleteTexture(resource->textureID);
+			break;
+
+		default:
+			break;
+	}
+
+	delete resource; INCR_DEL
+}
\ No newline at end of file
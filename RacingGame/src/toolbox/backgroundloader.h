@@ -0,0 +1,55 @@
+#ifndef BACKGROUNDLOADER_H
+#define BACKGROUNDLOADER_H
+
+#include <functional>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//Runs a long loading function on a worker thread, so that the main thread can
+// keep drawing frames while it goes.
+//The gl context belongs to the main thread, so the worker can't make gl calls
+// itself. It hands them to runOnMainThread instead, which waits until the main
+// thread has run them in update. The main thread only spends so many milliseconds
+// on them each frame, so a big level can't make any one frame take too long.
+class BackgroundLoader
+{
+private:
+	//A job that some thread is waiting on the main thread to run
+	struct PendingJob
+	{
+		std::function<void()>* job;
+		bool done;
+	};
+
+	static std::thread::id mainThreadID;
+	static std::thread worker;
+	static bool workerRunning;
+
+	static std::mutex mutex;
+	static std::condition_variable jobChanged;
+
+	//What the worker (or threads of its own) are waiting on the main thread to run, oldest first
+	static std::deque<PendingJob*> pendingJobs;
+
+public:
+	//Has to be called from the main thread before any of the others
+	static void init();
+
+	static bool isMainThread();
+
+	//Starts running work on the worker thread. Only one can run at a time.
+	static void start(std::function<void()> work);
+
+	//Runs job on the main thread and waits for it to finish.
+	//On the main thread, job just runs right away. Any number of threads can
+	// be waiting at once, and their jobs run in the order they came in.
+	static void runOnMainThread(std::function<void()> job);
+
+	//Called by the main thread once per frame. Runs the jobs that the worker
+	// is waiting on until milliseconds have gone by or the worker is done.
+	//Returns true once the work given to start has finished, or if there wasn't any.
+	static bool update(double milliseconds);
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,184 @@
+#ifndef COMPILEDLEVEL_H
+#define COMPILEDLEVEL_H
+
+#include <string>
+#include <vector>
+
+#include "mappedfile.h"
+
+//Everything in a compiled level is made of 4 byte ints and floats, so none
+// of these structs have any padding and they can be used right out of the file.
+//Strings are offsets into the string table, which is null terminated strings one after another.
+
+struct LevelSection
+{
+	//bytes from the start of the file
+	int offset;
+	int count;
+};
+
+struct LevelCollisionChunk
+{
+	int fileName;
+	int quadTreeDepth;
+};
+
+struct LevelBGM
+{
+	int fileName;
+};
+
+struct LevelStagePass
+{
+	//2 or 3 for StagePass2 or StagePass3, 4 for StageTransparent
+	int pass;
+	int folder;
+	int fileName;
+};
+
+struct LevelSkySphere
+{
+	int folder;
+	int objFileName;
+	int mtlFileName;
+	float scale;
+	int followsY;
+};
+
+struct LevelCar
+{
+	float x, y, z;
+};
+
+struct LevelBoostpad
+{
+	float x,     y,     z;
+	float normX, normY, normZ;
+	float atX,   atY,   atZ;
+};
+
+struct LevelCheckpoint
+{
+	float rotationY;
+	float x, y, z;
+	float scaleX, scaleY, scaleZ;
+	int number;
+};
+
+struct LevelJumpRamp
+{
+	float x, y, z;
+	float yRot;
+};
+
+struct LevelHeader
+{
+	char fileType[4];
+	int version;
+	int byteCount;
+
+	//FNV-1a of every byte in the file after this
+	unsigned int checksum;
+
+	//FNV-1a of the .lvl this was compiled from
+	unsigned int sourceHash;
+
+	int modelFolder;
+	int modelFileName;
+	int collisionFolder;
+
+	float sunColorDay[3];
+	float sunColorNight[3];
+	float moonColorDay[3];
+	float moonColorNight[3];
+	float fogColorDay[3];
+	float fogColorNight[3];
+	float fogDensity;
+	float fogGradient;
+	float timeOfDay;
+	float cameraYaw;
+	float cameraPitch;
+
+	int bgmHasLoop;
+
+	float finishPosition[3];
+	float finishRotY;
+	float finishCameraPitch;
+
+	float deathHeight;
+
+	//How many RR_BackgroundStars there are, they don't have any settings
+	int backgroundStarsCount;
+
+	LevelSection collisionChunks;
+	LevelSection bgm;
+	LevelSection stagePasses;
+	LevelSection skySpheres;
+	LevelSection cars;
+	LevelSection boostpads;
+	LevelSection checkpoints;
+	LevelSection jumpRamps;
+	LevelSection strings;
+};
+
+//A level that has already been parsed into structs.
+//The text .lvl is still what gets edited. "RacingGame -compileLevel Casino.lvl ..."
+// writes res/Levels/Casino.clvl next to it, which then gets loaded instead, the same
+// way a .cobj package replaces a model. Loading it is just mapping the file and
+// checking it. Levels that haven't been compiled, or whose .lvl has been edited
+// since, get compiled when they load and their .clvl gets written then.
+class CompiledLevel
+{
+private:
+	static const int VERSION = 2;
+
+	MappedFile file;
+
+	//The level when it was compiled in memory instead of read from a .clvl
+	std::vector<char> compiled;
+
+	const char* data;
+	int size;
+
+	static unsigned int checksum(const char* bytes, int byteCount);
+
+	//Returns false if the file can't be read
+	static bool hashFile(std::string fileName, unsigned int* hash);
+
+	//res/Levels/Casino.lvl -> res/Levels/Casino.clvl
+	static std::string getCompiledFileName(std::string lvlFileName);
+
+	//Returns false if the file couldn't be written
+	static bool writeToFile(std::string compiledFileName, std::vector<char>* bytes);
+
+	//Checks the header, checksum, and that every section and string is inside the file
+	bool isValid();
+
+public:
+	CompiledLevel();
+
+	//Opens res/Levels/<fileName without .lvl>.clvl if there is a valid one that was
+	// compiled from the .lvl as it is now, or else compiles the .lvl and writes its .clvl.
+	//Returns false if neither could be read.
+	bool open(std::string lvlFileName);
+
+	void close();
+
+	//Parses a text .lvl. Returns false if it can't be read or is missing something.
+	static bool compile(std::string lvlFileName, std::vector<char>* bytes);
+
+	//Compiles a .lvl into its .clvl. Returns 0 if successful, -1 if not.
+	static int compileToFile(std::string lvlFileName);
+
+	const LevelHeader* getHeader();
+
+	const char* getString(int offset);
+
+	//The structs in section, for example getSection<LevelCheckpoint>(&getHeader()->checkpoints)
+	template <typename T>
+	const T* getSection(const LevelSection* section)
+	{
+		return (const T*)(data + section->offset);
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <vector>
+
+//Adds up numbers over a few hundred frames, so that DEV_MODE can print
+// how much of something happened per frame on average.
+class FrameStats
+{
+private:
+	static const int FRAME_COUNT = 300;
+
+	int frames;
+	std::vector<double> totals;
+	std::vector<double> averages;
+
+public:
+	FrameStats();
+
+	void add(int index, double value);
+
+	//Counts a frame. Every FRAME_COUNT frames this returns true, and the
+	// averages of those frames are ready to print with getAverage.
+	bool endFrame();
+
+	//Average per frame of the last FRAME_COUNT frames
+	double getAverage(int index);
+
+	//Starts counting over, throwing away the frames so far
+	void reset();
+};
+#endif
\ No newline at end of file
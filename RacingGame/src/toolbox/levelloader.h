@@ -3,22 +3,38 @@
 
 #include <string>
 
+#include "compiledlevel.h"
+
 class LevelLoader
 {
 private:
-	static float toFloat(char* input);
+	//How long the main thread can spend on gl uploads for the level each frame
+	static constexpr double UPLOAD_MILLISECONDS_PER_FRAME = 4.0;
 
-	static int toInt(char* input);
+	//The level that is being loaded, opened on the main thread and read by the worker
+	static CompiledLevel level;
 
-	static void processLine(char** data, int dataLength);
+	static int bgmHasLoop;
 
 	static void freeAllStaticModels();
 
+	//The part of loading a level that runs on the BackgroundLoader's worker thread:
+	// reading the level, the collision, the models and their textures
+	static void loadLevelFiles(int stageFault);
+
+	//Back on the main thread once everything has been loaded
+	static void finishLoading();
+
 public:
 	static void loadTitle();
 
+	//Unloads the old level and starts loading the new one in the background.
+	//The game is in STATE_LOADING until it is done.
 	static void loadLevel(std::string levelFilename);
 
+	//Called once per frame while the game is in STATE_LOADING
+	static void updateLoading();
+
 	static void loadLevelData();
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+//Maps a whole file into memory as read only, so it can be parsed in place
+// without reading it into a buffer first. The data is only there while the
+// MappedFile is open, and it is not null terminated.
+class MappedFile
+{
+private:
+	const char* data;
+	size_t size;
+
+	//windows
+	void* fileHandle;
+	void* mappingHandle;
+
+	//everything else
+	int fileDescriptor;
+
+public:
+	MappedFile();
+
+	~MappedFile();
+
+	//A copy would unmap the same view a second time when it gets destroyed
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	//Returns false if the file couldn't be opened
+	bool open(std::string fileName);
+
+	void close();
+
+	const char* getData();
+
+	size_t getSize();
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <vector>
+
+//A sort key along with the index of the thing it belongs to
+struct RadixSortItem
+{
+	unsigned long long key;
+	unsigned int value;
+};
+
+class RadixSort
+{
+public:
+	//Sorts items from lowest key to highest key. The sort is stable.
+	//scratch is used as a temporary buffer and is resized as needed, so
+	// keep it around between calls to avoid reallocating every frame.
+	static void sort(std::vector<RadixSortItem>* items, std::vector<RadixSortItem>* scratch);
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef RESOURCEMANAGER_H
+#define RESOURCEMANAGER_H
+
+class TexturedModel;
+
+#include <glad/glad.h>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+//Keeps models and textures around after the last thing using
+// them lets go, so that going from one level to another (or to the menu and
+// back) doesn't load the same files over and over again.
+//Everything is looked up by its canonical path, and counts how many times it
+// has been loaded. Releasing it takes one away. Once nothing is using it, it
+// stays loaded until the cache goes over its memory budget, and then the ones
+// that have gone the longest without being used get deleted first.
+//Only one thread uses this at a time: the level loading thread while a level
+// is loading, and the main thread the rest of the time.
+class ResourceManager
+{
+private:
+	enum ResourceType
+	{
+		RESOURCE_MODEL,
+		RESOURCE_TEXTURE
+	};
+
+	struct Resource
+	{
+		std::string path;
+		ResourceType type;
+		int refCount;
+
+		//gpu memory that it takes up
+		long long bytes;
+
+		std::list<TexturedModel*> models;
+		GLuint textureID;
+	};
+
+	static std::unordered_map<std::string, Resource*> resources;
+
+	//Resources that nothing is using anymore, least recently used at the front
+	static std::list<Resource*> unusedResources;
+
+	static long long totalBytes;
+	static long long memoryBudget;
+
+	//Turns the path into the same string no matter how it was written
+	static std::string canonicalPath(std::string path);
+
+	//Returns the resource at path and counts it as used, or nullptr if it isn't loaded
+	static Resource* acquire(std::string path);
+
+	static void addResource(Resource* resource);
+
+	static void release(Resource* resource);
+
+	//Deletes unused resources until everything fits in the memory budget
+	static void trim(long long budget);
+
+	static void deleteResource(Resource* resource);
+
+public:
+	//The same as loadModel in objLoader.h, except that the models belong to the cache.
+	//Give them back with releaseModels instead of deleting them.
+	static int loadModel(std::list<TexturedModel*>* models, std::string filePath, std::string fileName);
+
+	//The same as loadBinaryModelWithMTL, falling back to loadObjModelWithMTL
+	static int loadModelWithMTL(std::list<TexturedModel*>* models, std::string filePath, std::string fileNameOBJ, std::string fileNameMTL);
+
+	//Lets go of models that came from loadModel or loadModelWithMTL, and clears the list.
+	//Models that didn't come from here get deleted right away.
+	static void releaseModels(std::list<TexturedModel*>* models);
+
+	//The same as Loader::loadTexture
+	static GLuint loadTexture(std::string fileName);
+
+	static void releaseTexture(GLuint textureID);
+
+	//Once everything together takes up more bytes than this, the resources that
+	// nothing is using start getting deleted
+	static void setMemoryBudget(long long bytes);
+
+	//Deletes everything that nothing is using anymore
+	static void cleanUp();
+};
+#endif
\ No newline at end of file